@@ -21,26 +21,55 @@
 
 #include <SPI.h>
 #include <SD.h>
-#include <Wire.h>
 // #include <OneWire.h>  // DEAKTIVIERT
-#include "RTClib.h"
 
 
 // Projekt-Module
 #include "config.h"
 #include "utilities.h"
 #include "sensors.h"
+#include "sensor_snapshot.h"
+#include "adc_scanner.h"
+#include "mic_envelope.h"
+#include "dht_driver.h"
+#include "scheduler.h"
 
+#include "twi_queue.h"
 #include "rtc_module.h"
+#include "time_service.h"
 #include "data_logger.h"
+#include "log_writer.h"
+#include "log_queue.h"
 #include "display.h"  // OLED Display Modul
+#include "telemetry.h"
+#include "trace.h"
+#include "perf_probe.h"
+#include "profiler.h"
+#include "serial_command.h"
+#include "memory_monitor.h"
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+// Erzeugt die Arduino-IDE sonst selbst; ausgeschrieben ist der Sketch
+// auch als gewöhnliches C++ übersetzbar (Host-Build, siehe native/main.cpp)
+void initializeSystem();
+void registerTasks();
+void runSystemCheck();
+void performDataLogging();
+void performSensorReadings();
+void printDataToSerial(const SensorSnapshot* snapshot);
+void printCompactStatus(float temp, float hum, int light, float rad, const int* gas, const int* mic, float tdsValue);
+void updateSensorInitialization();
+bool areSensorsReady();
+unsigned long getSystemUptime();
+void printSystemStatus();
 
 // ==============================================
 // GLOBALE VARIABLEN
 // ==============================================
 
-unsigned long lastLoggingTime = 0;
-unsigned long lastSensorTime = 0;
 unsigned long systemStartTime = 0;
 
 // State Machine für non-blocking Sensor-Initialisierung
@@ -61,6 +90,10 @@ void setup() {
   // Serielle Kommunikation starten
   Serial.begin(SERIAL_BAUD);
   delay(2000);  // Zeit für Serial Monitor
+  telemetryBegin();
+  traceBegin();
+  perfBegin();  // Vor der Initialisierung, damit auch Startvorgänge messbar sind
+  profilerBegin();
   
   systemStartTime = millis();
   
@@ -69,12 +102,19 @@ void setup() {
   
   // Module initialisieren
   initializeSystem();
+
+  // Periodische Tasks registrieren und Scheduler starten
+  registerTasks();
+  schedulerStart();
   
   DEBUG_PRINTLN(F("=== SYSTEM BEREIT ==="));
   DEBUG_PRINTLN(F("Starte Datensammlung..."));
 }
 
 void initializeSystem() {
+  // 0. ADC-Scanner starten (alle Analogkanäle laufen ab jetzt im Hintergrund)
+  adcScanBegin();
+  micEnvelopeBegin();
   initTDSSensor();
   bool systemOK = true;
   
@@ -82,13 +122,15 @@ void initializeSystem() {
   
   // 1. RTC initialisieren (wichtig für Zeitstempel)
   if (!initRTC()) {
-    reportError(ERROR_RTC, "RTC Initialisierung fehlgeschlagen");
+    reportError(ERROR_RTC, TRACE_ERROR_RTC_INIT);
     systemOK = false;
   }
+  // Zeitdienst: ab hier Zeitstempel ohne I2C-Zugriff
+  timeServiceBegin();
   
   // 2. SD-Karte initialisieren
   if (!initSDCard()) {
-    reportError(ERROR_SD_CARD, "SD-Karte Initialisierung fehlgeschlagen");
+    reportError(ERROR_SD_CARD, TRACE_ERROR_SD_INIT);
     systemOK = false;
   }
   
@@ -101,20 +143,20 @@ void initializeSystem() {
   sensorInitTimer = millis();
   DEBUG_PRINTLN(F("DHT11 Aufwärmphase gestartet (2s)..."));
   
-  // Gas-Sensoren und Radioaktivitätssensor können sofort initialisiert werden
+  // Gas-Sensoren und Radioaktivitätssensor (Hardware-Zähler) können sofort initialisiert werden
   initRadiationSensor();
   DEBUG_PRINTLN(F("Gas-Sensoren Aufwärmphase wird nach DHT11 gestartet..."));
   
   // 5. OLED Display initialisieren
   if (!initDisplay()) {
-    reportError(ERROR_SYSTEM, "OLED Display Initialisierung fehlgeschlagen");
+    reportError(ERROR_SYSTEM, TRACE_ERROR_DISPLAY_INIT);
   }
   
   // 6. Log-Datei erstellen
   if (isSDCardAvailable()) {
     char filename[MAX_FILENAME_LEN];
     if (!createLogFile(filename, sizeof(filename))) {
-      reportError(ERROR_SD_CARD, "Log-Datei konnte nicht erstellt werden");
+      reportError(ERROR_SD_CARD, TRACE_ERROR_LOG_FILE);
       systemOK = false;
     }
   }
@@ -124,7 +166,7 @@ void initializeSystem() {
     // Kompletter Sensor-Test beim Start
     testAllSensors();
   } else {
-    DEBUG_PRINTLN(F("WARNUNG: Einige Komponenten konnten nicht initialisiert werden!"));
+    TRACE(INIT_INCOMPLETE);
     // Reduzierter Test bei Fehlern
     testTemperatureSensors();
   }
@@ -143,34 +185,51 @@ void loop() {
     DEBUG_PRINTLN(Serial1.available());
   }
 
+  // Radioaktivitäts-Sensor zählt in Hardware (Timer5), keine CPU-Last.
+  // Alle übrigen Aufgaben laufen als Tasks; zwischen den Fälligkeiten
+  // schläft die CPU im Idle-Modus statt delay(1) zu warten.
+  schedulerRun();
+}
 
-  // HOCHFREQUENZ: Radioaktivitäts-Sensor läuft jetzt interruptbasiert
-
-  // OLED Display aktualisieren (alle 2 Sekunden)
-  updateDisplay();
-
-  // Hauptdaten-Logging (alle 2 Sekunden gemäß LOGGING_INTERVAL)
-  if (isTimeElapsed(&lastLoggingTime, LOGGING_INTERVAL)) {
-    performDataLogging();
-  }
-
-  // Gas-Sensoren periodisch lesen (alle 2s)
-  if (isTimeElapsed(&lastSensorTime, SENSOR_INTERVAL)) {
-    performSensorReadings();
-  }
+// ==============================================
+// TASK-REGISTRIERUNG
+// ==============================================
 
-  // Non-blocking Sensor-Initialisierung
-  updateSensorInitialization();
+void registerTasks() {
+  // Name, Funktion, Periode, Phase, Deadline (0 = Periode), Priorität (0 = höchste)
+  schedulerAddTask(F("DHT"), dhtUpdate, DHT_TASK_PERIOD, DHT_TASK_PHASE, 0, 0);
+  schedulerAddTask(F("Mikrofon"), micEnvelopeUpdate, MIC_TASK_PERIOD, MIC_TASK_PHASE, 0, 1);
+  schedulerAddTask(F("Zeit"), timeServiceUpdate, TIME_SERVICE_TASK_PERIOD, TIME_SERVICE_TASK_PHASE, 0, 1);
+  // I2C läuft im TWI-Interrupt; der Task bricht nur hängende Übertragungen ab
+  schedulerAddTask(F("I2C"), twiPoll, TWI_WATCHDOG_TASK_PERIOD, TWI_WATCHDOG_TASK_PHASE, 0, 1);
+  // Sensoren einmal pro Zyklus erfassen - vor dem Logging,
+  // damit Log-Datei und Anzeige denselben Snapshot verwenden
+  schedulerAddTask(F("Sensoren"), performSensorReadings, SENSOR_INTERVAL, SENSOR_TASK_PHASE, 100, 2);
+  schedulerAddTask(F("Logging"), performDataLogging, LOGGING_INTERVAL, LOGGING_TASK_PHASE, 200, 3);
+  // SD-Schreiben in eigenen Zeitscheiben: Kartenlatenz verzögert nie die Erfassung
+  schedulerAddTask(F("LogWriter"), drainLogQueue, LOG_WRITER_TASK_PERIOD, LOG_WRITER_TASK_PHASE, 0, 5);
+  schedulerAddTask(F("Display"), updateDisplay, DISPLAY_TASK_PERIOD, DISPLAY_TASK_PHASE, 0, 4);
+  schedulerAddTask(F("SensorInit"), updateSensorInitialization, SENSOR_INIT_TASK_PERIOD, SENSOR_INIT_TASK_PHASE, 0, 6);
+  schedulerAddTask(F("SystemCheck"), runSystemCheck, SYSTEM_CHECK_INTERVAL, SYSTEM_CHECK_TASK_PHASE, 0, 7);
+  schedulerAddTask(F("Befehle"), serialCommandPoll, SERIAL_COMMAND_TASK_PERIOD, SERIAL_COMMAND_TASK_PHASE, 0, 8);
+#if TRACE_ENABLED
+  // Debug-Meldungen nur senden, wenn sonst nichts ansteht
+  schedulerAddTask(F("Trace"), traceService, TRACE_TASK_PERIOD, TRACE_TASK_PHASE, 0, 8);
+#endif
+}
 
-  // System-Check alle 30 Sekunden
-  static unsigned long lastSystemCheck = 0;
-  if (isTimeElapsed(&lastSystemCheck, 30000)) {
-    systemCheck();
-  }
-  
-  // MINIMAL-DELAY für Radiation-Sensor Responsivität
-  // Optimiert für ~1000 Hz Abtastrate (alle 1ms) für bessere Radioaktivitäts-Erfassung
-  delay(1);
+void runSystemCheck() {
+  PERF_SCOPE(SYSTEM_CHECK);
+  systemCheck();
+  logWriterService();  // Zeitbudget auch ohne neue Zeilen einhalten
+  memoryMonitorPrintStats();
+  schedulerPrintStats();
+  logWriterPrintStats();
+  logQueuePrintStats();
+  timeServicePrintStats();
+  twiPrintStats();
+  printDisplayStats();
+  telemetrySendHealth();
 }
 
 // ==============================================
@@ -178,137 +237,88 @@ void loop() {
 // ==============================================
 
 void performDataLogging() {
-  // Aktuelle Zeit abrufen mit Stabiltiäts-Check
-  RTCData currentTime;
-  static RTCData lastTime = {0};
-  
-  if (!readRTCData(&currentTime)) {
-    DEBUG_PRINTLN(F("WARNUNG: RTC-Zeit nicht verfügbar!"));
+  PERF_SCOPE(LOGGING);
+  // Snapshot des aktuellen Zyklus verwenden - keine erneute Sensorabfrage
+  if (!hasSensorSnapshot()) {
     return;
   }
-  
-  // RTC-Sprung-Detektion
-  if (lastTime.year > 0) {
-    long timeDiff = abs((long)currentTime.timestamp - (long)lastTime.timestamp);
-    if (timeDiff > 10) {  // Mehr als 10 Sekunden Sprung?
-      DEBUG_PRINT(F("WARNUNG: RTC-Zeitsprung erkannt! Diff: "));
-      DEBUG_PRINTLN(timeDiff);
-    }
+  const SensorSnapshot* snapshot = getSensorSnapshot();
+
+  if (!snapshot->rtc.isValid) {
+    TRACE(LOG_NO_RTC_TIME);
+    return;
   }
-  lastTime = currentTime;
-  
-  // Debug: Logging-Zeitpunkt anzeigen
-  //DEBUG_PRINT(F("Logging: "));
-  //DEBUG_PRINT(currentTime.hour);
-  //DEBUG_PRINT(F(":"));
-  //DEBUG_PRINT(currentTime.minute);
-  //DEBUG_PRINT(F(":"));
-  //DEBUG_PRINTLN(currentTime.second);
-  
- 
-  // float celsius = 0.0, fahrenheit = 0.0;
-  // if (!readTemperature(&celsius, &fahrenheit)) {
 
-  //   celsius = 0.0;
-  //   fahrenheit = 0.0;
-  // }
-  
-  // DHT11 lesen (Temperatur + Luftfeuchtigkeit)
-  float dht_temperature, humidity;
-  if (!readDHTSensor(&dht_temperature, &humidity)) {
-    DEBUG_PRINTLN(F("WARNUNG: DHT11 Sensor nicht verfügbar!"));
-    dht_temperature = 0.0;
-    humidity = 0.0;
+  if (!snapshot->dhtValid) {
+    TRACE(DHT_UNAVAILABLE);
   }
-  
-  // Daten protokollieren mit Retry-Mechanismus (non-blocking)
-  float tdsValue = readTDSSensor();
+
+  // Eintrag nur einreihen - geschrieben wird im LogWriter-Task. Schlägt
+  // das Schreiben fehl, bleibt der Eintrag dort in der Queue (kein erneutes
+  // Erfassen, keine doppelten Zeilen)
   if (isSDCardAvailable()) {
-    bool logSuccess = false;
-    for (int retry = 0; retry < 3 && !logSuccess; retry++) {
-      if (retry > 0) {
-        DEBUG_PRINT(F("Log-Retry: "));
-        DEBUG_PRINTLN(retry);
-        // Kein delay - sofortiger Retry
-      }
-      logSuccess = logSensorData(dht_temperature, humidity, &currentTime, tdsValue);
-      if (!logSuccess) {
-        DEBUG_PRINT(F("FEHLER: Datenprotokollierung fehlgeschlagen! Versuch: "));
-        DEBUG_PRINTLN(retry + 1);
-      }
-    }
-    if (!logSuccess) {
-      DEBUG_PRINTLN(F("KRITISCH: Alle Log-Versuche fehlgeschlagen!"));
+    LogEntry entry;
+    fillLogEntry(snapshot, &entry);
+    if (!logQueuePush(&entry)) {
+      TRACE(LOG_QUEUE_FULL);
+      LogQueueStats queue;
+      logQueueGetStats(&queue);
+      telemetrySendEvent(TELEMETRY_EVENT_LOG_DROPPED, 0, (uint16_t)queue.dropped);
     }
   } else {
-    // Fallback: Nur Serial-Ausgabe
-    printDataToSerial(dht_temperature, humidity, &currentTime, tdsValue);
+#if !TELEMETRY_ENABLED
+    // Fallback: Nur Serial-Ausgabe (mit Telemetrie geht jeder Zyklus ohnehin als Rahmen hinaus)
+    printDataToSerial(snapshot);
+#endif
   }
 }
 
 void performSensorReadings() {
-
-  // float celsius, fahrenheit;
-  // if (readTemperature(&celsius, &fahrenheit)) {
-  //   printTemperature(celsius, fahrenheit);
-  // }
-  
-  // DHT11 lesen und ausgeben
-  float dht_temp, humidity;
-  if (readDHTSensor(&dht_temp, &humidity)) {
-    printDHTValues(dht_temp, humidity);
+  PERF_SCOPE(SENSORS);
+  // Einzige Sensorabfrage im Zyklus: füllt den gemeinsamen Snapshot
+  const SensorSnapshot* snapshot = acquireSensorSnapshot();
+  telemetrySendSnapshot(snapshot);
+
+  // DHT11 ausgeben
+  if (snapshot->dhtValid) {
+    printDHTValues(snapshot->temperature, snapshot->humidity);
   }
 
-  // Lichtsensor lesen und ausgeben
-  int lightLevel = readLightSensor();
-  float lightPercent = getLightPercent();
-  printLightLevel(lightLevel, lightPercent);
-
-  // Gas-Sensoren lesen und ausgeben
-  int gasSensors[9];
-  readAllGasSensors(gasSensors);
+  // Lichtsensor ausgeben
+  printLightLevel(snapshot->lightLevel, snapshot->lightPercent);
 
 #if DEBUG_ENABLED
   // Detaillierte Sensor-Ausgabe nur bei aktiviertem Debug
-  printGasSensorValues(gasSensors);
+  printGasSensorValues(snapshot->gasSensors);
 #endif
 
-  // Mikrofone lesen
-  int microphones[2];
-  readAllMicrophones(microphones);
-
-  // TDS-Sensor lesen
-  float tdsValue = readTDSSensor();
-
-  // Radioaktivität: Wert aus neuer Logik holen
-  int radiationCPS = getRadiationCountAndReset();
-
   // KOMPAKTE ÜBERSICHTS-AUSGABE für bessere Lesbarkeit (jetzt mit TDS)
-  printCompactStatus(dht_temp, humidity, lightLevel, radiationCPS, gasSensors, microphones, tdsValue);
-
-  // Detaillierte Radioaktivitäts-Statistik entfällt (alte Funktion entfernt)
+  printCompactStatus(snapshot->temperature, snapshot->humidity, snapshot->lightLevel,
+                     snapshot->radiationCPS, snapshot->gasSensors, snapshot->microphones,
+                     snapshot->tdsValue);
 }
 
-void printDataToSerial(float dht_temp, float humidity, const RTCData* rtc, float tdsValue) {
+void printDataToSerial(const SensorSnapshot* snapshot) {
+  const RTCData* rtc = &snapshot->rtc;
+
   // Kompakte Serial-Ausgabe
   DEBUG_PRINT(F("Daten: "));
   
   // Timestamp
   char timestamp[32];
-  unsigned long ms = millis() % 1000;
-  snprintf(timestamp, sizeof(timestamp), "%04d-%02d-%02d-%02d-%02d-%02d-%03lu",
+  snprintf(timestamp, sizeof(timestamp), "%04d-%02d-%02d-%02d-%02d-%02d-%03u",
            rtc->year, rtc->month, rtc->day, 
-           rtc->hour, rtc->minute, rtc->second, ms);
+           rtc->hour, rtc->minute, rtc->second, rtc->millisecond);
   DEBUG_PRINT(timestamp);
   
   // DHT11 Temperatur 
   DEBUG_PRINT(F(" ; DHT11: "));
-  Serial.print(dht_temp, 1);
+  Serial.print(snapshot->temperature, 1);
   DEBUG_PRINT(F("°C "));
-  Serial.print(humidity, 1);
+  Serial.print(snapshot->humidity, 1);
   DEBUG_PRINT(F("% ; "));
   DEBUG_PRINT(F("TDS: "));
-  Serial.print(tdsValue, 0);
+  Serial.print(snapshot->tdsValue, 0);
   DEBUG_PRINT(F("ppm ; "));
   
   
@@ -324,7 +334,7 @@ void printDataToSerial(float dht_temp, float humidity, const RTCData* rtc, float
   DEBUG_PRINTLN(rtc->second);
 }
 
-void printCompactStatus(float temp, float hum, int light, int rad, int* gas, int* mic, float tdsValue) {
+void printCompactStatus(float temp, float hum, int light, float rad, const int* gas, const int* mic, float tdsValue) {
   //DEBUG_PRINTLN(F("========== SENSOR STATUS =========="));
   
   // Zeile 1: Umweltdaten
@@ -369,7 +379,7 @@ void updateSensorInitialization() {
         if (initDHTSensor()) {
           DEBUG_PRINTLN(F("DHT11 erfolgreich initialisiert"));
         } else {
-          DEBUG_PRINTLN(F("WARNUNG: DHT11 Initialisierung fehlgeschlagen"));
+          TRACE(DHT_INIT_FAILED);
         }
         
         // Starte Gas-Sensoren Aufwärmphase
@@ -387,6 +397,7 @@ void updateSensorInitialization() {
         
         sensorInitState = SENSOR_INIT_COMPLETE;
         DEBUG_PRINTLN(F("*** ALLE SENSOREN BEREIT ***"));
+        telemetrySendEvent(TELEMETRY_EVENT_SENSORS_READY, 0, 0);
       }
       break;
       
@@ -0,0 +1,199 @@
+/*
+ * Implementierung des ADC-Scanner-Moduls
+ */
+
+#include "adc_scanner.h"
+#include <Arduino.h>
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+// Zustand eines Kanals - wird in der ISR geschrieben und in der
+// Hauptschleife nur unter Interruptsperre gelesen
+struct AdcChannelState {
+  uint16_t ring[ADC_SCAN_RING_SIZE];  // Ringpuffer der letzten Messwerte
+  uint8_t head;                       // Nächste Schreibposition
+  uint8_t fill;                       // Anzahl gültiger Werte im Ring
+  uint8_t divider;                    // Besuch in jeder n-ten Runde
+  uint8_t burst;                      // Messwerte pro Besuch
+  uint8_t roundCounter;               // Rundenzähler für divider
+  uint16_t sampleCount;               // Übernommene Messwerte (mit Überlauf)
+  AdcSampleHook hook;                 // Optionaler Callback pro Messwert
+};
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static AdcChannelState adcChannels[ADC_SCAN_CHANNELS];
+static volatile uint8_t activeChannel = 0;
+static volatile uint8_t discardRemaining = 0;
+static volatile uint8_t burstRemaining = 1;
+
+// ==============================================
+// MULTIPLEXER
+// ==============================================
+
+static inline void selectMux(uint8_t channel) {
+  // AVcc als Referenz, Kanäle 8-15 über MUX5 in ADCSRB (ADTS = 0: Free-Running)
+  ADMUX = _BV(REFS0) | (channel & 0x07);
+  ADCSRB = (channel & 0x08) ? _BV(MUX5) : 0;
+}
+
+static void switchToNextChannel() {
+  uint8_t next = activeChannel;
+
+  // Nächsten fälligen Kanal suchen (terminiert, da jeder Zähler wächst)
+  while (true) {
+    next = (next + 1 >= ADC_SCAN_CHANNELS) ? 0 : next + 1;
+    AdcChannelState* ch = &adcChannels[next];
+    if (++ch->roundCounter >= ch->divider) {
+      ch->roundCounter = 0;
+      break;
+    }
+  }
+
+  burstRemaining = adcChannels[next].burst;
+  if (next == activeChannel) {
+    return;  // Kein Kanalwechsel - kein Settling nötig
+  }
+
+  selectMux(next);
+  activeChannel = next;
+  // Im Free-Running-Modus läuft die nächste Wandlung bereits mit dem
+  // alten Kanal. Diese plus die Settling-Messungen werden verworfen.
+  discardRemaining = 1 + ADC_SCAN_SETTLE_DISCARD;
+}
+
+// ==============================================
+// CONVERSION-COMPLETE INTERRUPT
+// ==============================================
+
+ISR(ADC_vect) {
+  uint16_t value = ADC;
+
+  if (discardRemaining > 0) {
+    discardRemaining--;
+    return;
+  }
+
+  AdcChannelState* ch = &adcChannels[activeChannel];
+  ch->ring[ch->head] = value;
+  ch->head = (ch->head + 1) & (ADC_SCAN_RING_SIZE - 1);
+  if (ch->fill < ADC_SCAN_RING_SIZE) ch->fill++;
+  ch->sampleCount++;
+  if (ch->hook) ch->hook(activeChannel, value);
+
+  if (--burstRemaining == 0) {
+    switchToNextChannel();
+  }
+}
+
+// ==============================================
+// STEUERUNG
+// ==============================================
+
+void adcScanBegin() {
+  DEBUG_PRINTLN(F("Starte ADC-Scanner (A0-A12, Free-Running)..."));
+
+  for (uint8_t i = 0; i < ADC_SCAN_CHANNELS; i++) {
+    AdcChannelState* ch = &adcChannels[i];
+    if (ch->divider == 0) ch->divider = 1;
+    if (ch->burst == 0) ch->burst = 1;
+  }
+
+  // Digitale Eingangspuffer der Analogpins abschalten (weniger Rauschen)
+  DIDR0 = 0xFF;                                            // A0-A7
+  DIDR2 = (uint8_t)((1 << (ADC_SCAN_CHANNELS - 8)) - 1);   // A8-A12
+
+  noInterrupts();
+  activeChannel = 0;
+  burstRemaining = adcChannels[0].burst;
+  discardRemaining = ADC_SCAN_SETTLE_DISCARD;
+  selectMux(0);
+  // ADC an, Start, Auto-Trigger, Interrupt, Prescaler 128 (125 kHz ADC-Takt)
+  ADCSRA = _BV(ADEN) | _BV(ADSC) | _BV(ADATE) | _BV(ADIE) |
+           _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+  interrupts();
+}
+
+void adcScanStop() {
+  ADCSRA &= ~(_BV(ADATE) | _BV(ADIE));
+}
+
+void adcScanSetChannelRate(uint8_t channel, uint8_t divider, uint8_t burst) {
+  if (channel >= ADC_SCAN_CHANNELS) return;
+  noInterrupts();
+  adcChannels[channel].divider = divider > 0 ? divider : 1;
+  adcChannels[channel].burst = burst > 0 ? burst : 1;
+  adcChannels[channel].roundCounter = 0;
+  interrupts();
+}
+
+void adcScanSetSampleHook(uint8_t channel, AdcSampleHook hook) {
+  if (channel >= ADC_SCAN_CHANNELS) return;
+  noInterrupts();
+  adcChannels[channel].hook = hook;
+  interrupts();
+}
+
+// ==============================================
+// WERTE AUSLESEN
+// ==============================================
+
+// Kopiert den Ringpuffer unter kurzer Interruptsperre
+static uint8_t copyRing(uint8_t channel, uint16_t* out) {
+  if (channel >= ADC_SCAN_CHANNELS) return 0;
+  noInterrupts();
+  const AdcChannelState* ch = &adcChannels[channel];
+  uint8_t fill = ch->fill;
+  for (uint8_t i = 0; i < ADC_SCAN_RING_SIZE; i++) {
+    out[i] = ch->ring[i];
+  }
+  interrupts();
+  return fill;
+}
+
+uint16_t adcScanAverage(uint8_t channel) {
+  uint16_t buffer[ADC_SCAN_RING_SIZE];
+  uint8_t fill = copyRing(channel, buffer);
+  if (fill == 0) return 0;
+
+  uint16_t sum = 0;  // max. 8 * 1023 - passt in 16 Bit
+  for (uint8_t i = 0; i < fill; i++) {
+    sum += buffer[i];
+  }
+  return (sum + fill / 2) / fill;
+}
+
+uint16_t adcScanLatest(uint8_t channel) {
+  if (channel >= ADC_SCAN_CHANNELS) return 0;
+  noInterrupts();
+  const AdcChannelState* ch = &adcChannels[channel];
+  uint16_t value = ch->fill ? ch->ring[(ch->head - 1) & (ADC_SCAN_RING_SIZE - 1)] : 0;
+  interrupts();
+  return value;
+}
+
+uint16_t adcScanPeakToPeak(uint8_t channel) {
+  uint16_t buffer[ADC_SCAN_RING_SIZE];
+  uint8_t fill = copyRing(channel, buffer);
+  if (fill == 0) return 0;
+
+  uint16_t minValue = 1023;
+  uint16_t maxValue = 0;
+  for (uint8_t i = 0; i < fill; i++) {
+    if (buffer[i] < minValue) minValue = buffer[i];
+    if (buffer[i] > maxValue) maxValue = buffer[i];
+  }
+  return maxValue - minValue;
+}
+
+uint16_t adcScanSampleCount(uint8_t channel) {
+  if (channel >= ADC_SCAN_CHANNELS) return 0;
+  noInterrupts();
+  uint16_t count = adcChannels[channel].sampleCount;
+  interrupts();
+  return count;
+}
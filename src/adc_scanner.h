@@ -0,0 +1,120 @@
+/*
+ * ADC-Scanner-Modul für das Umweltkontrollsystem
+ * Interruptgesteuerte Erfassung aller analogen Kanäle (A0-A12)
+ *
+ * Der ADC läuft im Free-Running-Modus. Die Conversion-Complete-ISR
+ * schreibt jeden Messwert in den Ringpuffer des aktiven Kanals und
+ * schaltet den Multiplexer weiter. Die Hauptschleife kopiert nur noch
+ * fertige (gemittelte) Werte heraus - analogRead() wird nicht mehr benötigt.
+ */
+
+#ifndef ADC_SCANNER_H
+#define ADC_SCANNER_H
+
+#include "config.h"
+
+// ==============================================
+// TYPEN
+// ==============================================
+
+/**
+ * @brief Callback für jeden übernommenen Messwert eines Kanals.
+ *
+ * Wird direkt aus der ADC-ISR aufgerufen und muss daher sehr kurz sein.
+ *
+ * @param channel Kanalnummer (0-12)
+ * @param value 10-bit ADC-Wert (0-1023)
+ */
+typedef void (*AdcSampleHook)(uint8_t channel, uint16_t value);
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Startet den ADC-Scanner im Free-Running-Modus.
+ *
+ * Konfiguriert AVcc-Referenz, Prescaler 128 (ca. 9600 Wandlungen/s),
+ * Auto-Trigger und Conversion-Complete-Interrupt und deaktiviert die
+ * digitalen Eingänge der gescannten Pins. Danach darf analogRead()
+ * nicht mehr verwendet werden.
+ */
+void adcScanBegin();
+
+/**
+ * @brief Hält den ADC-Scanner an.
+ *
+ * Deaktiviert Auto-Trigger und Interrupt. Die Ringpuffer bleiben erhalten.
+ */
+void adcScanStop();
+
+/**
+ * @brief Legt die Abtastrate eines Kanals fest.
+ *
+ * Ein Kanal wird nur in jeder divider-ten Scan-Runde besucht und
+ * liefert pro Besuch burst Messwerte. Nach jedem Kanalwechsel werden
+ * unabhängig davon die ersten Messungen verworfen (Multiplexer-Settling).
+ *
+ * @param channel Kanalnummer (0-12, entspricht A0-A12)
+ * @param divider Besuch in jeder n-ten Runde (1 = jede Runde)
+ * @param burst Anzahl übernommener Messwerte pro Besuch (mindestens 1)
+ */
+void adcScanSetChannelRate(uint8_t channel, uint8_t divider, uint8_t burst);
+
+/**
+ * @brief Registriert einen Callback für jeden Messwert eines Kanals.
+ *
+ * Ermöglicht Modulen wie dem Mikrofon-Hüllkurven-Tracker, jede
+ * Messung inkrementell zu verarbeiten, statt selbst zu sampeln.
+ *
+ * @param channel Kanalnummer (0-12)
+ * @param hook Callback oder NULL zum Entfernen
+ */
+void adcScanSetSampleHook(uint8_t channel, AdcSampleHook hook);
+
+/**
+ * @brief Liefert den Mittelwert des Ringpuffers eines Kanals.
+ *
+ * Nicht-blockierend: kopiert den Ringpuffer unter kurzer
+ * Interruptsperre und mittelt außerhalb davon.
+ *
+ * @param channel Kanalnummer (0-12)
+ * @return Gemittelter 10-bit ADC-Wert (0-1023), 0 wenn noch keine Daten
+ */
+uint16_t adcScanAverage(uint8_t channel);
+
+/**
+ * @brief Liefert den zuletzt gewandelten Wert eines Kanals.
+ *
+ * @param channel Kanalnummer (0-12)
+ * @return Letzter 10-bit ADC-Wert (0-1023), 0 wenn noch keine Daten
+ */
+uint16_t adcScanLatest(uint8_t channel);
+
+/**
+ * @brief Liefert die Spanne (Maximum - Minimum) des Ringpuffers.
+ *
+ * @param channel Kanalnummer (0-12)
+ * @return Peak-to-Peak-Wert der gepufferten Messwerte
+ */
+uint16_t adcScanPeakToPeak(uint8_t channel);
+
+/**
+ * @brief Liefert die Anzahl bisher übernommener Messwerte eines Kanals.
+ *
+ * Läuft bei 65535 über; geeignet zur Erkennung neuer Messwerte.
+ *
+ * @param channel Kanalnummer (0-12)
+ * @return Messwertzähler des Kanals
+ */
+uint16_t adcScanSampleCount(uint8_t channel);
+
+/**
+ * @brief Rechnet einen Arduino-Analogpin in eine Scanner-Kanalnummer um.
+ *
+ * @param pin Analoger Pin (A0-A12)
+ * @return Kanalnummer (0-12)
+ */
+inline uint8_t adcScanChannel(uint8_t pin) { return pin - A0; }
+
+#endif // ADC_SCANNER_H
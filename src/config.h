@@ -19,19 +19,58 @@
 // Pin-Definitionen
 const uint8_t TDS_SENSOR_PIN = A12; // TDS Sensor (Wasserqualität)
 // const uint8_t TEMP_SENSOR_PIN = 8;        // OneWire Temperatursensor (DEAKTIVIERT)
-const uint8_t DHT_SENSOR_PIN = 22;        // DHT11 Temperatur & Luftfeuchtigkeit
+const uint8_t DHT_SENSOR_PIN = 2;         // DHT11 Temperatur & Luftfeuchtigkeit (INT4, PE4 - Flankenmessung per Interrupt)
 const uint8_t SD_CHIP_SELECT = 10;        // SD-Karte CS Pin
-const uint8_t RADIATION_INPUT_PIN = 29;   // Geigerzähler/Radioaktivitätssensor
+const uint8_t RADIATION_INPUT_PIN = 47;   // Geigerzähler an T5 (Timer5 externer Takt, PL2)
+const uint8_t RTC_SQW_PIN = 3;            // DS1307 SQW-Ausgang 1 Hz (INT5, PE5 - Sekundenflanke per Interrupt)
 
 // OLED Display (I2C)
 const uint8_t OLED_SCREEN_WIDTH = 128;    // OLED Display Breite in Pixel
 const uint8_t OLED_SCREEN_HEIGHT = 64;    // OLED Display Höhe in Pixel
 const int8_t OLED_RESET_PIN = -1;         // Reset Pin (-1 = shared Arduino reset pin)
 const uint8_t OLED_I2C_ADDRESS = 0x3C;    // Standard I2C Adresse für 128x64 OLED
+const uint8_t OLED_SEGMENT_WIDTH = 16;    // Spalten pro Prüfsummen-Segment (Änderungserkennung)
+const uint8_t OLED_FULL_REFRESH_FLUSHES = 30; // Jedes 30. Bild komplett übertragen (Selbstheilung)
+const uint8_t OLED_TILE_BUFFERS = 2;      // Tile-Puffer zu 128 Byte (1 = zeichnen und senden nacheinander)
+
+const uint32_t SERIAL_BAUD = 115200;      // 64-Byte-Sendepuffer ist nach ca. 6 ms leer
+
+// Serielle Ausgabe: 0 = Text (Debug-Zeilen, CSV), 1 = binäre Telemetrie-Rahmen
+// (siehe telemetry_format.h, Dekodierung am PC mit tools/hstelemetry).
+// Mit Telemetrie sind alle DEBUG_PRINT-Ausgaben abgeschaltet.
+#define TELEMETRY_ENABLED 0
+
+// Tokenisierte Debug-Meldungen (trace.h): 1 = nur ID + Rohargumente puffern und als
+// Telemetrie-Rahmen senden (benötigt TELEMETRY_ENABLED), 0 = sofort als Text
+#define TRACE_ENABLED 0
+const uint8_t TRACE_BUFFER_SIZE = 128;    // Trace-Ringpuffer in Bytes (Zweierpotenz, max. 128)
+
+// Laufzeitmessung (perf_probe.h): 1 = Timer1 als Zyklenzähler, PERF_SCOPE-Messpunkte
+// aktiv (Timer1 steht dann nicht für analogWrite an Pin 11/12, Servo oder tone zur Verfügung).
+// Der Host-Build (platformio.ini, env:native) setzt 1 über die build_flags.
+#ifndef PERF_ENABLED
+#define PERF_ENABLED 0
+#endif
+const uint8_t PERF_HISTOGRAM_BUCKETS = 16;  // Histogrammklassen je Abschnitt (je 2 Byte RAM)
+const uint8_t PERF_HISTOGRAM_MIN_SHIFT = 8; // Erste Klasse < 2^8 Zyklen (16 µs), letzte >= 2^22 (262 ms)
+
+// Abtastender Profiler (profiler.h): 1 = Timer3 tastet den Programmzähler ab,
+// Ausgabe mit dem Befehl "prof", Auswertung am PC mit tools/hsprof
+#define PROFILER_ENABLED 0
+const uint16_t PROFILER_SAMPLE_HZ = 997;    // Abtastrate (kein Teiler der Task-Perioden, max. 4000)
+const uint16_t PROFILER_BINS = 512;         // Histogrammklassen (je 2 Byte RAM)
+const uint8_t PROFILER_BIN_SHIFT = 8;       // 256 Byte Flash je Klasse, 512 Klassen decken 128 KB ab
 
-const uint32_t SERIAL_BAUD = 9600;
+const uint8_t SERIAL_COMMAND_MAX_LENGTH = 16; // Längste Befehlszeile (serial_command.h)
 #define GPS_BAUD 9600
 
+// I2C-Bus (eigene TWI-Queue, RTC mit 100 kHz, OLED mit 400 kHz)
+const uint8_t RTC_I2C_ADDRESS = 0x68;     // DS1307
+const uint8_t TWI_QUEUE_DEPTH = 16;       // Wartende Anfragen normaler Priorität (OLED: 2 je Page)
+const uint8_t TWI_HIGH_QUEUE_DEPTH = 4;   // Wartende Anfragen hoher Priorität (RTC)
+const uint8_t TWI_CHUNK_SIZE = 32;        // Max. Bytes pro Teiltransaktion großer Schreibvorgänge
+const unsigned long TWI_TIMEOUT_MS = 20;  // Transaktion ohne Fortschritt gilt danach als hängend
+
 // Gas-Sensoren (MQ-Serie) - Analoge Pins
 const uint8_t MQ2_PIN = A0;   // Methan, Butan, LPG, Rauch
 const uint8_t MQ3_PIN = A1;   // Alkohol, Ethanol
@@ -46,6 +85,21 @@ const uint8_t MIC_KLEIN_PIN = A9;
 const uint8_t MIC_GROSS_PIN = A10;
 const uint8_t LDR_PIN = A11;  // Lichtsensor (Light Dependent Resistor)
 
+// ADC-Scanner (free-running, interruptgesteuert über A0-A12)
+const uint8_t ADC_SCAN_CHANNELS = 13;        // Anzahl gescannter Kanäle (A0 bis A12)
+const uint8_t ADC_SCAN_RING_SIZE = 8;        // Messwerte pro Kanal (Zweierpotenz!)
+const uint8_t ADC_SCAN_SETTLE_DISCARD = 1;   // Zusätzlich verworfene Messungen nach Kanalwechsel
+
+// Mikrofon-Hüllkurve (kontinuierlich aus dem ADC-Scanner)
+const uint8_t MIC_ENV_BURST = 4;                 // Messwerte pro Scanner-Besuch der Mikrofonkanäle
+const unsigned long MIC_ENV_SHORT_MS = 100;      // Kurzes Fenster (ms)
+const uint8_t MIC_ENV_MID_WINDOWS = 10;          // Mittleres Fenster = 10 kurze (1 s)
+const uint8_t MIC_ENV_LONG_WINDOWS = 10;         // Langes Fenster = 10 mittlere (10 s)
+
+// DHT-Treiber (Zustandsmaschine, Bitdekodierung im INT4-Interrupt)
+const uint8_t DHT_SENSOR_TYPE = 11;              // 11 = DHT11, 22 = DHT22
+const unsigned long DHT_STALE_MS = 10000;        // Zwischengespeicherter Wert gilt danach als veraltet
+
 // ==============================================
 // TIMING KONFIGURATION
 // ==============================================
@@ -54,7 +108,43 @@ const unsigned long SENSOR_INTERVAL = 2000;    // Gas-Sensoren Intervall (ms)
 const unsigned long LOGGING_INTERVAL = 2000;   // Hauptloop Logging Intervall (2 Sekunden für stabilere SD-Karte)
 const unsigned long TEMP_SENSOR_DELAY = 1000;  // Temperatur-Konvertierungszeit (ms)
 const unsigned long SD_INIT_DELAY = 200;       // SD-Karte Initialisierung (ms)
+const uint16_t LOG_SYNC_ROWS = 30;             // Log-Datei spätestens nach 30 Zeilen synchronisieren
+const unsigned long LOG_SYNC_INTERVAL_MS = 60000; // ... oder spätestens nach 60 Sekunden
+const uint8_t LOG_QUEUE_DEPTH = 8;             // Log-Queue: Einträge (Zweierpotenz, je ca. 50 Byte RAM)
+const unsigned long LOG_DRAIN_BUDGET_MS = 20;  // Max. Schreibzeit des Log-Writer-Tasks pro Durchlauf
 const unsigned long OLED_UPDATE_INTERVAL = 2000; // OLED Display Update alle 2 Sekunden
+const unsigned long SYSTEM_CHECK_INTERVAL = 30000; // System-Check alle 30 Sekunden
+
+// Zeitdienst (RTC-Zeit aus SQW-Flanken + millis(), I2C nur zum Abgleich)
+const unsigned long TIME_RESYNC_INTERVAL_MS = 600000; // Abgleich mit den RTC-Registern alle 10 Minuten
+const unsigned long TIME_FALLBACK_RESYNC_MS = 60000;  // ... ohne SQW-Signal jede Minute
+const unsigned long TIME_SYNC_WINDOW_MS = 400;        // Abgleich nur so lange nach einer Flanke
+const unsigned long TIME_SQW_TIMEOUT_MS = 2500;       // Ohne Flanke gilt das SQW-Signal als ausgefallen
+
+// Scheduler: Phasenversatz der Tasks (ms nach Start), so gewählt, dass
+// Sensorabfrage, SD-Schreiben und OLED-Refresh nie auf denselben Tick fallen
+const uint8_t SCHEDULER_MAX_TASKS = 13;
+const unsigned long DHT_TASK_PERIOD = 5;         // DHT-Zustandsmaschine
+const unsigned long MIC_TASK_PERIOD = 10;        // Mikrofon-Hüllkurve
+const unsigned long SENSOR_INIT_TASK_PERIOD = 100; // Non-blocking Sensor-Initialisierung
+const unsigned long LOG_WRITER_TASK_PERIOD = 250;  // Log-Queue auf die SD-Karte leeren
+const unsigned long TIME_SERVICE_TASK_PERIOD = 100; // SQW-Überwachung und RTC-Abgleich
+const unsigned long TWI_WATCHDOG_TASK_PERIOD = 10;  // Hängende I2C-Übertragungen abbrechen
+const unsigned long TRACE_TASK_PERIOD = 20;         // Trace-Puffer in Telemetrie-Rahmen leeren
+const unsigned long SERIAL_COMMAND_TASK_PERIOD = 50; // Serielle Befehle annehmen
+const unsigned long DISPLAY_TASK_PERIOD = 10;       // OLED-Bild fortsetzen, sobald ein Tile-Puffer frei ist
+const unsigned long DHT_TASK_PHASE = 0;
+const unsigned long MIC_TASK_PHASE = 2;
+const unsigned long SENSOR_TASK_PHASE = 3;
+const unsigned long SENSOR_INIT_TASK_PHASE = 53;
+const unsigned long LOG_WRITER_TASK_PHASE = 77;
+const unsigned long TIME_SERVICE_TASK_PHASE = 41;
+const unsigned long TWI_WATCHDOG_TASK_PHASE = 7;
+const unsigned long TRACE_TASK_PHASE = 13;
+const unsigned long SERIAL_COMMAND_TASK_PHASE = 29;
+const unsigned long LOGGING_TASK_PHASE = 503;    // Nach der Sensorabfrage: frischer Snapshot
+const unsigned long DISPLAY_TASK_PHASE = 1004;   // Rest 4 mod 10: frei neben Sensoren, Trace, SensorInit (3)
+const unsigned long SYSTEM_CHECK_TASK_PHASE = 1503;
 
 // ==============================================
 // SPEICHER-OPTIMIERUNG
@@ -68,7 +158,7 @@ const uint8_t ADDR_BUFFER_SIZE = 8;
 // Zusätzliche Speicher-Konstanten
 const uint8_t MAX_GAS_SENSORS = 9;
 const uint8_t MAX_MICROPHONES = 2;
-const uint8_t CSV_BUFFER_SIZE = 128;       // Für CSV-Zeilen
+const uint8_t CSV_BUFFER_SIZE = 160;       // Für CSV-Zeilen (längste Zeile ca. 135 Zeichen)
 
 // ==============================================
 // STANDORT
@@ -84,6 +174,10 @@ const double HOME_LON = 8.165440;   // QTH Längengrad
 
 const uint8_t MAX_FILENAME_LEN = 13;  // 8.3 Format für FAT16/32
 
+// Log-Format: 0 = CSV-Text (.CSV), 1 = kompaktes Binärformat (.HSL, siehe log_format.h,
+// Umwandlung am PC mit tools/hslog2csv)
+#define LOG_BINARY_FORMAT 0
+
 // ==============================================
 // SENSOR KALIBRIERUNG
 // ==============================================
@@ -99,7 +193,7 @@ const float TEMP_PRECISION = 0.0625;
 #define USE_FLASH_STRINGS 1      // F() Makro für Strings verwenden
 #define ENABLE_DETAILED_LOGGING 1 // Detaillierte Logs einschalten
 
-#if DEBUG_ENABLED
+#if DEBUG_ENABLED && !TELEMETRY_ENABLED
   #define DEBUG_PRINT(x) Serial.print(x)
   #define DEBUG_PRINTLN(x) Serial.println(x)
 #else
@@ -110,5 +204,6 @@ const float TEMP_PRECISION = 0.0625;
 // Memory-kritische Warnungen
 #define RAM_WARNING_THRESHOLD 512    // Warnung bei < 512 Bytes
 #define RAM_CRITICAL_THRESHOLD 256   // Kritisch bei < 256 Bytes
+const uint8_t MEMORY_PAINT_BYTE = 0xC5;  // Füllwert für Stack-Painting (memory_monitor.h)
 
 #endif // CONFIG_H
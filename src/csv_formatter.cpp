@@ -0,0 +1,110 @@
+/*
+ * Implementierung des CSV-Formatierers
+ */
+
+#include "csv_formatter.h"
+#include <Arduino.h>
+#include "heap_guard.h"
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+static const int32_t CSV_POWERS_OF_TEN[] = { 1, 10, 100, 1000, 10000 };
+static const uint8_t CSV_MAX_DECIMALS = 4;
+
+// ==============================================
+// GRUNDFUNKTIONEN
+// ==============================================
+
+void csvBegin(CsvWriter* writer, char* buffer, uint16_t capacity) {
+  writer->buffer = buffer;
+  writer->capacity = capacity;
+  writer->length = 0;
+  writer->overflow = (capacity == 0);
+  if (capacity > 0) buffer[0] = '\0';
+}
+
+void csvAppendChar(CsvWriter* writer, char c) {
+  // Platz für den Nullterminator freihalten
+  if (writer->length + 1 >= writer->capacity) {
+    writer->overflow = true;
+    return;
+  }
+  writer->buffer[writer->length++] = c;
+}
+
+void csvAppendString(CsvWriter* writer, const char* text) {
+  if (!text) return;
+  while (*text) csvAppendChar(writer, *text++);
+}
+
+void csvAppendString(CsvWriter* writer, const __FlashStringHelper* text) {
+  if (!text) return;
+  PGM_P p = reinterpret_cast<PGM_P>(text);
+  char c;
+  while ((c = pgm_read_byte(p++)) != '\0') csvAppendChar(writer, c);
+}
+
+void csvAppendUnsigned(CsvWriter* writer, uint32_t value, uint8_t minDigits) {
+  // Ziffern rückwärts erzeugen (uint32_t hat höchstens 10 Stellen)
+  char digits[10];
+  uint8_t count = 0;
+  do {
+    digits[count++] = '0' + (char)(value % 10);
+    value /= 10;
+  } while (value > 0 && count < sizeof(digits));
+
+  while (minDigits > count) {
+    csvAppendChar(writer, '0');
+    minDigits--;
+  }
+  while (count > 0) csvAppendChar(writer, digits[--count]);
+}
+
+void csvAppendInt(CsvWriter* writer, int32_t value) {
+  if (value < 0) {
+    csvAppendChar(writer, '-');
+    csvAppendUnsigned(writer, (uint32_t)(-(value + 1)) + 1);
+  } else {
+    csvAppendUnsigned(writer, (uint32_t)value);
+  }
+}
+
+void csvAppendFixed(CsvWriter* writer, int32_t scaled, uint8_t decimals) {
+  if (decimals > CSV_MAX_DECIMALS) decimals = CSV_MAX_DECIMALS;
+
+  uint32_t magnitude;
+  if (scaled < 0) {
+    csvAppendChar(writer, '-');
+    magnitude = (uint32_t)(-(scaled + 1)) + 1;
+  } else {
+    magnitude = (uint32_t)scaled;
+  }
+
+  uint32_t divisor = (uint32_t)CSV_POWERS_OF_TEN[decimals];
+  csvAppendUnsigned(writer, magnitude / divisor);
+  if (decimals > 0) {
+    csvAppendChar(writer, '.');
+    csvAppendUnsigned(writer, magnitude % divisor, decimals);
+  }
+}
+
+void csvAppendFloat(CsvWriter* writer, float value, uint8_t decimals) {
+  if (decimals > CSV_MAX_DECIMALS) decimals = CSV_MAX_DECIMALS;
+  if (isnan(value)) {
+    csvAppendString(writer, F("nan"));
+    return;
+  }
+
+  // In Festkomma runden und auf den int32_t-Bereich begrenzen
+  float scaled = value * CSV_POWERS_OF_TEN[decimals];
+  if (scaled > 2147483000.0f) scaled = 2147483000.0f;
+  if (scaled < -2147483000.0f) scaled = -2147483000.0f;
+  csvAppendFixed(writer, (int32_t)(scaled + (scaled < 0 ? -0.5f : 0.5f)), decimals);
+}
+
+uint16_t csvEnd(CsvWriter* writer) {
+  if (writer->capacity > 0) writer->buffer[writer->length] = '\0';
+  return writer->overflow ? 0 : writer->length;
+}
@@ -0,0 +1,94 @@
+/*
+ * CSV-Formatierer für das Umweltkontrollsystem
+ * Heap-freie Zeilenerzeugung in einen vom Aufrufer gestellten Puffer
+ *
+ * Zahlen werden ohne String, dtostrf oder snprintf umgewandelt:
+ * Ganzzahlen über Ziffernzerlegung, Kommazahlen als skalierte
+ * Festkommazahl (z.B. 23.4 °C -> 234 mit einer Nachkommastelle).
+ * Läuft der Puffer über, wird die Zeile als ungültig markiert statt
+ * abgeschnitten geschrieben.
+ */
+
+#ifndef CSV_FORMATTER_H
+#define CSV_FORMATTER_H
+
+#include "config.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Schreibzustand einer CSV-Zeile mit fester Kapazität.
+ */
+struct CsvWriter {
+  char* buffer;        ///< Zielpuffer (vom Aufrufer)
+  uint16_t capacity;   ///< Puffergröße inkl. Nullterminator
+  uint16_t length;     ///< Bisher geschriebene Zeichen
+  bool overflow;       ///< true wenn mindestens ein Zeichen nicht mehr passte
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Beginnt eine neue Zeile im angegebenen Puffer.
+ *
+ * @param writer Schreibzustand
+ * @param buffer Zielpuffer
+ * @param capacity Puffergröße in Bytes (inkl. Nullterminator)
+ */
+void csvBegin(CsvWriter* writer, char* buffer, uint16_t capacity);
+
+/** @brief Hängt ein einzelnes Zeichen an. */
+void csvAppendChar(CsvWriter* writer, char c);
+
+/** @brief Hängt einen nullterminierten String aus dem RAM an. */
+void csvAppendString(CsvWriter* writer, const char* text);
+
+/** @brief Hängt einen F()-String aus dem Flash an. */
+void csvAppendString(CsvWriter* writer, const __FlashStringHelper* text);
+
+/**
+ * @brief Hängt eine vorzeichenlose Ganzzahl an.
+ *
+ * @param writer Schreibzustand
+ * @param value Wert
+ * @param minDigits Mindestanzahl Ziffern (mit führenden Nullen aufgefüllt)
+ */
+void csvAppendUnsigned(CsvWriter* writer, uint32_t value, uint8_t minDigits = 1);
+
+/** @brief Hängt eine vorzeichenbehaftete Ganzzahl an. */
+void csvAppendInt(CsvWriter* writer, int32_t value);
+
+/**
+ * @brief Hängt eine Festkommazahl an.
+ *
+ * @param writer Schreibzustand
+ * @param scaled Wert * 10^decimals (z.B. 234 für 23.4 bei decimals = 1)
+ * @param decimals Anzahl Nachkommastellen (0-4)
+ */
+void csvAppendFixed(CsvWriter* writer, int32_t scaled, uint8_t decimals);
+
+/**
+ * @brief Hängt eine Kommazahl gerundet auf decimals Stellen an.
+ *
+ * Eine Multiplikation und Rundung in die Festkommadarstellung, danach
+ * reine Ganzzahlausgabe.
+ *
+ * @param writer Schreibzustand
+ * @param value Wert
+ * @param decimals Anzahl Nachkommastellen (0-4)
+ */
+void csvAppendFloat(CsvWriter* writer, float value, uint8_t decimals);
+
+/**
+ * @brief Schließt die Zeile ab (Nullterminator).
+ *
+ * @param writer Schreibzustand
+ * @return Länge der Zeile oder 0 bei Pufferüberlauf
+ */
+uint16_t csvEnd(CsvWriter* writer);
+
+#endif // CSV_FORMATTER_H
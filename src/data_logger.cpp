@@ -3,7 +3,15 @@
  */
 
 #include "data_logger.h"
+#include "log_writer.h"
+#include "log_queue.h"
+#include "time_service.h"
+#include "log_format.h"
+#include "csv_formatter.h"
+#include "perf_probe.h"
+#include "trace.h"
 #include <Arduino.h>
+#include "heap_guard.h"
 
 // ==============================================
 // GLOBALE VARIABLEN
@@ -12,6 +20,18 @@
 char globalLogFilename[FILENAME_LENGTH];
 bool sdCardInitialized = false;
 
+// Spaltenüberschriften der CSV-Datei (einzige Definition, siehe formatCSVHeader)
+static const char CSV_HEADER[] PROGMEM =
+  "DateTime,SecSinceMidnight-MS,Temperature_DHT_C,Humidity_RH,Light_Level,Light_Percent,"
+  "MQ2,MQ3,MQ4,MQ5,MQ6,MQ7,MQ8,MQ9,MQ135,Mic1,Mic2,TDS,Radiation_CPS";
+
+#if LOG_BINARY_FORMAT
+// Zustand des laufenden CRC-Blocks im Binärformat
+static uint16_t binaryBlockSequence = 0;
+static uint8_t binaryBlockFill = 0;
+static uint16_t binaryBlockCrc = 0xFFFF;
+#endif
+
 // ==============================================
 // SD-KARTE TIMESTAMP CALLBACK
 // ==============================================
@@ -19,7 +39,7 @@ bool sdCardInitialized = false;
 // Callback-Funktion für korrekte Datei-Timestamps
 void dateTime(uint16_t* date, uint16_t* time) {
   RTCData currentTime;
-  readRTCData(&currentTime);
+  timeServiceNow(&currentTime);
   
   // FAT Datei-Timestamp Format (MS-DOS kompatibel)
   // Datum: Bits 15-9 = Jahr-1980, Bits 8-5 = Monat, Bits 4-0 = Tag
@@ -37,7 +57,7 @@ bool initSDCard() {
   DEBUG_PRINT(F("Initialisiere SD-Karte..."));
   
   if (!SD.begin(SD_CHIP_SELECT)) {
-    DEBUG_PRINTLN(F("FEHLER: SD-Karte nicht gefunden oder defekt!"));
+    TRACE(SD_NOT_FOUND);
     sdCardInitialized = false;
     return false;
   }
@@ -70,7 +90,7 @@ void printSDCardInfo() {
 
 bool createLogFile(char* filename, uint8_t filenameSize) {
   if (!sdCardInitialized) {
-    DEBUG_PRINTLN(F("FEHLER: SD-Karte nicht initialisiert!"));
+    TRACE(SD_NOT_INITIALIZED);
     return false;
   }
   
@@ -87,15 +107,23 @@ bool createLogFile(char* filename, uint8_t filenameSize) {
   // Neue Datei erstellen und Header schreiben
   File logFile = SD.open(filename, FILE_WRITE);
   if (!logFile) {
-    DEBUG_PRINT(F("FEHLER: Kann Datei nicht erstellen: "));
-    DEBUG_PRINTLN(filename);
+    TRACE(LOG_CREATE_FAILED);
     return false;
   }
   
   // Header schreiben
   RTCData currentTime;
-  readRTCData(&currentTime);
-  
+  timeServiceNow(&currentTime);
+
+#if LOG_BINARY_FORMAT
+  if (!writeBinaryFileHeader(logFile, currentTime.timestamp)) {
+    TRACE(LOG_HEADER_FAILED);
+    logFile.close();
+    return false;
+  }
+  binaryBlockSequence = 0;
+  binaryBlockFill = 0;
+#else
   logFile.print(F("# Umweltkontrollsystem Log\n"));
   logFile.print(F("# Start: "));
   logFile.print(currentTime.year);
@@ -117,8 +145,10 @@ bool createLogFile(char* filename, uint8_t filenameSize) {
   
   
   // CSV Header mit Komma-Trennung
-  logFile.println(F("DateTime,SecSinceMidnight-MS,Temperature_DHT_C,Humidity_RH,Light_Level,Light_Percent,MQ2,MQ3,MQ4,MQ5,MQ6,MQ7,MQ8,MQ9,MQ135,Mic1,Mic2,TDS,Radiation_CPS"));
+  logFile.println(reinterpret_cast<const __FlashStringHelper*>(CSV_HEADER));
   
+#endif
+
   logFile.close();
   
   // Globalen Dateinamen setzen
@@ -129,64 +159,283 @@ bool createLogFile(char* filename, uint8_t filenameSize) {
   DEBUG_PRINTLN(filename);
   
   delay(SD_INIT_DELAY);
-  return true;
+
+  // Datei für den Betrieb dauerhaft offen halten
+  return openLogFile(globalLogFilename);
+}
+
+bool openLogFile(const char* filename) {
+  if (!sdCardInitialized) {
+    return false;
+  }
+  return logWriterOpen(filename);
+}
+
+void closeLogFile() {
+  logWriterClose();
 }
 
 void generateFilename(char* filename, uint8_t filenameSize) {
   RTCData currentTime;
-  readRTCData(&currentTime);
+  timeServiceNow(&currentTime);
   
   // 8.3 Format: MMDDhhmm.CSV (Monat, Tag, Stunde, Minute - 8 Zeichen, MESZ Zeit)
-  snprintf(filename, filenameSize, "%02d%02d%02d%02d.CSV", 
-           currentTime.month, currentTime.day, currentTime.hour, currentTime.minute);
+  CsvWriter writer;
+  csvBegin(&writer, filename, filenameSize);
+  csvAppendUnsigned(&writer, currentTime.month, 2);
+  csvAppendUnsigned(&writer, currentTime.day, 2);
+  csvAppendUnsigned(&writer, currentTime.hour, 2);
+  csvAppendUnsigned(&writer, currentTime.minute, 2);
+  csvAppendString(&writer, LOG_BINARY_FORMAT ? F(".HSL") : F(".CSV"));
+  csvEnd(&writer);
 }
 
 // ==============================================
-// DATENPROTOKOLLIERUNG
+// BINÄRFORMAT (HSLOG)
 // ==============================================
 
-bool logSensorData(float temperature_dht, float humidity, const RTCData* rtc, float tdsValue) {
-  if (!sdCardInitialized || strlen(globalLogFilename) == 0) {
-    DEBUG_PRINTLN(F("FEHLER: Kein Log-File!"));
-    return false;
+// Begrenzt einen Wert auf den Bereich von uint16_t
+static uint16_t saturateU16(float value) {
+  if (value <= 0) return 0;
+  if (value >= 65535.0) return 65535;
+  return (uint16_t)(value + 0.5);
+}
+
+bool writeBinaryFileHeader(File& file, uint32_t createdEpoch) {
+  HsLogFileHeader header;
+  memcpy(header.magic, HSLOG_MAGIC, sizeof(header.magic));
+  header.version = HSLOG_VERSION;
+  header.fieldCount = HSLOG_FIELD_COUNT;
+  header.recordSize = sizeof(HsLogRecord);
+  header.blockRecords = HSLOG_BLOCK_RECORDS;
+  header.reserved = 0;
+  header.createdEpoch = createdEpoch;
+
+  uint16_t crc = hslogCrc16(0xFFFF, &header, sizeof(header));
+  if (file.write((const uint8_t*)&header, sizeof(header)) != sizeof(header)) return false;
+
+  // Schema aus dem Flash kopieren
+  for (uint8_t i = 0; i < HSLOG_FIELD_COUNT; i++) {
+    HsLogFieldDescriptor field;
+    memcpy_P(&field, &HSLOG_FIELDS[i], sizeof(field));
+    crc = hslogCrc16(crc, &field, sizeof(field));
+    if (file.write((const uint8_t*)&field, sizeof(field)) != sizeof(field)) return false;
   }
-  int microphones[2];
-  readAllMicrophones(microphones);
-  int gasSensors[9];
-  readAllGasSensors(gasSensors);
-  int radiationCount = getRadiationCountAndReset();
+  return file.write((const uint8_t*)&crc, sizeof(crc)) == sizeof(crc);
+}
 
-  String csvLine = "";
-  if (rtc->year > 2000) {
-    char dateTimeStr[40];
-    formatLocalDateTime(rtc, dateTimeStr, sizeof(dateTimeStr));
-    csvLine += dateTimeStr;
+void packLogRecord(const LogEntry* entry, HsLogRecord* record) {
+  // LogEntry ist bereits Festkomma - reines Umkopieren
+  record->epoch = entry->rtcData.timestamp;
+  record->millis = entry->rtcData.millisecond;
+  record->temperature = entry->temperature_dht;
+  record->humidity = entry->humidity;
+  record->light = entry->lightLevel;
+  for (uint8_t i = 0; i < MAX_GAS_SENSORS; i++) {
+    record->gas[i] = entry->gasSensors[i];
+  }
+  for (uint8_t i = 0; i < MAX_MICROPHONES; i++) {
+    record->mic[i] = entry->microphones[i];
+  }
+  record->tds = entry->tdsValue;
+  record->radiation = entry->radiationCPS;
+  record->flags = (entry->dhtValid ? HSLOG_FLAG_DHT_VALID : 0) |
+                  (entry->rtcData.isValid ? HSLOG_FLAG_RTC_VALID : 0);
+}
+
+#if LOG_BINARY_FORMAT
+
+static bool logBinaryRecord(const HsLogRecord* record) {
+  // Blockkopf, Datensatz und ggf. Block-CRC werden zusammengestellt und
+  // in einem Stück übergeben: Der Log-Writer übernimmt alles oder nichts,
+  // ein erneuter Versuch erzeugt also weder doppelte Köpfe noch Datensätze
+  uint8_t chunk[sizeof(HsLogBlockHeader) + sizeof(HsLogRecord) + sizeof(uint16_t)];
+  uint8_t length = 0;
+  uint16_t crc = binaryBlockCrc;
+
+  // Blockkopf vor dem ersten Datensatz eines Blocks
+  if (binaryBlockFill == 0) {
+    HsLogBlockHeader block = { HSLOG_BLOCK_MARKER, binaryBlockSequence };
+    memcpy(chunk, &block, sizeof(block));
+    length = sizeof(block);
+    crc = hslogCrc16(0xFFFF, &block, sizeof(block));
+  }
+
+  memcpy(&chunk[length], record, sizeof(*record));
+  length += sizeof(*record);
+  crc = hslogCrc16(crc, record, sizeof(*record));
+
+  // Block mit CRC abschließen
+  bool closesBlock = binaryBlockFill + 1 >= HSLOG_BLOCK_RECORDS;
+  if (closesBlock) {
+    memcpy(&chunk[length], &crc, sizeof(crc));
+    length += sizeof(crc);
+  }
+
+  if (!logWriterWriteRecord(chunk, length)) return false;
+
+  // Blockzustand erst nach der Übernahme fortschreiben
+  binaryBlockCrc = crc;
+  if (closesBlock) {
+    binaryBlockFill = 0;
+    binaryBlockSequence++;
   } else {
-    csvLine += "----/--/-- --:--:-- MEZ";
+    binaryBlockFill++;
+  }
+  return true;
+}
+
+#endif // LOG_BINARY_FORMAT
+
+// ==============================================
+// DATENPROTOKOLLIERUNG
+// ==============================================
+
+void fillLogEntry(const SensorSnapshot* snapshot, LogEntry* entry) {
+  entry->rtcData = snapshot->rtc;
+
+  float temperature = snapshot->temperature * 10.0f;
+  entry->temperature_dht = (int16_t)(temperature + (temperature < 0 ? -0.5f : 0.5f));
+  entry->humidity = saturateU16(snapshot->humidity * 10.0f);
+  entry->dhtValid = snapshot->dhtValid;
+
+  entry->lightLevel = (uint16_t)snapshot->lightLevel;
+  entry->lightPercent = saturateU16(snapshot->lightPercent * 10.0f);
+  for (uint8_t i = 0; i < MAX_GAS_SENSORS; i++) {
+    entry->gasSensors[i] = (uint16_t)snapshot->gasSensors[i];
   }
-  csvLine += ",";
-  csvLine += String(temperature_dht, 1); csvLine += ",";
-  csvLine += String(humidity, 1); csvLine += ",";
-  for (int i = 0; i < 9; i++) {
-    csvLine += String(gasSensors[i]);
-    csvLine += ",";
+  for (uint8_t i = 0; i < MAX_MICROPHONES; i++) {
+    entry->microphones[i] = (uint16_t)snapshot->microphones[i];
   }
-  for (int i = 0; i < 2; i++) {
-    csvLine += String(microphones[i]);
-    csvLine += ",";
+  entry->tdsValue = saturateU16(snapshot->tdsValue);
+  entry->radiationCPS = saturateU16(snapshot->radiationCPS * 100.0f);
+}
+
+bool logData(const LogEntry* entry) {
+  if (!sdCardInitialized || strlen(globalLogFilename) == 0) {
+    TRACE(LOG_NO_FILE);
+    return false;
+  }
+  // Datei bleibt offen; Zeile landet im Sektorpuffer des Log-Writers
+  if (!logWriterIsOpen() && !openLogFile(globalLogFilename)) {
+    TRACE(LOG_OPEN_FAILED);
+    return false;
   }
-  csvLine += String(tdsValue, 0); csvLine += ",";
-  csvLine += String(radiationCount);
 
-  File logFile = SD.open(globalLogFilename, FILE_WRITE);
-  if (!logFile) {
-    DEBUG_PRINTLN(F("FEHLER: Kann Log-Datei nicht öffnen!"));
+#if LOG_BINARY_FORMAT
+  HsLogRecord record;
+  packLogRecord(entry, &record);
+  return logBinaryRecord(&record);
+#else
+  // Zeile direkt in einen Stack-Puffer formatieren (kein String, kein Heap)
+  char csvLine[CSV_BUFFER_SIZE];
+  if (formatCSVEntry(entry, csvLine, sizeof(csvLine)) == 0) {
+    TRACE(LOG_LINE_TOO_LONG);
     return false;
   }
-  logFile.println(csvLine);
-  logFile.close();
+
+  if (!logWriterWriteLine(csvLine)) {
+    return false;
+  }
+#if !TELEMETRY_ENABLED
   Serial.println(csvLine);
+#endif
   return true;
+#endif
+}
+
+bool logSensorData(const SensorSnapshot* snapshot) {
+  LogEntry entry;
+  fillLogEntry(snapshot, &entry);
+  return logData(&entry);
+}
+
+void drainLogQueue() {
+  PERF_SCOPE(LOG_DRAIN);
+  unsigned long start = millis();
+  const LogEntry* entry;
+
+  // Zeitscheibe begrenzen: eine langsame Karte verzögert höchstens
+  // diesen Task, nie die Erfassung; der Rest folgt im nächsten Durchlauf
+  while ((entry = logQueuePeek()) != NULL) {
+    if (!logData(entry)) {
+      // Eintrag bleibt in der Queue und wird beim nächsten Durchlauf erneut geschrieben
+      TRACE(LOG_WRITE_RETRY);
+      return;
+    }
+    logQueuePop();
+    if (millis() - start >= LOG_DRAIN_BUDGET_MS) {
+      return;
+    }
+  }
+}
+
+// ==============================================
+// CSV-FORMAT
+// ==============================================
+
+void formatCSVHeader(char* buffer, int bufferSize) {
+  CsvWriter writer;
+  csvBegin(&writer, buffer, bufferSize);
+  csvAppendString(&writer, reinterpret_cast<const __FlashStringHelper*>(CSV_HEADER));
+  csvEnd(&writer);
+}
+
+uint16_t formatCSVEntry(const LogEntry* entry, char* buffer, int bufferSize) {
+  CsvWriter writer;
+  csvBegin(&writer, buffer, bufferSize);
+  const RTCData* rtc = &entry->rtcData;
+
+  // DateTime (Lokalzeit) und Sekunden seit Mitternacht mit Millisekunden
+  if (rtc->year > 2000) {
+    CivilTime local;
+    bool summerTime = epochToLocal(rtc->timestamp, &local);
+    csvAppendUnsigned(&writer, local.year, 4);
+    csvAppendChar(&writer, '-');
+    csvAppendUnsigned(&writer, local.month, 2);
+    csvAppendChar(&writer, '-');
+    csvAppendUnsigned(&writer, local.day, 2);
+    csvAppendChar(&writer, ' ');
+    csvAppendUnsigned(&writer, local.hour, 2);
+    csvAppendChar(&writer, ':');
+    csvAppendUnsigned(&writer, local.minute, 2);
+    csvAppendChar(&writer, ':');
+    csvAppendUnsigned(&writer, local.second, 2);
+    csvAppendString(&writer, summerTime ? F(" MESZ,") : F(" MEZ,"));
+
+    uint32_t secondsSinceMidnight = local.hour * 3600UL + local.minute * 60UL + local.second;
+    csvAppendUnsigned(&writer, secondsSinceMidnight);
+    csvAppendChar(&writer, '.');
+    csvAppendUnsigned(&writer, rtc->millisecond, 3);
+  } else {
+    csvAppendString(&writer, F("----/--/-- --:--:-- MEZ,"));
+  }
+
+  // Festkommawerte: keine Float-Arithmetik beim Schreiben
+  csvAppendChar(&writer, ',');
+  csvAppendFixed(&writer, entry->temperature_dht, 1);
+  csvAppendChar(&writer, ',');
+  csvAppendFixed(&writer, entry->humidity, 1);
+  csvAppendChar(&writer, ',');
+  csvAppendUnsigned(&writer, entry->lightLevel);
+  csvAppendChar(&writer, ',');
+  csvAppendFixed(&writer, entry->lightPercent, 1);
+
+  for (uint8_t i = 0; i < MAX_GAS_SENSORS; i++) {
+    csvAppendChar(&writer, ',');
+    csvAppendUnsigned(&writer, entry->gasSensors[i]);
+  }
+  for (uint8_t i = 0; i < MAX_MICROPHONES; i++) {
+    csvAppendChar(&writer, ',');
+    csvAppendUnsigned(&writer, entry->microphones[i]);
+  }
+
+  csvAppendChar(&writer, ',');
+  csvAppendUnsigned(&writer, entry->tdsValue);
+  csvAppendChar(&writer, ',');
+  csvAppendFixed(&writer, entry->radiationCPS, 2);
+
+  return csvEnd(&writer);
 }
 
 // ==============================================
@@ -10,6 +10,8 @@
 #include "config.h"
 #include "sensors.h"
 #include "rtc_module.h"
+#include "sensor_snapshot.h"
+#include "log_format.h"
 
 // ==============================================
 // DATENSTRUKTUREN
@@ -18,18 +20,23 @@
 /**
  * @brief Vollständiger Datensatz für einen Logging-Eintrag.
  *
- * Diese Struktur enthält alle Sensordaten und
- * Zeitstempel für einen kompletten Datenlogger-Eintrag.
+ * Feste Größe ohne Zeiger, damit Einträge in der Log-Queue (log_queue.h)
+ * kopiert werden können. Kommazahlen liegen bereits als Festkommawerte
+ * vor; das Formatieren beim Schreiben braucht keine Float-Arithmetik.
  */
 struct LogEntry {
-  char timestamp[INDEX_LENGTH];    ///< Formatierter Zeitstempel als String
-
-  float temperature_dht;           ///< Temperatur vom DHT11-Sensor in °C
-  float humidity;                  ///< Luftfeuchtigkeit vom DHT11-Sensor in %
-  int gasSensors[9];              ///< Array mit allen 9 Gassensor-Werten (0-1023)
-  int microphones[2];             ///< Array mit beiden Mikrofon-Pegeln (0-1023)
-  int radiationCount;             ///< Aktueller Radioaktivitätszählerstand
-  RTCData rtcData;                ///< Vollständige RTC-Zeitinformationen
+  RTCData rtcData;                 ///< Zeit der Erfassung (UTC, mit Millisekunden)
+
+  int16_t temperature_dht;         ///< Temperatur vom DHT11-Sensor in 1/10 °C
+  uint16_t humidity;               ///< Luftfeuchtigkeit vom DHT11-Sensor in 1/10 %
+  bool dhtValid;                   ///< true wenn die DHT11-Messung gültig war
+
+  uint16_t lightLevel;             ///< Lichtsensor-Rohwert (0-1023)
+  uint16_t lightPercent;           ///< Helligkeit in 1/10 %
+  uint16_t gasSensors[MAX_GAS_SENSORS];  ///< Alle 9 Gassensor-Werte (0-1023)
+  uint16_t microphones[MAX_MICROPHONES]; ///< Beide Mikrofon-Pegel (Peak-to-Peak)
+  uint16_t tdsValue;               ///< TDS-Wert in ppm (gesättigt bei 65535)
+  uint16_t radiationCPS;           ///< Impulse pro Sekunde in 1/100 (gesättigt bei 65535)
 };
 
 // ==============================================
@@ -74,8 +81,8 @@ bool createLogFile(char* filename, uint8_t filenameSize);
 /**
  * @brief Öffnet eine bestehende Log-Datei zum Anhängen von Daten.
  *
- * Öffnet die angegebene Datei im Append-Modus für weitere
- * Datenprotokollierung.
+ * Öffnet die angegebene Datei im Append-Modus und hält sie über den
+ * Log-Writer (log_writer.h) dauerhaft offen.
  *
  * @param filename Name der zu öffnenden Log-Datei
  * @return true wenn Datei erfolgreich geöffnet wurde, false bei Fehlern
@@ -87,6 +94,7 @@ bool openLogFile(const char* filename);
  *
  * Stellt sicher, dass alle gepufferten Daten auf die SD-Karte
  * geschrieben werden und schließt die Datei ordnungsgemäß.
+ * Vor einem Reset oder dem Entfernen der Karte aufrufen.
  */
 void closeLogFile();
 
@@ -104,8 +112,9 @@ bool writeLogHeader();
 /**
  * @brief Protokolliert einen vollständigen LogEntry in die Datei.
  *
- * Schreibt alle Daten eines LogEntry-Objekts als CSV-Zeile
- * in die aktuelle Log-Datei.
+ * Schreibt alle Daten eines LogEntry-Objekts als CSV-Zeile (bzw. im
+ * Binärformat als HSLOG-Datensatz) in den Sektorpuffer der offenen
+ * Log-Datei (Sync nach Zeilen-/Zeitbudget).
  *
  * @param entry Zeiger auf den zu protokollierenden LogEntry
  * @return true wenn Daten erfolgreich geschrieben wurden, false bei Fehlern
@@ -113,18 +122,36 @@ bool writeLogHeader();
 bool logData(const LogEntry* entry);
 
 /**
- * @brief Protokolliert Sensordaten direkt ohne LogEntry-Struktur.
+ * @brief Überträgt einen Sensor-Snapshot in einen LogEntry.
  *
- * Vereinfachte Logging-Funktion, die die wichtigsten Sensordaten
- * direkt entgegennimmt und als CSV-Zeile speichert.
+ * Rundet alle Kommazahlen einmalig in ihre Festkommadarstellung.
  *
- * @param temperature_dht Temperaturwert vom DHT11-Sensor in °C
- * @param humidity Luftfeuchtigkeitswert in %
- * @param rtc Zeiger auf RTC-Zeitdaten
- * @param tdsValue TDS-Wert in ppm
+ * @param snapshot Snapshot des Messzyklus
+ * @param entry Ausgabe des Eintrags
+ */
+void fillLogEntry(const SensorSnapshot* snapshot, LogEntry* entry);
+
+/**
+ * @brief Schreibt Einträge aus der Log-Queue auf die SD-Karte.
+ *
+ * Läuft als eigener Scheduler-Task. Schreibt Einträge, bis die Queue leer
+ * ist oder LOG_DRAIN_BUDGET_MS verbraucht sind. Ein Eintrag wird erst
+ * nach erfolgreichem Schreiben entfernt - bei einem Kartenfehler bleibt
+ * er für den nächsten Durchlauf erhalten (kein Verlust, keine Duplikate).
+ */
+void drainLogQueue();
+
+/**
+ * @brief Protokolliert einen Sensor-Snapshot direkt (ohne Queue).
+ *
+ * Schreibt die Werte des übergebenen Snapshots über logData() in die
+ * aktuelle Log-Datei. Liest selbst keine Sensoren aus, damit Log-Datei,
+ * Display und serielle Ausgabe dieselben Werte zeigen.
+ *
+ * @param snapshot Zeiger auf den Snapshot des aktuellen Messzyklus
  * @return true wenn Daten erfolgreich geloggt wurden, false bei Fehlern
  */
-bool logSensorData(float temperature_dht, float humidity, const RTCData* rtc, float tdsValue);
+bool logSensorData(const SensorSnapshot* snapshot);
 
 /**
  * @brief Formatiert einen LogEntry als lesbaren String.
@@ -154,20 +181,40 @@ void formatCSVHeader(char* buffer, int bufferSize);
  * @brief Formatiert einen LogEntry als CSV-Datenzeile.
  *
  * Konvertiert alle LogEntry-Daten in eine standardkonforme
- * CSV-Zeile mit Komma-Trennung.
+ * CSV-Zeile mit Komma-Trennung, passend zu formatCSVHeader().
+ * Heap-frei über csv_formatter.h.
  *
  * @param entry Zeiger auf zu formatierenden LogEntry
- * @param buffer Ausgabepuffer für die CSV-Zeile
+ * @param buffer Ausgabepuffer für die CSV-Zeile (CSV_BUFFER_SIZE Bytes reichen)
  * @param bufferSize Größe des Ausgabepuffers in Bytes
+ * @return Länge der Zeile oder 0 wenn der Puffer zu klein war
+ */
+uint16_t formatCSVEntry(const LogEntry* entry, char* buffer, int bufferSize);
+
+// Binärformat (HSLOG, siehe log_format.h)
+/**
+ * @brief Schreibt Dateikopf, Schema und Kopf-CRC einer HSLOG-Datei.
+ *
+ * @param file Geöffnete, leere Datei
+ * @param createdEpoch Erstellungszeit (Unix-Zeit, UTC)
+ * @return true wenn alle Bytes geschrieben wurden
+ */
+bool writeBinaryFileHeader(File& file, uint32_t createdEpoch);
+
+/**
+ * @brief Wandelt einen LogEntry in einen HSLOG-Datensatz um.
+ *
+ * @param entry Log-Eintrag
+ * @param record Ausgabe des Datensatzes
  */
-void formatCSVEntry(const LogEntry* entry, char* buffer, int bufferSize);
+void packLogRecord(const LogEntry* entry, HsLogRecord* record);
 
 // Hilfsfunktionen
 /**
  * @brief Generiert einen eindeutigen Dateinamen für Log-Dateien.
  *
  * Erstellt automatisch einen Dateinamen basierend auf aktuellem
- * Datum und Uhrzeit im Format "LOG-YYYY-MM-DD-HHMM.csv".
+ * Datum und Uhrzeit im 8.3-Format "MMDDhhmm.CSV" (bzw. ".HSL" im Binärformat).
  *
  * @param filename Buffer für den generierten Dateinamen
  * @param filenameSize Größe des Filename-Buffers in Bytes
@@ -0,0 +1,182 @@
+/*
+ * Implementierung des DHT-Treibers
+ */
+
+#include "dht_driver.h"
+#include <Arduino.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+// Startimpuls: DHT11 mindestens 18 ms, DHT22 mindestens 1 ms
+static const unsigned long DHT_START_LOW_MS = (DHT_SENSOR_TYPE == 22) ? 2 : 20;
+// Abstand zwischen zwei Abfragen (Sensorlimit)
+static const unsigned long DHT_MIN_INTERVAL_MS = (DHT_SENSOR_TYPE == 22) ? 2000 : 1000;
+// Ein Frame dauert ca. 4-5 ms
+static const unsigned long DHT_RECEIVE_TIMEOUT_MS = 10;
+
+// Fallende Flanken: Antwort, 40 Datenbits, Abschluss-Low
+static const uint8_t DHT_EDGE_COUNT = 42;
+// Flankenabstand 0-Bit ca. 78 us (50 + 28), 1-Bit ca. 120 us (50 + 70)
+static const uint8_t DHT_BIT_THRESHOLD_US = 100;
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+enum DhtState {
+  DHT_STATE_IDLE,
+  DHT_STATE_START,
+  DHT_STATE_RECEIVING
+};
+
+static bool dhtActive = false;
+static DhtState dhtState = DHT_STATE_IDLE;
+static unsigned long dhtStateTime = 0;
+static unsigned long dhtLastRequest = 0;
+
+// Von der ISR geschrieben
+static volatile uint8_t dhtEdges = 0;
+static volatile uint8_t dhtData[5];
+static volatile unsigned long dhtLastEdgeUs = 0;
+
+static DhtReading dhtReading = {0, 0, 0, false};
+static DhtStats dhtStats = {0, 0, 0};
+
+// ==============================================
+// FLANKEN-INTERRUPT
+// ==============================================
+
+// DHT_SENSOR_PIN = Digitalpin 2 = PE4 = INT4
+ISR(INT4_vect) {
+  unsigned long now = micros();
+  uint8_t edge = dhtEdges;
+
+  // Ab der dritten Flanke schließt jede Flanke ein Datenbit ab
+  if (edge >= 2) {
+    uint8_t bit = edge - 2;
+    uint8_t value = (now - dhtLastEdgeUs) > DHT_BIT_THRESHOLD_US ? 1 : 0;
+    dhtData[bit >> 3] = (dhtData[bit >> 3] << 1) | value;
+  }
+
+  dhtLastEdgeUs = now;
+  dhtEdges = ++edge;
+  if (edge >= DHT_EDGE_COUNT) {
+    EIMSK &= ~_BV(INT4);  // Frame vollständig
+  }
+}
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static void startReceiving() {
+  for (uint8_t i = 0; i < 5; i++) dhtData[i] = 0;
+  dhtEdges = 0;
+
+  // Interrupt vor dem Loslassen der Leitung freigeben (steigende Flanke
+  // beim Loslassen löst nicht aus), altes Flag verwerfen
+  EIFR = _BV(INTF4);
+  EIMSK |= _BV(INT4);
+  pinMode(DHT_SENSOR_PIN, INPUT_PULLUP);
+}
+
+static void decodeFrame() {
+  uint8_t data[5];
+  for (uint8_t i = 0; i < 5; i++) data[i] = dhtData[i];
+
+  if ((uint8_t)(data[0] + data[1] + data[2] + data[3]) != data[4]) {
+    dhtStats.checksumErrors++;
+    return;
+  }
+
+  int16_t temperature;
+  uint16_t humidity;
+  if (DHT_SENSOR_TYPE == 22) {
+    humidity = ((uint16_t)data[0] << 8) | data[1];
+    temperature = (int16_t)(((uint16_t)(data[2] & 0x7F) << 8) | data[3]);
+    if (data[2] & 0x80) temperature = -temperature;
+  } else {
+    humidity = data[0] * 10 + data[1];
+    temperature = (int16_t)(data[2] * 10 + (data[3] & 0x0F));
+    if (data[3] & 0x80) temperature = -temperature;
+  }
+
+  dhtReading.temperatureDeci = temperature;
+  dhtReading.humidityDeci = humidity;
+  dhtReading.timestamp = millis();
+  dhtReading.valid = true;
+  dhtStats.framesOk++;
+}
+
+// ==============================================
+// STEUERUNG
+// ==============================================
+
+void dhtBegin() {
+  DEBUG_PRINTLN(F("Starte DHT-Treiber (INT4)..."));
+
+  EIMSK &= ~_BV(INT4);
+  EICRB = (EICRB & ~(_BV(ISC41) | _BV(ISC40))) | _BV(ISC41);  // Fallende Flanke
+  pinMode(DHT_SENSOR_PIN, INPUT_PULLUP);
+
+  dhtState = DHT_STATE_IDLE;
+  dhtLastRequest = millis() - DHT_MIN_INTERVAL_MS;  // Erste Abfrage sofort
+  dhtActive = true;
+}
+
+void dhtUpdate() {
+  if (!dhtActive) return;  // Noch in der Aufwärmphase
+  unsigned long now = millis();
+
+  switch (dhtState) {
+    case DHT_STATE_IDLE:
+      if (now - dhtLastRequest >= DHT_MIN_INTERVAL_MS) {
+        dhtLastRequest = now;
+        pinMode(DHT_SENSOR_PIN, OUTPUT);
+        digitalWrite(DHT_SENSOR_PIN, LOW);
+        dhtState = DHT_STATE_START;
+        dhtStateTime = now;
+      }
+      break;
+
+    case DHT_STATE_START:
+      if (now - dhtStateTime >= DHT_START_LOW_MS) {
+        startReceiving();
+        dhtState = DHT_STATE_RECEIVING;
+        dhtStateTime = now;
+      }
+      break;
+
+    case DHT_STATE_RECEIVING:
+      if (dhtEdges >= DHT_EDGE_COUNT) {
+        decodeFrame();
+        dhtState = DHT_STATE_IDLE;
+      } else if (now - dhtStateTime > DHT_RECEIVE_TIMEOUT_MS) {
+        EIMSK &= ~_BV(INT4);
+        dhtStats.timeouts++;
+        dhtState = DHT_STATE_IDLE;
+      }
+      break;
+  }
+}
+
+// ==============================================
+// WERTE AUSLESEN
+// ==============================================
+
+bool dhtGetReading(DhtReading* out) {
+  if (!out) return false;
+  *out = dhtReading;
+  return dhtReading.valid && millis() - dhtReading.timestamp <= DHT_STALE_MS;
+}
+
+unsigned long dhtReadingAge() {
+  if (!dhtReading.valid) return 0xFFFFFFFFUL;
+  return millis() - dhtReading.timestamp;
+}
+
+void dhtGetStats(DhtStats* out) {
+  if (out) *out = dhtStats;
+}
@@ -0,0 +1,85 @@
+/*
+ * DHT-Treiber für das Umweltkontrollsystem
+ * Nicht-blockierende Abfrage von DHT11/DHT22 an DHT_SENSOR_PIN (INT4)
+ *
+ * Die Hauptschleife erzeugt nur den Startimpuls (über millis(), ohne
+ * delay). Die 40 Datenbits werden im INT4-Interrupt über die Abstände
+ * der fallenden Flanken dekodiert - Interrupts bleiben dabei freigegeben,
+ * der Geigerzähler und der ADC-Scanner laufen ungestört weiter.
+ * Abfragen sind auf das Sensorlimit (DHT11: 1 Hz, DHT22: 0,5 Hz)
+ * begrenzt; Leser erhalten immer den letzten gültigen Wert samt Alter.
+ */
+
+#ifndef DHT_DRIVER_H
+#define DHT_DRIVER_H
+
+#include "config.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Letzter gültiger Messwert des DHT-Sensors.
+ */
+struct DhtReading {
+  int16_t temperatureDeci;   ///< Temperatur in 1/10 °C
+  uint16_t humidityDeci;     ///< Relative Luftfeuchtigkeit in 1/10 %
+  unsigned long timestamp;   ///< millis()-Zeitpunkt der Messung
+  bool valid;                ///< true sobald mindestens ein Frame gültig war
+};
+
+/**
+ * @brief Zähler zur Diagnose der Busübertragung.
+ */
+struct DhtStats {
+  unsigned long framesOk;        ///< Gültige Frames
+  unsigned long checksumErrors;  ///< Frames mit falscher Prüfsumme
+  unsigned long timeouts;        ///< Abfragen ohne vollständige Antwort
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Initialisiert den Treiber und konfiguriert INT4.
+ *
+ * Die erste Abfrage startet beim nächsten dhtUpdate(). Der Sensor
+ * sollte zu diesem Zeitpunkt bereits aufgewärmt sein (ca. 1-2 s).
+ */
+void dhtBegin();
+
+/**
+ * @brief Treibt die Zustandsmaschine voran (aus der Hauptschleife aufrufen).
+ *
+ * Prüft nur millis() und ein Fertig-Flag; Startimpuls, Empfang und
+ * Auswertung laufen über mehrere Aufrufe verteilt.
+ */
+void dhtUpdate();
+
+/**
+ * @brief Liefert den zwischengespeicherten Messwert.
+ *
+ * Löst keine Busübertragung aus.
+ *
+ * @param out Ausgabe des letzten gültigen Messwerts
+ * @return true wenn ein Wert vorliegt, der jünger als DHT_STALE_MS ist
+ */
+bool dhtGetReading(DhtReading* out);
+
+/**
+ * @brief Alter des letzten gültigen Messwerts.
+ *
+ * @return Millisekunden seit der letzten gültigen Messung, 0xFFFFFFFF wenn noch keine
+ */
+unsigned long dhtReadingAge();
+
+/**
+ * @brief Liefert die Übertragungsstatistik.
+ *
+ * @param out Ausgabe der Zähler
+ */
+void dhtGetStats(DhtStats* out);
+
+#endif // DHT_DRIVER_H
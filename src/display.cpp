@@ -6,35 +6,142 @@
 #include "display.h"
 #include "sensors.h"
 #include "rtc_module.h"
+#include "sensor_snapshot.h"
+#include "twi_queue.h"
+#include "trace.h"
+#include "perf_probe.h"
+#include <util/crc16.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+// SSD1306-Kommandos
+static const uint8_t SSD1306_COLUMNADDR = 0x21;
+static const uint8_t SSD1306_PAGEADDR = 0x22;
+
+// Steuerbytes: folgende Bytes sind Kommandos bzw. Bilddaten
+static const uint8_t OLED_CONTROL_COMMAND = 0x00;
+static const uint8_t OLED_CONTROL_DATA = 0x40;
+
+// Initialisierung für 128x64 mit interner Ladungspumpe
+static const uint8_t OLED_INIT_SEQUENCE[] PROGMEM = {
+  0xAE,         // Display aus
+  0xD5, 0x80,   // Taktteiler
+  0xA8, 0x3F,   // Multiplex 64
+  0xD3, 0x00,   // Kein Versatz
+  0x40,         // Startzeile 0
+  0x8D, 0x14,   // Ladungspumpe an
+  0x20, 0x00,   // Horizontale Adressierung
+  0xA1,         // Segmente gespiegelt
+  0xC8,         // Zeilen von unten nach oben
+  0xDA, 0x12,   // COM-Pins
+  0x81, 0xCF,   // Kontrast
+  0xD9, 0xF1,   // Vorladezeit
+  0xDB, 0x40,   // VCOMH
+  0xA4,         // Anzeige aus dem RAM
+  0xA6,         // Nicht invertiert
+  0x2E,         // Scrollen aus
+  0xAF          // Display an
+};
 
 // ==============================================
 // GLOBALE VARIABLEN
 // ==============================================
 
-Adafruit_SSD1306 display(OLED_SCREEN_WIDTH, OLED_SCREEN_HEIGHT, &Wire, OLED_RESET_PIN);
+static const uint8_t OLED_PAGES = OLED_SCREEN_HEIGHT / 8;
+static const uint8_t OLED_SEGMENTS = OLED_SCREEN_WIDTH / OLED_SEGMENT_WIDTH;
+
+OledDisplay display;
 
 static uint8_t currentPage = 0;
-static unsigned long lastPageChange = 0;
+
+// Tile-Puffer: je eine SSD1306-Page (128 Spalten x 8 Pixel). Während
+// ein Tile übertragen wird, zeichnet die Seite bereits in das nächste.
+static uint8_t tileBuffers[OLED_TILE_BUFFERS][OLED_SCREEN_WIDTH];
+static uint8_t tileIndex = 0;     // Aktueller Puffer
+static uint8_t tilePage = 0;      // Page, in die gerade gezeichnet wird
+
+// Laufendes Bild: wird über mehrere Task-Durchläufe gezeichnet, sobald
+// jeweils ein Tile-Puffer frei ist (NULL = kein Bild in Arbeit)
+static void (*frameDrawPage)() = NULL;
+static unsigned long frameRenderUs = 0;   // Zeichenzeit des laufenden Bilds
+static unsigned long lastFrameMs = 0;     // Start des letzten Bilds
+static bool frameStarted = false;         // Mindestens ein Bild begonnen
+
+// Änderungserkennung: CRC-16 je Segment, Stand der letzten Übertragung
+static uint16_t segmentCrc[OLED_PAGES][OLED_SEGMENTS];
+static uint8_t flushesUntilFullRefresh = 0;  // 0 = nächstes Bild komplett
+static bool fullRefresh = false;             // Gilt für das laufende Bild
+static bool frameFailed = false;
+static DisplayStats displayStats = {0, 0, 0, 0, 0, 0};
+
+// Anfragen je Tile-Puffer: Adressfenster setzen, dann Bilddaten aus dem Puffer
+static uint8_t pageCommands[OLED_TILE_BUFFERS][6];
+static TwiRequest commandRequests[OLED_TILE_BUFFERS];
+static TwiRequest dataRequests[OLED_TILE_BUFFERS];
+static bool tileSubmitted[OLED_TILE_BUFFERS];
+
+// ==============================================
+// SSD1306-TREIBER
+// ==============================================
+
+OledDisplay::OledDisplay() : Adafruit_GFX(OLED_SCREEN_WIDTH, OLED_SCREEN_HEIGHT) {
+}
+
+bool OledDisplay::begin(uint8_t address) {
+  uint8_t sequence[sizeof(OLED_INIT_SEQUENCE)];
+  memcpy_P(sequence, OLED_INIT_SEQUENCE, sizeof(sequence));
+
+  twiBegin();
+  TwiRequest request = { address, TWI_FLAG_FAST | TWI_FLAG_PREFIX, OLED_CONTROL_COMMAND,
+                         sequence, sizeof(sequence), NULL, 0, NULL, TWI_STATUS_IDLE, 0 };
+  if (!twiTransfer(&request, false)) return false;
+
+  // Display-RAM ist nach dem Einschalten undefiniert: erstes Bild komplett
+  flushesUntilFullRefresh = 0;
+  return true;
+}
+
+void OledDisplay::drawPixel(int16_t x, int16_t y, uint16_t color) {
+  // Pixel außerhalb des aktuellen Tiles werden in einem anderen Durchlauf gezeichnet
+  if (x < 0 || x >= OLED_SCREEN_WIDTH || (y >> 3) != tilePage || y < 0) return;
+
+  uint8_t* cell = &tileBuffers[tileIndex][x];
+  uint8_t mask = 1 << (y & 7);
+  switch (color) {
+    case SSD1306_WHITE: *cell |= mask; break;
+    case SSD1306_BLACK: *cell &= ~mask; break;
+    case SSD1306_INVERSE: *cell ^= mask; break;
+  }
+}
+
+void OledDisplay::clearDisplay() {
+  memset(tileBuffers[tileIndex], 0, OLED_SCREEN_WIDTH);
+}
+
+uint8_t* OledDisplay::getBuffer() {
+  return tileBuffers[tileIndex];
+}
+
+uint8_t OledDisplay::getTilePage() const {
+  return tilePage;
+}
 
 // ==============================================
 // DISPLAY GRUNDFUNKTIONEN
 // ==============================================
 
 bool initDisplay() {
-  DEBUG_PRINTLN(F("Initialisiere OLED Display..."));
+  TRACE(DISPLAY_INIT);
   
   // SSD1306 Display initialisieren
-  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_I2C_ADDRESS)) {
-    DEBUG_PRINTLN(F("FEHLER: SSD1306 OLED nicht gefunden!"));
-    DEBUG_PRINTLN(F("Prüfe I2C Verkabelung:"));
-    DEBUG_PRINTLN(F("- VCC → 3.3V oder 5V"));
-    DEBUG_PRINTLN(F("- GND → GND"));
-    DEBUG_PRINTLN(F("- SDA → Pin 20 (Arduino Mega)"));
-    DEBUG_PRINTLN(F("- SCL → Pin 21 (Arduino Mega)"));
+  if (!display.begin(OLED_I2C_ADDRESS)) {
+    TRACE(DISPLAY_NOT_FOUND, OLED_I2C_ADDRESS);
     return false;
   }
    
-  DEBUG_PRINTLN(F("OLED Display erfolgreich initialisiert"));
+  TRACE(DISPLAY_READY);
   return true;
 }
 
@@ -43,31 +150,225 @@ void clearDisplay() {
   display.setCursor(0, 0);
 }
 
+// ==============================================
+// INKREMENTELLE ÜBERTRAGUNG
+// ==============================================
+
+static uint16_t segmentChecksum(const uint8_t* data) {
+  uint16_t crc = 0xFFFF;
+  for (uint8_t i = 0; i < OLED_SEGMENT_WIDTH; i++) {
+    crc = _crc_ccitt_update(crc, data[i]);
+  }
+  return crc;
+}
+
+// Reiht Adressfenster und Bilddaten der Spalten firstColumn..lastColumn des aktuellen Tiles ein
+static bool submitTileRange(uint8_t firstColumn, uint8_t lastColumn) {
+  uint8_t* commands = pageCommands[tileIndex];
+  commands[0] = SSD1306_COLUMNADDR;
+  commands[1] = firstColumn;
+  commands[2] = lastColumn;
+  commands[3] = SSD1306_PAGEADDR;
+  commands[4] = tilePage;
+  commands[5] = tilePage;
+
+  TwiRequest* command = &commandRequests[tileIndex];
+  command->address = OLED_I2C_ADDRESS;
+  command->flags = TWI_FLAG_FAST | TWI_FLAG_PREFIX;
+  command->prefix = OLED_CONTROL_COMMAND;
+  command->writeData = commands;
+  command->writeLength = 6;
+
+  uint8_t count = lastColumn - firstColumn + 1;
+  TwiRequest* pixels = &dataRequests[tileIndex];
+  pixels->address = OLED_I2C_ADDRESS;
+  pixels->flags = TWI_FLAG_FAST | TWI_FLAG_PREFIX | TWI_FLAG_CHUNKED;
+  pixels->prefix = OLED_CONTROL_DATA;
+  pixels->writeData = tileBuffers[tileIndex] + firstColumn;
+  pixels->writeLength = count;
+
+  // Reihenfolge bleibt erhalten: beide in der Queue normaler Priorität
+  if (!twiSubmit(command, false)) return false;
+  tileSubmitted[tileIndex] = true;
+  if (!twiSubmit(pixels, false)) return false;
+
+  uint8_t chunks = (count + TWI_CHUNK_SIZE - 2) / (TWI_CHUNK_SIZE - 1);
+  displayStats.bytesSent += 7 + count + chunks;
+  return true;
+}
+
+static bool isTileBufferBusy(uint8_t index) {
+  return tileSubmitted[index] &&
+         (commandRequests[index].status == TWI_STATUS_PENDING ||
+          dataRequests[index].status == TWI_STATUS_PENDING);
+}
+
+// Gibt den Tile-Puffer frei und wertet seine letzte Übertragung aus.
+// Wartet nie: false, solange der Puffer noch gesendet wird.
+static bool releaseTileBuffer(uint8_t index) {
+  if (!tileSubmitted[index]) return true;
+  if (isTileBufferBusy(index)) return false;
+  if (commandRequests[index].status != TWI_STATUS_DONE ||
+      dataRequests[index].status != TWI_STATUS_DONE) {
+    frameFailed = true;
+  }
+  tileSubmitted[index] = false;
+  return true;
+}
+
+bool isDisplayFlushPending() {
+  if (frameDrawPage != NULL) return true;
+  for (uint8_t index = 0; index < OLED_TILE_BUFFERS; index++) {
+    if (isTileBufferBusy(index)) return true;
+  }
+  return false;
+}
+
+void flushDisplay() {
+  const uint8_t* tile = tileBuffers[tileIndex];
+  uint16_t crc[OLED_SEGMENTS];
+  int8_t firstDirty = -1;
+  int8_t lastDirty = -1;
+
+  for (uint8_t segment = 0; segment < OLED_SEGMENTS; segment++) {
+    crc[segment] = segmentChecksum(tile + segment * OLED_SEGMENT_WIDTH);
+    if (fullRefresh || crc[segment] != segmentCrc[tilePage][segment]) {
+      if (firstDirty < 0) firstDirty = segment;
+      lastDirty = segment;
+    }
+  }
+  if (firstDirty < 0) return;
+
+  uint8_t firstColumn = firstDirty * OLED_SEGMENT_WIDTH;
+  uint8_t lastColumn = (lastDirty + 1) * OLED_SEGMENT_WIDTH - 1;
+  if (!submitTileRange(firstColumn, lastColumn)) {
+    // Queue voll: Stand des Displays unklar
+    frameFailed = true;
+    return;
+  }
+
+  // Beim Einreihen als aktuell merken; ein Fehler erzwingt beim
+  // nächsten Bild ohnehin eine vollständige Übertragung
+  for (uint8_t segment = firstDirty; segment <= lastDirty; segment++) {
+    segmentCrc[tilePage][segment] = crc[segment];
+  }
+}
+
+// Picture-Loop: zeichnet die Seite einmal pro Tile, jeweils nur die Pixel
+// dieser Page. Ist der nächste Tile-Puffer noch in Übertragung, endet der
+// Durchlauf; updateDisplay() setzt im nächsten Task-Durchlauf an dieser
+// Page fort.
+static void continueFrame() {
+  unsigned long start = micros();
+  while (tilePage < OLED_PAGES) {
+    uint8_t index = tilePage % OLED_TILE_BUFFERS;
+    if (!releaseTileBuffer(index)) break;
+    tileIndex = index;
+    frameDrawPage();  // Seite ruft clearDisplay() ... flushDisplay() auf
+    tilePage++;
+  }
+  frameRenderUs += micros() - start;
+  if (tilePage < OLED_PAGES) return;
+
+  tilePage = 0;
+  frameDrawPage = NULL;
+  displayStats.frames++;
+  if (fullRefresh) {
+    displayStats.fullRefreshes++;
+    flushesUntilFullRefresh = OLED_FULL_REFRESH_FLUSHES - 1;
+  } else {
+    flushesUntilFullRefresh--;
+  }
+  if (frameRenderUs > displayStats.maxFrameUs) displayStats.maxFrameUs = frameRenderUs;
+}
+
+// Beginnt ein neues Bild (alle Tile-Puffer sind frei, siehe updateDisplay())
+static void renderPage(void (*drawPage)()) {
+  // Fehler der vorherigen Übertragung erzwingen ein vollständiges Bild
+  for (uint8_t index = 0; index < OLED_TILE_BUFFERS; index++) {
+    releaseTileBuffer(index);
+  }
+  if (frameFailed) {
+    displayStats.errors++;
+    flushesUntilFullRefresh = 0;
+    frameFailed = false;
+  }
+  fullRefresh = (flushesUntilFullRefresh == 0);
+
+  frameDrawPage = drawPage;
+  frameRenderUs = 0;
+  tilePage = 0;
+  continueFrame();
+}
+
+void getDisplayStats(DisplayStats* stats) {
+  *stats = displayStats;
+}
+
+void printDisplayStats() {
+  DEBUG_PRINTLN(F("=== OLED ==="));
+  DEBUG_PRINT(F("Bilder: "));
+  DEBUG_PRINT(displayStats.frames);
+  DEBUG_PRINT(F(" (komplett: "));
+  DEBUG_PRINT(displayStats.fullRefreshes);
+  DEBUG_PRINT(F("), Bytes: "));
+  DEBUG_PRINT(displayStats.bytesSent);
+  DEBUG_PRINT(F(", Fehler: "));
+  DEBUG_PRINT(displayStats.errors);
+  DEBUG_PRINT(F(", ausgelassen: "));
+  DEBUG_PRINT(displayStats.skipped);
+  DEBUG_PRINT(F(", max. Dauer us: "));
+  DEBUG_PRINTLN(displayStats.maxFrameUs);
+}
+
 void updateDisplay() {
-  // Seite alle 2 Sekunden wechseln
-  if (millis() - lastPageChange >= OLED_UPDATE_INTERVAL) {
-    nextDisplayPage();
-    lastPageChange = millis();
+  PERF_SCOPE(DISPLAY);
+  // Wird vom Scheduler alle DISPLAY_TASK_PERIOD ms aufgerufen und wartet
+  // nie auf den Bus: ein angefangenes Bild wird fortgesetzt, ein neues
+  // beginnt alle OLED_UPDATE_INTERVAL ms, sobald die Tiles gesendet sind.
+  unsigned long now = millis();
+  bool due = !frameStarted || now - lastFrameMs >= OLED_UPDATE_INTERVAL;
+
+  if (frameDrawPage != NULL) {
+    if (due) {
+      // Bild dauert länger als das Intervall: dieses Update auslassen
+      displayStats.skipped++;
+      lastFrameMs = now;
+    }
+    continueFrame();
+    return;
   }
+  // Neues Bild erst, wenn auch die letzten Tiles gesendet sind
+  if (!due || isDisplayFlushPending()) return;
+
+  lastFrameMs = now;
+  frameStarted = true;
+  nextDisplayPage();
 }
 
 // ==============================================
 // DISPLAY SEITEN
 // ==============================================
 
+// Alle Seiten zeigen den Snapshot des letzten Messzyklus an und
+// lesen keine Sensoren selbst aus. Sie werden über renderPage() einmal
+// pro Tile aufgerufen und müssen daher bei jedem Aufruf dasselbe zeichnen.
+// Läuft ein Bild über mehrere Task-Durchläufe und kommt dazwischen ein
+// neuer Snapshot, zeigen die restlichen Pages schon die neuen Werte; das
+// nächste Bild gleicht das aus.
+
 void displayPage1_Status() {
   clearDisplay();
   displayTitle("1. SYSTEM STATUS");
   
-  // Aktuelle Zeit von RTC abrufen mit Debug
-  RTCData currentTime;
+  // Zeit aus dem Snapshot (kein eigener RTC-Zugriff)
+  const SensorSnapshot* snapshot = getSensorSnapshot();
+  const RTCData* currentTime = &snapshot->rtc;
   char timeStr[20];
-  bool rtcSuccess = readRTCData(&currentTime);
-  
   
-  if (rtcSuccess && currentTime.isValid) {
+  if (hasSensorSnapshot() && currentTime->isValid) {
     snprintf(timeStr, sizeof(timeStr), "Zeit: %02d:%02d:%02d", 
-             currentTime.hour, currentTime.minute, currentTime.second);
+             currentTime->hour, currentTime->minute, currentTime->second);
   } else {
     strcpy(timeStr, "Zeit: --:--:--");
   }
@@ -78,50 +379,62 @@ void displayPage1_Status() {
   displayText(2, "SD: OK"); 
   displayText(3, "Sensoren: 6/7");
   
-  display.display();
+  flushDisplay();
 }
 
 void displayPage2_Temperature() {
   clearDisplay();
   displayTitle("2. TEMPERATUR");
   
-  // DHT11 Werte lesen (einheitliche Abstände)
-  float temperature, humidity;
-  if (readDHTSensor(&temperature, &humidity)) {
-    displayValue(0, "Temp:", temperature, "C");
-    displayValue(1, "Luft:", humidity, "%");
+  // DHT11 Werte aus dem Snapshot (einheitliche Abstände)
+  const SensorSnapshot* snapshot = getSensorSnapshot();
+  if (!hasSensorSnapshot()) {
+    displayText(0, "Warte auf Daten...");
+  } else if (snapshot->dhtValid) {
+    displayValue(0, "Temp:", snapshot->temperature, "C");
+    displayValue(1, "Luft:", snapshot->humidity, "%");
   } else {
     displayText(0, "DHT11: FEHLER");
   }
   
  
   
-  display.display();
+  flushDisplay();
 }
 
 void displayPage3_Environment() {
   clearDisplay();
   displayTitle("3. UMGEBUNG");
   
+  const SensorSnapshot* snapshot = getSensorSnapshot();
+  if (!hasSensorSnapshot()) {
+    displayText(0, "Warte auf Daten...");
+    flushDisplay();
+    return;
+  }
+  
   // Lichtsensor (einheitliche Abstände)
-  float lightPercent = getLightPercent();
-  displayValue(0, "Licht:", lightPercent, "%");
+  displayValue(0, "Licht:", snapshot->lightPercent, "%");
   
   // Radioaktivität
-  // Radioaktivität: Wert aus neuer Logik holen
-  int radiation = getRadiationCountAndReset();
-  displayValue(1, "Radiat:", radiation, "cps");
+  displayValue(1, "Radiat:", snapshot->radiationCPS, "cps");
   
-  display.display();
+  flushDisplay();
 }
 
 void displayPage4_Gas() {
   clearDisplay();
   displayTitle("4. GAS-SENSOREN");
   
+  const SensorSnapshot* snapshot = getSensorSnapshot();
+  if (!hasSensorSnapshot()) {
+    displayText(0, "Warte auf Daten...");
+    flushDisplay();
+    return;
+  }
+  
   // 3 wichtigste Gas-Sensoren (einheitliche Abstände)
-  int gasSensors[9];
-  readAllGasSensors(gasSensors);
+  const int* gasSensors = snapshot->gasSensors;
   
   displayValue(0, "MQ2:", gasSensors[0], "");    // Methan/LPG
   displayValue(1, "MQ7:", gasSensors[5], "");    // CO
@@ -129,27 +442,31 @@ void displayPage4_Gas() {
   
   // Durchschnitt aller Sensoren
   int average = 0;
-  for (int i = 0; i < 9; i++) {
+  for (int i = 0; i < MAX_GAS_SENSORS; i++) {
     average += gasSensors[i];
   }
-  average /= 9;
+  average /= MAX_GAS_SENSORS;
   displayValue(3, "Avg:", average, "");
   
-  display.display();
+  flushDisplay();
 }
 
 void displayPage5_Audio() {
   clearDisplay();
   displayTitle("5. MIKROFONE");
   
-  // Mikrofon-Werte lesen (einheitliche Abstände)
-  int micValues[2];
-  readAllMicrophones(micValues);
+  const SensorSnapshot* snapshot = getSensorSnapshot();
+  if (!hasSensorSnapshot()) {
+    displayText(0, "Warte auf Daten...");
+    flushDisplay();
+    return;
+  }
   
-  displayValue(0, "Klein:", micValues[0], "");
-  displayValue(1, "Gross:", micValues[1], "");
+  // Mikrofon-Werte aus dem Snapshot (einheitliche Abstände)
+  displayValue(0, "Klein:", snapshot->microphones[0], "");
+  displayValue(1, "Gross:", snapshot->microphones[1], "");
   
-  display.display();
+  flushDisplay();
 }
 
 
@@ -180,15 +497,16 @@ void displayText(int line, const char* text) {
 }
 
 void nextDisplayPage() {
+  if (frameDrawPage != NULL) return;   // Laufendes Bild erst fertig zeichnen
   currentPage++;
   if (currentPage > 5) currentPage = 0;
   
   switch (currentPage) {
-    case 0: displayPage1_Status(); break;
-    case 1: displayPage2_Temperature(); break;
-    case 2: displayPage3_Environment(); break;
-    case 3: displayPage4_Gas(); break;
-    case 4: displayPage5_Audio(); break;
+    case 0: renderPage(displayPage1_Status); break;
+    case 1: renderPage(displayPage2_Temperature); break;
+    case 2: renderPage(displayPage3_Environment); break;
+    case 3: renderPage(displayPage4_Gas); break;
+    case 4: renderPage(displayPage5_Audio); break;
 
   }
 }
@@ -1,6 +1,22 @@
 /*
  * OLED Display Modul für das Umweltkontrollsystem
  * 0,96" SSD1306 128x64 I2C OLED Display
+ *
+ * Kein Framebuffer: Die Seiten werden im Picture-Loop-Verfahren
+ * gezeichnet. nextDisplayPage() ruft die Seitenfunktion einmal pro
+ * SSD1306-Page (8 Pixel hohe Zeile) auf; drawPixel() übernimmt jeweils
+ * nur die Pixel dieser Page in einen 128-Byte-Tile-Puffer, und
+ * flushDisplay() überträgt das Tile. Mit OLED_TILE_BUFFERS = 2 wird ein
+ * Tile gesendet, während die Seite schon das nächste zeichnet
+ * (256 statt 1024 Byte RAM). Ist kein Tile-Puffer frei, endet der
+ * Task-Durchlauf; das Bild wird im nächsten Durchlauf an dieser Page
+ * fortgesetzt, statt auf den Bus zu warten.
+ * Übertragen werden nur geänderte Bereiche: Jedes Tile ist in Segmente
+ * zu OLED_SEGMENT_WIDTH Spalten geteilt, deren CRC-16 mit dem Stand der
+ * letzten Übertragung verglichen wird. Nur der Spaltenbereich vom
+ * ersten bis zum letzten geänderten Segment wird als Anfrage in die
+ * TWI-Queue gestellt (400 kHz, in Teilen zu TWI_CHUNK_SIZE Bytes);
+ * RTC-Zugriffe werden zwischen den Teilen vorgezogen.
  */
 
 #ifndef DISPLAY_H
@@ -8,14 +24,52 @@
 
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
-#include <Adafruit_SSD1306.h>
 #include "config.h"
 
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+const uint16_t SSD1306_BLACK = 0;         // Pixel aus
+const uint16_t SSD1306_WHITE = 1;         // Pixel an
+const uint16_t SSD1306_INVERSE = 2;       // Pixel umschalten
+
 // ==============================================
 // DISPLAY INITIALISIERUNG
 // ==============================================
 
-extern Adafruit_SSD1306 display;
+/**
+ * @brief SSD1306-Treiber auf Basis der TWI-Queue.
+ *
+ * Zeichnet nur in das aktuelle Tile (eine Page); die Übertragung
+ * übernimmt flushDisplay().
+ */
+class OledDisplay : public Adafruit_GFX {
+public:
+  OledDisplay();
+
+  bool begin(uint8_t address);   // Init-Sequenz senden (blockierend)
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+  void clearDisplay();            // Aktuelles Tile löschen
+  uint8_t* getBuffer();           // Aktuelles Tile (OLED_SCREEN_WIDTH Bytes)
+  uint8_t getTilePage() const;    // Page des aktuellen Tiles (0-7)
+};
+
+extern OledDisplay display;
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+// Zähler der OLED-Übertragungen
+struct DisplayStats {
+  unsigned long frames;         // Gezeichnete Bilder (je 8 Tiles)
+  unsigned long fullRefreshes;  // Davon vollständig übertragen
+  unsigned long bytesSent;      // Eingereihte I2C-Bytes (inkl. Steuerbytes)
+  unsigned long errors;         // Fehlgeschlagene I2C-Übertragungen
+  unsigned long skipped;        // Ausgelassene Updates (voriges Bild lief noch)
+  unsigned long maxFrameUs;     // Längste Zeichenzeit eines Bildes (über alle Durchläufe)
+};
 
 // ==============================================
 // FUNKTIONS-DEKLARATIONEN
@@ -25,6 +79,10 @@ extern Adafruit_SSD1306 display;
 bool initDisplay();
 void clearDisplay();
 void updateDisplay();
+void flushDisplay();             // Geänderte Bereiche des Tiles zur Übertragung einreihen
+bool isDisplayFlushPending();     // Wird noch gezeichnet oder ein Tile gesendet?
+void getDisplayStats(DisplayStats* stats);
+void printDisplayStats();
 
 // Display Seiten (rotieren alle 2 Sekunden)
 void displayPage1_Status();      // System Status + Zeit
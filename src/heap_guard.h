@@ -0,0 +1,16 @@
+/*
+ * Build-Prüfung: keine Heap-Nutzung und keine String-Formatierung
+ *
+ * Als LETZTES #include in Übersetzungseinheiten des Logging-Pfads
+ * einbinden (csv_formatter, log_writer, data_logger). Jede spätere
+ * Verwendung der vergifteten Bezeichner bricht den Build ab - damit
+ * können weder Arduino-String noch malloc & Co. unbemerkt in den
+ * Logging-Pfad zurückkehren und den Heap über lange Laufzeit fragmentieren.
+ */
+
+#ifndef HEAP_GUARD_H
+#define HEAP_GUARD_H
+
+#pragma GCC poison String malloc calloc realloc free dtostrf sprintf snprintf
+
+#endif // HEAP_GUARD_H
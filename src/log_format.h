@@ -0,0 +1,155 @@
+/*
+ * Binäres Log-Format für das Umweltkontrollsystem (HSLOG)
+ * Gemeinsame Definition für Firmware und Host-Werkzeuge (tools/hslog2csv)
+ *
+ * Dateiaufbau (alle Zahlen little-endian):
+ *   HsLogFileHeader
+ *   fieldCount x HsLogFieldDescriptor     (Schema)
+ *   uint16_t CRC über Header + Schema
+ *   Blöcke: HsLogBlockHeader, blockRecords x HsLogRecord, uint16_t CRC
+ *
+ * Jeder Block enthält genau blockRecords Datensätze. Ein Block ohne
+ * CRC am Dateiende ist unvollständig (Stromausfall oder laufende Messung).
+ * Die Datei ist ohne Arduino-Header übersetzbar.
+ */
+
+#ifndef LOG_FORMAT_H
+#define LOG_FORMAT_H
+
+#include <stdint.h>
+
+#ifdef ARDUINO
+#include <avr/pgmspace.h>
+#include <util/crc16.h>
+#define HSLOG_PROGMEM PROGMEM
+#else
+#define HSLOG_PROGMEM
+#endif
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+#define HSLOG_MAGIC "HSLG"
+#define HSLOG_VERSION 1
+#define HSLOG_BLOCK_MARKER 0x4B42          // "BK"
+#define HSLOG_BLOCK_RECORDS 12             // Datensätze pro CRC-Block
+#define HSLOG_FIELD_NAME_LENGTH 12
+
+// Feldtypen der Schema-Beschreibung
+enum HsLogFieldType {
+  HSLOG_TYPE_U8 = 1,
+  HSLOG_TYPE_U16 = 2,
+  HSLOG_TYPE_I16 = 3,
+  HSLOG_TYPE_U32 = 4
+};
+
+// Bits in HsLogRecord::flags
+#define HSLOG_FLAG_DHT_VALID 0x01
+#define HSLOG_FLAG_RTC_VALID 0x02
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Dateikopf einer HSLOG-Datei.
+ */
+struct __attribute__((packed)) HsLogFileHeader {
+  char magic[4];            ///< "HSLG"
+  uint8_t version;          ///< HSLOG_VERSION
+  uint8_t fieldCount;       ///< Anzahl folgender Felddeskriptoren
+  uint16_t recordSize;      ///< Größe eines Datensatzes in Bytes
+  uint8_t blockRecords;     ///< Datensätze pro Block
+  uint8_t reserved;
+  uint32_t createdEpoch;    ///< Erstellungszeit (Unix-Zeit, UTC)
+};
+
+/**
+ * @brief Beschreibung eines Felds im Datensatz (Schema).
+ *
+ * Wert in physikalischer Einheit = Rohwert / 10^decimals.
+ */
+struct __attribute__((packed)) HsLogFieldDescriptor {
+  char name[HSLOG_FIELD_NAME_LENGTH];  ///< Feldname, nullterminiert falls kürzer
+  uint8_t type;                        ///< HsLogFieldType
+  uint8_t count;                       ///< Anzahl Elemente (Arrays)
+  uint8_t decimals;                    ///< Nachkommastellen des Festkommawerts
+};
+
+/**
+ * @brief Kopf eines CRC-gesicherten Blocks.
+ */
+struct __attribute__((packed)) HsLogBlockHeader {
+  uint16_t marker;          ///< HSLOG_BLOCK_MARKER
+  uint16_t sequence;        ///< Laufende Blocknummer (mit Überlauf)
+};
+
+/**
+ * @brief Ein Messzyklus als Festkomma-Datensatz (39 Bytes).
+ */
+struct __attribute__((packed)) HsLogRecord {
+  uint32_t epoch;           ///< Unix-Zeit (UTC) der Messung
+  uint16_t millis;          ///< Millisekundenanteil (0 wenn unbekannt)
+  int16_t temperature;      ///< Temperatur in 1/10 °C
+  uint16_t humidity;        ///< Luftfeuchtigkeit in 1/10 %
+  uint16_t light;           ///< Lichtsensor-Rohwert (0-1023)
+  uint16_t gas[9];          ///< MQ2, MQ3, MQ4, MQ5, MQ6, MQ7, MQ8, MQ9, MQ135 (0-1023)
+  uint16_t mic[2];          ///< Mikrofon-Pegel (Peak-to-Peak)
+  uint16_t tds;             ///< TDS in ppm (gesättigt bei 65535)
+  uint16_t radiation;       ///< Impulse pro Sekunde in 1/100 (gesättigt bei 65535)
+  uint8_t flags;            ///< HSLOG_FLAG_*
+};
+
+static_assert(sizeof(HsLogFileHeader) == 14, "HsLogFileHeader muss 14 Bytes groß sein");
+static_assert(sizeof(HsLogFieldDescriptor) == 15, "HsLogFieldDescriptor muss 15 Bytes groß sein");
+static_assert(sizeof(HsLogRecord) == 39, "HsLogRecord muss 39 Bytes groß sein");
+
+// ==============================================
+// SCHEMA
+// ==============================================
+
+// Reihenfolge und Typen entsprechen HsLogRecord
+static const HsLogFieldDescriptor HSLOG_FIELDS[] HSLOG_PROGMEM = {
+  { "epoch",       HSLOG_TYPE_U32, 1, 0 },
+  { "millis",      HSLOG_TYPE_U16, 1, 0 },
+  { "temperature", HSLOG_TYPE_I16, 1, 1 },
+  { "humidity",    HSLOG_TYPE_U16, 1, 1 },
+  { "light",       HSLOG_TYPE_U16, 1, 0 },
+  { "gas",         HSLOG_TYPE_U16, 9, 0 },
+  { "mic",         HSLOG_TYPE_U16, 2, 0 },
+  { "tds",         HSLOG_TYPE_U16, 1, 0 },
+  { "radiation",   HSLOG_TYPE_U16, 1, 2 },
+  { "flags",       HSLOG_TYPE_U8,  1, 0 }
+};
+
+#define HSLOG_FIELD_COUNT (sizeof(HSLOG_FIELDS) / sizeof(HSLOG_FIELDS[0]))
+
+// ==============================================
+// PRÜFSUMME
+// ==============================================
+
+/**
+ * @brief CRC-16/CCITT (Polynom 0x1021, Startwert 0xFFFF) fortschreiben.
+ *
+ * @param crc Bisheriger CRC-Wert
+ * @param data Daten
+ * @param length Anzahl Bytes
+ * @return Neuer CRC-Wert
+ */
+static inline uint16_t hslogCrc16(uint16_t crc, const void* data, uint16_t length) {
+  const uint8_t* bytes = (const uint8_t*)data;
+  while (length--) {
+#ifdef ARDUINO
+    crc = _crc_xmodem_update(crc, *bytes++);
+#else
+    crc ^= (uint16_t)(*bytes++) << 8;
+    for (uint8_t i = 0; i < 8; i++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+#endif
+  }
+  return crc;
+}
+
+#endif // LOG_FORMAT_H
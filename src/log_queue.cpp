@@ -0,0 +1,115 @@
+/*
+ * Implementierung der Log-Queue
+ */
+
+#include "log_queue.h"
+#include <Arduino.h>
+
+// Tiefe als Zweierpotenz: Index per Maske statt Division, und die frei
+// laufenden 8-Bit-Indizes bleiben auch beim Überlauf konsistent
+static_assert(LOG_QUEUE_DEPTH >= 2 && LOG_QUEUE_DEPTH <= 128 &&
+              (LOG_QUEUE_DEPTH & (LOG_QUEUE_DEPTH - 1)) == 0,
+              "LOG_QUEUE_DEPTH muss eine Zweierpotenz zwischen 2 und 128 sein");
+
+static const uint8_t LOG_QUEUE_MASK = LOG_QUEUE_DEPTH - 1;
+
+// Verhindert, dass der Compiler Zugriffe auf die Einträge über die
+// Index-Aktualisierung hinweg verschiebt
+#define LOG_QUEUE_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static LogEntry queueEntries[LOG_QUEUE_DEPTH];
+static volatile uint8_t queueHead = 0;   // Nur vom Erzeuger geschrieben
+static volatile uint8_t queueTail = 0;   // Nur vom Verbraucher geschrieben
+
+// Zähler werden nur vom Erzeuger geschrieben
+static LogQueueStats queueStats = { 0, 0, 0, 0, LOG_QUEUE_DEPTH };
+static bool queueOverflowing = false;
+
+// ==============================================
+// ERZEUGER
+// ==============================================
+
+bool logQueuePush(const LogEntry* entry) {
+  uint8_t head = queueHead;
+  uint8_t used = (uint8_t)(head - queueTail);
+
+  if (used >= LOG_QUEUE_DEPTH) {
+    queueStats.dropped++;
+    if (!queueOverflowing) {
+      queueOverflowing = true;
+      queueStats.overflows++;
+    }
+    return false;
+  }
+
+  queueEntries[head & LOG_QUEUE_MASK] = *entry;
+  LOG_QUEUE_BARRIER();
+  queueHead = head + 1;
+
+  queueStats.pushed++;
+  queueOverflowing = false;
+  if (used + 1 > queueStats.highWater) {
+    queueStats.highWater = used + 1;
+  }
+  return true;
+}
+
+// ==============================================
+// VERBRAUCHER
+// ==============================================
+
+const LogEntry* logQueuePeek() {
+  uint8_t tail = queueTail;
+  if (tail == queueHead) {
+    return NULL;
+  }
+  LOG_QUEUE_BARRIER();
+  return &queueEntries[tail & LOG_QUEUE_MASK];
+}
+
+void logQueuePop() {
+  uint8_t tail = queueTail;
+  if (tail == queueHead) {
+    return;
+  }
+  LOG_QUEUE_BARRIER();
+  queueTail = tail + 1;
+}
+
+uint8_t logQueueCount() {
+  return (uint8_t)(queueHead - queueTail);
+}
+
+// ==============================================
+// STATISTIK
+// ==============================================
+
+void logQueueGetStats(LogQueueStats* stats) {
+  // 32-Bit-Zähler können von einer ISR mitten im Kopieren geändert werden
+  noInterrupts();
+  *stats = queueStats;
+  interrupts();
+}
+
+void logQueuePrintStats() {
+  LogQueueStats stats;
+  logQueueGetStats(&stats);
+
+  DEBUG_PRINTLN(F("=== LOG-QUEUE ==="));
+  DEBUG_PRINT(F("Füllstand: "));
+  DEBUG_PRINT(logQueueCount());
+  DEBUG_PRINT(F("/"));
+  DEBUG_PRINT(stats.depth);
+  DEBUG_PRINT(F(", max.: "));
+  DEBUG_PRINT(stats.highWater);
+  DEBUG_PRINT(F(", eingereiht: "));
+  DEBUG_PRINT(stats.pushed);
+  DEBUG_PRINT(F(", verworfen: "));
+  DEBUG_PRINT(stats.dropped);
+  DEBUG_PRINT(F(", Überläufe: "));
+  DEBUG_PRINTLN(stats.overflows);
+}
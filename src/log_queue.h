@@ -0,0 +1,81 @@
+/*
+ * Log-Queue für das Umweltkontrollsystem
+ * Entkoppelt die Messwerterfassung von der Latenz der SD-Karte
+ *
+ * Ringpuffer fester Tiefe (LOG_QUEUE_DEPTH) für LogEntry-Datensätze mit
+ * genau einem Erzeuger und genau einem Verbraucher. Der Erzeuger schreibt
+ * nur den Kopf-, der Verbraucher nur den Endindex; beide Indizes sind
+ * einzelne Bytes und damit auf dem AVR atomar. Daher funktioniert die
+ * Queue ohne Interrupt-Sperre - auch wenn der Erzeuger eine ISR ist.
+ * Ist die Queue voll, wird der neue Eintrag verworfen (die bereits
+ * gepufferten, älteren Einträge bleiben vollständig erhalten).
+ */
+
+#ifndef LOG_QUEUE_H
+#define LOG_QUEUE_H
+
+#include "config.h"
+#include "data_logger.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Zähler zur Dimensionierung der Queue-Tiefe.
+ */
+struct LogQueueStats {
+  unsigned long pushed;     ///< Angenommene Einträge
+  unsigned long dropped;    ///< Verworfene Einträge (Queue voll)
+  unsigned long overflows;  ///< Überlaufphasen (Übergänge von "frei" nach "voll verworfen")
+  uint8_t highWater;        ///< Höchster beobachteter Füllstand
+  uint8_t depth;            ///< Konfigurierte Tiefe (LOG_QUEUE_DEPTH)
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Legt eine Kopie des Eintrags in die Queue (Erzeuger-Seite).
+ *
+ * Blockiert nie und darf auch aus einer ISR aufgerufen werden.
+ *
+ * @param entry Einzureihender Eintrag
+ * @return true wenn der Eintrag angenommen wurde, false wenn die Queue voll war
+ */
+bool logQueuePush(const LogEntry* entry);
+
+/**
+ * @brief Liefert den ältesten Eintrag, ohne ihn zu entfernen (Verbraucher-Seite).
+ *
+ * Der Zeiger bleibt bis zum nächsten logQueuePop() gültig; so kann ein
+ * Eintrag nach einem Schreibfehler erneut geschrieben werden.
+ *
+ * @return Zeiger auf den ältesten Eintrag oder NULL wenn die Queue leer ist
+ */
+const LogEntry* logQueuePeek();
+
+/**
+ * @brief Entfernt den ältesten Eintrag (Verbraucher-Seite).
+ */
+void logQueuePop();
+
+/**
+ * @brief Anzahl der aktuell gepufferten Einträge.
+ */
+uint8_t logQueueCount();
+
+/**
+ * @brief Liefert eine konsistente Kopie der Queue-Zähler.
+ *
+ * @param stats Ausgabe der Zähler
+ */
+void logQueueGetStats(LogQueueStats* stats);
+
+/**
+ * @brief Gibt Füllstand und Zähler über DEBUG_PRINT aus.
+ */
+void logQueuePrintStats();
+
+#endif // LOG_QUEUE_H
@@ -0,0 +1,250 @@
+/*
+ * Implementierung des gepufferten Log-Writers
+ */
+
+#include "log_writer.h"
+#include "perf_probe.h"
+#include "trace.h"
+#include <Arduino.h>
+#include <SD.h>
+#include "heap_guard.h"
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+static const uint16_t LOG_SECTOR_SIZE = 512;
+
+// Überlaufbereich hinter dem Sektor: nimmt den Rest der Zeile auf, die den
+// Sektor füllt, und hält nach einem Schreibfehler eine weitere Zeile
+// (längste CSV-Zeile mit Zeilenende; ein Binärdatensatz ist kürzer)
+static const uint16_t LOG_SPILL_SIZE = CSV_BUFFER_SIZE + 2;
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static File logWriterFile;
+static bool logWriterOpened = false;
+
+// Sektorpuffer; sectorOffset = Bytes des aktuellen Sektors, die bereits
+// in der Datei stehen (nach Sync eines Teilsektors oder beim Öffnen).
+// Übernommene Bytes bleiben im Puffer, bis die Datei sie angenommen hat.
+static uint8_t sectorBuffer[LOG_SECTOR_SIZE + LOG_SPILL_SIZE];
+static uint16_t sectorOffset = 0;
+static uint16_t bufferFill = 0;
+
+static uint16_t rowsSinceSync = 0;
+static unsigned long lastSyncTime = 0;
+
+static LogWriterStats logWriterStats = {0, 0, 0, 0, 0, 0, 0, 0};
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static inline void recordLatency(unsigned long startUs) {
+  unsigned long latency = micros() - startUs;
+  if (latency > logWriterStats.maxWriteLatencyUs) {
+    logWriterStats.maxWriteLatencyUs = latency;
+  }
+}
+
+// Schreibt den Puffer bis zur jeweils nächsten Sektorgrenze der Datei;
+// partial = true schreibt auch einen angefangenen Sektor (Sync).
+// Nach einem kurzen Schreibvorgang bleibt der nicht geschriebene Rest
+// im Puffer und wird beim nächsten Aufruf erneut versucht.
+static bool writeBuffer(bool partial) {
+  while (bufferFill > 0) {
+    uint16_t chunk = LOG_SECTOR_SIZE - sectorOffset;
+    if (bufferFill < chunk) {
+      if (!partial) return true;
+      chunk = bufferFill;
+    }
+
+    unsigned long start = micros();
+    size_t written;
+    {
+      PERF_SCOPE(SD_WRITE);
+      written = logWriterFile.write(sectorBuffer, chunk);
+    }
+    recordLatency(start);
+    if (written > chunk) written = 0;   // Fehlerwert der Bibliothek
+
+    logWriterStats.bytesWritten += written;
+    sectorOffset += written;
+    bufferFill -= written;
+    memmove(sectorBuffer, &sectorBuffer[written], bufferFill);
+    if (sectorOffset >= LOG_SECTOR_SIZE) {
+      sectorOffset = 0;
+      logWriterStats.sectorWrites++;
+    }
+
+    if (written != chunk) {
+      logWriterStats.errors++;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Prüft, ob length Bytes in den Puffer passen; ein noch voller Puffer
+// (vorheriger Schreibfehler) wird vorher erneut geschrieben
+static bool reserve(uint16_t length) {
+  if (!logWriterOpened) return false;
+  if (bufferFill + length > sizeof(sectorBuffer)) {
+    writeBuffer(false);
+  }
+  if (bufferFill + length > sizeof(sectorBuffer)) {
+    logWriterStats.rejected++;
+    return false;
+  }
+  return true;
+}
+
+// Kopiert in den Puffer (Platz vorher mit reserve() geprüft)
+static void append(const void* data, uint16_t length) {
+  memcpy(&sectorBuffer[bufferFill], data, length);
+  bufferFill += length;
+}
+
+// Volle Sektoren sofort schreiben; ein Fehler lässt die Daten im Puffer
+static void writeFullSectors() {
+  if (sectorOffset + bufferFill >= LOG_SECTOR_SIZE) {
+    writeBuffer(false);
+  }
+}
+
+// ==============================================
+// DATEI ÖFFNEN / SCHLIESSEN
+// ==============================================
+
+bool logWriterOpen(const char* filename) {
+  if (logWriterOpened) {
+    logWriterClose();
+  }
+
+  logWriterFile = SD.open(filename, FILE_WRITE);
+  if (!logWriterFile) {
+    TRACE(LOG_OPEN_FAILED);
+    return false;
+  }
+
+  // Puffer an der Sektorgrenze der Datei ausrichten (Anhängen ab Dateiende)
+  sectorOffset = logWriterFile.size() % LOG_SECTOR_SIZE;
+  bufferFill = 0;
+  rowsSinceSync = 0;
+  lastSyncTime = millis();
+  logWriterOpened = true;
+  return true;
+}
+
+void logWriterClose() {
+  if (!logWriterOpened) return;
+  if (!logWriterSync()) {
+    // Letzter Versuch fehlgeschlagen: Rest geht verloren, aber gezählt
+    logWriterStats.lostBytes += bufferFill;
+  }
+  bufferFill = 0;
+  logWriterFile.close();
+  logWriterOpened = false;
+}
+
+bool logWriterIsOpen() {
+  return logWriterOpened;
+}
+
+// ==============================================
+// SCHREIBEN
+// ==============================================
+
+bool logWriterWrite(const void* data, uint16_t length) {
+  if (!data || !reserve(length)) return false;
+  append(data, length);
+  writeFullSectors();
+  return true;
+}
+
+// Zeilen-/Datensatzzählung und Sync nach Budget. Die Zeile ist zu diesem
+// Zeitpunkt übernommen; ein Sync-Fehler wird gezählt und beim nächsten
+// Schreiben wiederholt, darf aber nicht zu einer doppelten Zeile führen.
+static void finishRow() {
+  logWriterStats.rowsWritten++;
+  rowsSinceSync++;
+  if (rowsSinceSync >= LOG_SYNC_ROWS) {
+    logWriterSync();
+  } else {
+    logWriterService();
+  }
+}
+
+bool logWriterWriteLine(const char* line) {
+  if (!line) return false;
+  // Zeile und Zeilenende (wie File::println) ganz oder gar nicht übernehmen
+  size_t length = strlen(line);
+  if (length > LOG_SPILL_SIZE - 2 || !reserve(length + 2)) return false;
+  append(line, length);
+  append("\r\n", 2);
+  writeFullSectors();
+  finishRow();
+  return true;
+}
+
+bool logWriterWriteRecord(const void* record, uint16_t length) {
+  if (!logWriterWrite(record, length)) {
+    return false;
+  }
+  finishRow();
+  return true;
+}
+
+void logWriterService() {
+  if (logWriterOpened && millis() - lastSyncTime >= LOG_SYNC_INTERVAL_MS) {
+    logWriterSync();
+  }
+}
+
+bool logWriterSync() {
+  if (!logWriterOpened) return true;
+
+  bool ok = writeBuffer(true);
+  unsigned long start = micros();
+  {
+    PERF_SCOPE(SD_SYNC);
+    logWriterFile.flush();
+  }
+  recordLatency(start);
+
+  logWriterStats.syncs++;
+  rowsSinceSync = 0;
+  lastSyncTime = millis();
+  return ok;
+}
+
+// ==============================================
+// STATISTIK
+// ==============================================
+
+void logWriterGetStats(LogWriterStats* out) {
+  if (out) *out = logWriterStats;
+}
+
+void logWriterPrintStats() {
+  DEBUG_PRINTLN(F("=== LOG-WRITER ==="));
+  DEBUG_PRINT(F("Zeilen: "));
+  DEBUG_PRINT(logWriterStats.rowsWritten);
+  DEBUG_PRINT(F(", Bytes: "));
+  DEBUG_PRINT(logWriterStats.bytesWritten);
+  DEBUG_PRINT(F(", Sektoren: "));
+  DEBUG_PRINT(logWriterStats.sectorWrites);
+  DEBUG_PRINT(F(", Syncs: "));
+  DEBUG_PRINT(logWriterStats.syncs);
+  DEBUG_PRINT(F(", Fehler: "));
+  DEBUG_PRINT(logWriterStats.errors);
+  DEBUG_PRINT(F(", abgewiesen: "));
+  DEBUG_PRINT(logWriterStats.rejected);
+  DEBUG_PRINT(F(", verloren Bytes: "));
+  DEBUG_PRINT(logWriterStats.lostBytes);
+  DEBUG_PRINT(F(", max. Latenz us: "));
+  DEBUG_PRINTLN(logWriterStats.maxWriteLatencyUs);
+}
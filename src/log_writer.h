@@ -0,0 +1,122 @@
+/*
+ * Gepufferter Log-Writer für das Umweltkontrollsystem
+ * Hält die Log-Datei offen und schreibt nur ganze 512-Byte-Sektoren
+ *
+ * Zeilen werden in einem Sektorpuffer gesammelt, der an der Dateiposition
+ * ausgerichtet ist: Ein voller Puffer endet immer genau auf einer
+ * Sektorgrenze der Datei. Ein Sync (Restpuffer schreiben + Verzeichnis-
+ * eintrag aktualisieren) erfolgt erst nach LOG_SYNC_ROWS Zeilen,
+ * LOG_SYNC_INTERVAL_MS Millisekunden oder beim Schließen.
+ *
+ * Zeilen und Datensätze werden ganz oder gar nicht übernommen. Schlägt
+ * ein Schreibvorgang fehl, bleibt der nicht geschriebene Rest im Puffer
+ * und wird beim nächsten Schreiben oder Sync wiederholt; passt eine neue
+ * Zeile dann nicht mehr in den Puffer, wird sie abgewiesen (false) und
+ * der Aufrufer kann sie später erneut anbieten.
+ */
+
+#ifndef LOG_WRITER_H
+#define LOG_WRITER_H
+
+#include "config.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Zähler zur Beurteilung der SD-Last.
+ */
+struct LogWriterStats {
+  unsigned long bytesWritten;        ///< An die SD-Bibliothek übergebene Bytes
+  unsigned long rowsWritten;         ///< Geschriebene Zeilen
+  unsigned long sectorWrites;        ///< Geschriebene volle Sektoren
+  unsigned long syncs;               ///< Syncs (Restpuffer + Verzeichniseintrag)
+  unsigned long errors;              ///< Fehlgeschlagene Schreibvorgänge (Daten bleiben gepuffert)
+  unsigned long rejected;            ///< Abgewiesene Zeilen/Datensätze (Puffer voll)
+  unsigned long lostBytes;           ///< Beim Schließen nicht schreibbare Bytes
+  unsigned long maxWriteLatencyUs;   ///< Längster einzelner Schreib- oder Sync-Vorgang
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Öffnet die Log-Datei zum Anhängen und hält sie offen.
+ *
+ * Eine bereits offene Datei wird vorher synchronisiert und geschlossen.
+ *
+ * @param filename Name der Log-Datei (8.3-Format)
+ * @return true wenn die Datei geöffnet wurde
+ */
+bool logWriterOpen(const char* filename);
+
+/**
+ * @brief Hängt Rohdaten an den Sektorpuffer an (ohne Zeilenzählung).
+ *
+ * Schreibt nur, wenn dabei ein Sektor voll wird.
+ *
+ * @param data Zu schreibende Bytes
+ * @param length Anzahl Bytes (höchstens eine CSV-Zeile)
+ * @return true wenn alle Bytes übernommen wurden, false wenn keines
+ */
+bool logWriterWrite(const void* data, uint16_t length);
+
+/**
+ * @brief Hängt einen binären Datensatz an und zählt ihn wie eine Zeile.
+ *
+ * @param record Datensatz
+ * @param length Größe des Datensatzes in Bytes
+ * @return true wenn der Datensatz übernommen wurde
+ */
+bool logWriterWriteRecord(const void* record, uint16_t length);
+
+/**
+ * @brief Hängt eine Zeile (mit Zeilenumbruch) an den Sektorpuffer an.
+ *
+ * Schreibt nur, wenn dabei ein Sektor voll wird, und synchronisiert
+ * nach Erreichen des Zeilen- oder Zeitbudgets.
+ *
+ * @param line Nullterminierte Zeile ohne Zeilenumbruch
+ * @return true wenn die Zeile übernommen wurde
+ */
+bool logWriterWriteLine(const char* line);
+
+/**
+ * @brief Prüft das Zeitbudget und synchronisiert bei Bedarf.
+ *
+ * Für Phasen ohne neue Zeilen, z.B. aus dem System-Check aufrufen.
+ */
+void logWriterService();
+
+/**
+ * @brief Schreibt den Restpuffer und aktualisiert den Verzeichniseintrag.
+ *
+ * @return true wenn erfolgreich oder nichts zu tun war
+ */
+bool logWriterSync();
+
+/**
+ * @brief Synchronisiert und schließt die Log-Datei (z.B. vor einem Reset).
+ */
+void logWriterClose();
+
+/**
+ * @return true wenn eine Log-Datei geöffnet ist
+ */
+bool logWriterIsOpen();
+
+/**
+ * @brief Liefert die Schreibstatistik.
+ *
+ * @param out Ausgabe der Zähler
+ */
+void logWriterGetStats(LogWriterStats* out);
+
+/**
+ * @brief Gibt die Schreibstatistik seriell aus.
+ */
+void logWriterPrintStats();
+
+#endif // LOG_WRITER_H
@@ -0,0 +1,123 @@
+/*
+ * Implementierung der Speicherüberwachung
+ */
+
+#include "memory_monitor.h"
+#include "utilities.h"
+#include <Arduino.h>
+#include <stdlib.h>
+
+// Symbole aus dem Linker-Skript bzw. der avr-libc
+extern char __data_start;
+extern char __bss_end;
+extern char __heap_start;
+extern char* __brkval;
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static MemoryStats memoryStats = {0, 0, 0, 0, 0, 0};
+
+// Höchste bisher erreichte Heap-Obergrenze (__brkval)
+static char* heapTopPeak = &__heap_start;
+
+// ==============================================
+// STACK-PAINTING
+// ==============================================
+
+// Läuft in .init3: nach dem Setzen des Stackpointers (.init2), vor dem
+// Kopieren von .data und dem Löschen von .bss (.init4) und vor allen
+// Konstruktoren. Ohne Prolog und ohne Aufrufe, der Stack ist noch leer.
+static void paintStack() __attribute__((naked, used, section(".init3")));
+
+static void paintStack() {
+  uint8_t* p = (uint8_t*)&__heap_start;
+  uint8_t* end = (uint8_t*)SP;
+  while (p <= end) {
+    *p++ = MEMORY_PAINT_BYTE;
+  }
+}
+
+// ==============================================
+// HEAP-HOOKS (-Wl,--wrap=malloc -Wl,--wrap=realloc)
+// ==============================================
+
+static inline void updateHeapPeak() {
+  char* top = __brkval ? __brkval : &__heap_start;
+  if (top > heapTopPeak) heapTopPeak = top;
+}
+
+#ifdef MEMORY_HEAP_HOOKS
+
+extern "C" void* __real_malloc(size_t size);
+extern "C" void* __real_realloc(void* pointer, size_t size);
+
+extern "C" void* __wrap_malloc(size_t size) {
+  void* pointer = __real_malloc(size);
+  memoryStats.allocations++;
+  if (!pointer) memoryStats.failedAllocations++;
+  updateHeapPeak();
+  return pointer;
+}
+
+extern "C" void* __wrap_realloc(void* pointer, size_t size) {
+  void* result = __real_realloc(pointer, size);
+  memoryStats.allocations++;
+  if (!result && size) memoryStats.failedAllocations++;
+  updateHeapPeak();
+  return result;
+}
+
+#endif // MEMORY_HEAP_HOOKS
+
+// ==============================================
+// SUCHE
+// ==============================================
+
+void memoryMonitorScan() {
+  updateHeapPeak();
+
+  // Unterhalb des Heap-Höchststands hat ggf. der Heap die Farbe überschrieben
+  uint8_t* p = (uint8_t*)heapTopPeak;
+  uint8_t* stackPointer = (uint8_t*)SP;
+  while (p < stackPointer && *p == MEMORY_PAINT_BYTE) {
+    p++;
+  }
+
+  memoryStats.staticBytes = &__bss_end - &__data_start;
+  memoryStats.heapPeak = heapTopPeak - &__heap_start;
+  memoryStats.stackPeak = (uint8_t*)RAMEND - p + 1;
+  memoryStats.margin = p - (uint8_t*)heapTopPeak;
+}
+
+// Deklariert in utilities.h; hier, weil es dieselben Linker-Symbole braucht
+unsigned int getFreeRAM() {
+  uint8_t marker;
+  char* heapEnd = __brkval ? __brkval : &__heap_start;
+  return (unsigned int)((char*)&marker - heapEnd);
+}
+
+void memoryMonitorGetStats(MemoryStats* stats) {
+  *stats = memoryStats;
+}
+
+void memoryMonitorPrintStats() {
+  DEBUG_PRINTLN(F("=== SPEICHER ==="));
+  DEBUG_PRINT(F("Statisch: "));
+  DEBUG_PRINT(memoryStats.staticBytes);
+  DEBUG_PRINT(F(", Heap max: "));
+  DEBUG_PRINT(memoryStats.heapPeak);
+  DEBUG_PRINT(F(", Stack max: "));
+  DEBUG_PRINT(memoryStats.stackPeak);
+  DEBUG_PRINT(F(", nie benutzt: "));
+  DEBUG_PRINT(memoryStats.margin);
+#ifdef MEMORY_HEAP_HOOKS
+  DEBUG_PRINT(F(" Bytes, Allokationen: "));
+  DEBUG_PRINT(memoryStats.allocations);
+  DEBUG_PRINT(F(", fehlgeschlagen: "));
+  DEBUG_PRINTLN(memoryStats.failedAllocations);
+#else
+  DEBUG_PRINTLN(F(" Bytes"));
+#endif
+}
@@ -0,0 +1,59 @@
+/*
+ * Speicherüberwachung für das Umweltkontrollsystem
+ * Höchststände von Stack und Heap statt Momentaufnahmen
+ *
+ * getFreeRAM() misst nur den Abstand zwischen Heap und Stack im Moment
+ * des Aufrufs und übersieht die tiefste Verschachtelung. Deshalb wird
+ * der freie Bereich vor dem Start von main() mit MEMORY_PAINT_BYTE
+ * gefüllt (Stack-Painting). memoryMonitorScan() sucht vom Heap-Ende
+ * aufwärts das erste überschriebene Byte: darunter wurde der Stack nie
+ * benutzt. Die Suche läuft nur über den unbenutzten Bereich (ca. 4
+ * Zyklen je Byte, bei 2 KB Reserve rund 0,5 ms) und ist für den
+ * System-Check gedacht.
+ * Der Heap-Höchststand kommt aus Hooks um malloc()/realloc(), die nur mit
+ * den Linker-Optionen aus platformio.ini (--wrap, MEMORY_HEAP_HOOKS)
+ * aktiv sind; sonst wird __brkval bei jeder Suche abgetastet.
+ * Die statische Belegung je Modul liefert tools/hsmap aus der Map-Datei.
+ */
+
+#ifndef MEMORY_MONITOR_H
+#define MEMORY_MONITOR_H
+
+#include "config.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief RAM-Aufteilung und Höchststände in Bytes.
+ */
+struct MemoryStats {
+  uint16_t staticBytes;     ///< .data + .bss (fest ab dem Linken)
+  uint16_t heapPeak;        ///< Größte Heap-Ausdehnung seit dem Start
+  uint16_t stackPeak;       ///< Tiefster Stack seit dem Start
+  uint16_t margin;          ///< Nie benutzter Bereich zwischen Heap und Stack
+  unsigned long allocations;      ///< malloc()/realloc()-Aufrufe (nur mit Hooks)
+  unsigned long failedAllocations; ///< Davon ohne Speicher (nur mit Hooks)
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Sucht die Stack-Grenze im bemalten Bereich und aktualisiert die Höchststände.
+ */
+void memoryMonitorScan();
+
+/**
+ * @brief Liefert die Werte der letzten Suche.
+ */
+void memoryMonitorGetStats(MemoryStats* stats);
+
+/**
+ * @brief Gibt die RAM-Aufteilung über DEBUG_PRINT aus.
+ */
+void memoryMonitorPrintStats();
+
+#endif // MEMORY_MONITOR_H
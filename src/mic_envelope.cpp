@@ -0,0 +1,221 @@
+/*
+ * Implementierung des Mikrofon-Hüllkurven-Moduls
+ */
+
+#include "mic_envelope.h"
+#include "adc_scanner.h"
+#include <Arduino.h>
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+// Laufendes kurzes Fenster - wird in der ADC-ISR fortgeschrieben
+struct MicAccumulator {
+  uint16_t minValue;
+  uint16_t maxValue;
+  uint16_t peak;          // Größte |Abweichung| vom Gleichanteil
+  uint16_t count;
+  uint32_t sumSquares;    // Summe der quadrierten Abweichungen
+};
+
+// Zusammenfassung mehrerer abgeschlossener Fenster (nur Hauptschleife)
+struct MicAggregate {
+  uint16_t minValue;
+  uint16_t maxValue;
+  uint16_t peak;
+  uint8_t windows;
+  uint32_t sumMeanSquares;  // Summe der mittleren Quadrate der Teilfenster
+};
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static MicAccumulator micAccum[MAX_MICROPHONES];
+static int32_t micDcQ8[MAX_MICROPHONES];      // Gleichanteil in Q8 (nur ISR)
+static bool micDcValid[MAX_MICROPHONES];
+
+static MicAggregate micMid[MAX_MICROPHONES];
+static MicAggregate micLong[MAX_MICROPHONES];
+static MicEnvelope micResults[MAX_MICROPHONES][MIC_WINDOW_COUNT];
+static bool micResultValid[MAX_MICROPHONES][MIC_WINDOW_COUNT];
+
+static uint16_t micHoldValue[MAX_MICROPHONES];
+static unsigned long micHoldTime[MAX_MICROPHONES];
+
+static unsigned long micWindowStart = 0;
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static void resetAccumulator(MicAccumulator* acc) {
+  acc->minValue = 1023;
+  acc->maxValue = 0;
+  acc->peak = 0;
+  acc->count = 0;
+  acc->sumSquares = 0;
+}
+
+static void resetAggregate(MicAggregate* agg) {
+  agg->minValue = 1023;
+  agg->maxValue = 0;
+  agg->peak = 0;
+  agg->windows = 0;
+  agg->sumMeanSquares = 0;
+}
+
+// Ganzzahlige Quadratwurzel (bitweise, ohne Float)
+static uint16_t isqrt32(uint32_t value) {
+  uint32_t result = 0;
+  uint32_t bit = 1UL << 30;
+  while (bit > value) bit >>= 2;
+  while (bit != 0) {
+    if (value >= result + bit) {
+      value -= result + bit;
+      result = (result >> 1) + bit;
+    } else {
+      result >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint16_t)result;
+}
+
+// Fügt ein abgeschlossenes Teilfenster einer Zusammenfassung hinzu.
+// Gibt true zurück, sobald die Zusammenfassung windowCount Teilfenster enthält.
+static bool addToAggregate(MicAggregate* agg, uint16_t minValue, uint16_t maxValue,
+                           uint16_t peak, uint32_t meanSquare, uint8_t windowCount,
+                           MicEnvelope* result) {
+  if (minValue < agg->minValue) agg->minValue = minValue;
+  if (maxValue > agg->maxValue) agg->maxValue = maxValue;
+  if (peak > agg->peak) agg->peak = peak;
+  agg->sumMeanSquares += meanSquare;
+  agg->windows++;
+
+  if (agg->windows < windowCount) return false;
+
+  result->peakToPeak = agg->maxValue - agg->minValue;
+  result->peak = agg->peak;
+  result->rms = isqrt32(agg->sumMeanSquares / agg->windows);
+  return true;
+}
+
+// ==============================================
+// ADC-SAMPLE-CALLBACK (läuft in der ISR)
+// ==============================================
+
+static void micSampleHook(uint8_t channel, uint16_t value) {
+  uint8_t mic = (channel == adcScanChannel(MIC_KLEIN_PIN)) ? 0 : 1;
+
+  // Gleichanteil (Mikrofon-Bias) gleitend schätzen, Zeitkonstante 1024 Messwerte
+  if (!micDcValid[mic]) {
+    micDcQ8[mic] = (int32_t)value << 8;
+    micDcValid[mic] = true;
+  }
+  int16_t dc = (int16_t)(micDcQ8[mic] >> 8);
+  micDcQ8[mic] += (((int32_t)value << 8) - micDcQ8[mic]) >> 10;
+
+  int16_t deviation = (int16_t)value - dc;
+  uint16_t magnitude = deviation < 0 ? -deviation : deviation;
+
+  MicAccumulator* acc = &micAccum[mic];
+  if (value < acc->minValue) acc->minValue = value;
+  if (value > acc->maxValue) acc->maxValue = value;
+  if (magnitude > acc->peak) acc->peak = magnitude;
+  acc->sumSquares += (uint32_t)magnitude * magnitude;
+  acc->count++;
+}
+
+// ==============================================
+// STEUERUNG
+// ==============================================
+
+void micEnvelopeBegin() {
+  DEBUG_PRINTLN(F("Starte Mikrofon-Hüllkurven-Tracker..."));
+
+  for (uint8_t mic = 0; mic < MAX_MICROPHONES; mic++) {
+    resetAccumulator(&micAccum[mic]);
+    resetAggregate(&micMid[mic]);
+    resetAggregate(&micLong[mic]);
+    micDcValid[mic] = false;
+    micHoldValue[mic] = 0;
+    micHoldTime[mic] = 0;
+    for (uint8_t w = 0; w < MIC_WINDOW_COUNT; w++) {
+      micResultValid[mic][w] = false;
+    }
+  }
+  micWindowStart = millis();
+
+  uint8_t channels[MAX_MICROPHONES] = { adcScanChannel(MIC_KLEIN_PIN), adcScanChannel(MIC_GROSS_PIN) };
+  for (uint8_t mic = 0; mic < MAX_MICROPHONES; mic++) {
+    adcScanSetChannelRate(channels[mic], 1, MIC_ENV_BURST);
+    adcScanSetSampleHook(channels[mic], micSampleHook);
+  }
+}
+
+void micEnvelopeUpdate() {
+  unsigned long now = millis();
+  if (now - micWindowStart < MIC_ENV_SHORT_MS) return;
+
+  // Fensterraster beibehalten, bei großem Rückstand neu ausrichten
+  micWindowStart += MIC_ENV_SHORT_MS;
+  if (now - micWindowStart >= MIC_ENV_SHORT_MS) micWindowStart = now;
+
+  for (uint8_t mic = 0; mic < MAX_MICROPHONES; mic++) {
+    // Kurzes Fenster atomar übernehmen und zurücksetzen
+    MicAccumulator acc;
+    noInterrupts();
+    acc = micAccum[mic];
+    resetAccumulator(&micAccum[mic]);
+    interrupts();
+
+    if (acc.count == 0) continue;
+
+    uint32_t meanSquare = acc.sumSquares / acc.count;
+    MicEnvelope* shortResult = &micResults[mic][MIC_WINDOW_SHORT];
+    shortResult->peakToPeak = acc.maxValue - acc.minValue;
+    shortResult->peak = acc.peak;
+    shortResult->rms = isqrt32(meanSquare);
+    micResultValid[mic][MIC_WINDOW_SHORT] = true;
+
+    // Peak-Hold über ein Logging-Intervall
+    if (shortResult->peakToPeak >= micHoldValue[mic] ||
+        now - micHoldTime[mic] >= LOGGING_INTERVAL) {
+      micHoldValue[mic] = shortResult->peakToPeak;
+      micHoldTime[mic] = now;
+    }
+
+    // Kaskade: kurz -> mittel -> lang
+    MicEnvelope* midResult = &micResults[mic][MIC_WINDOW_MID];
+    if (addToAggregate(&micMid[mic], acc.minValue, acc.maxValue, acc.peak,
+                       meanSquare, MIC_ENV_MID_WINDOWS, midResult)) {
+      micResultValid[mic][MIC_WINDOW_MID] = true;
+      uint32_t midMeanSquare = micMid[mic].sumMeanSquares / micMid[mic].windows;
+
+      if (addToAggregate(&micLong[mic], micMid[mic].minValue, micMid[mic].maxValue,
+                         micMid[mic].peak, midMeanSquare, MIC_ENV_LONG_WINDOWS,
+                         &micResults[mic][MIC_WINDOW_LONG])) {
+        micResultValid[mic][MIC_WINDOW_LONG] = true;
+        resetAggregate(&micLong[mic]);
+      }
+      resetAggregate(&micMid[mic]);
+    }
+  }
+}
+
+// ==============================================
+// WERTE AUSLESEN
+// ==============================================
+
+bool micEnvelopeGet(uint8_t mic, MicWindow window, MicEnvelope* out) {
+  if (mic >= MAX_MICROPHONES || window >= MIC_WINDOW_COUNT || !out) return false;
+  *out = micResults[mic][window];
+  return micResultValid[mic][window];
+}
+
+uint16_t micEnvelopePeakHold(uint8_t mic) {
+  if (mic >= MAX_MICROPHONES) return 0;
+  return micHoldValue[mic];
+}
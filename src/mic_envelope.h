@@ -0,0 +1,86 @@
+/*
+ * Mikrofon-Hüllkurven-Modul für das Umweltkontrollsystem
+ * Kontinuierliche Pegelerfassung für MIC_KLEIN_PIN und MIC_GROSS_PIN
+ *
+ * Jeder Scanner-Messwert der Mikrofonkanäle wird inkrementell in
+ * Minimum, Maximum und Quadratsumme eines kurzen Fensters eingerechnet.
+ * Abgeschlossene kurze Fenster werden zu mittleren und langen Fenstern
+ * zusammengefasst. Das Auslesen ist O(1) und blockiert nie.
+ */
+
+#ifndef MIC_ENVELOPE_H
+#define MIC_ENVELOPE_H
+
+#include "config.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Auswertefenster der Hüllkurve.
+ */
+enum MicWindow {
+  MIC_WINDOW_SHORT = 0,   ///< MIC_ENV_SHORT_MS (Standard 100 ms)
+  MIC_WINDOW_MID = 1,     ///< MIC_ENV_MID_WINDOWS kurze Fenster (Standard 1 s)
+  MIC_WINDOW_LONG = 2,    ///< MIC_ENV_LONG_WINDOWS mittlere Fenster (Standard 10 s)
+  MIC_WINDOW_COUNT = 3
+};
+
+/**
+ * @brief Pegelwerte eines abgeschlossenen Fensters.
+ *
+ * Alle Werte in ADC-Einheiten (10 bit), bezogen auf den gleitend
+ * geschätzten Gleichanteil (Mikrofon-Bias).
+ */
+struct MicEnvelope {
+  uint16_t peakToPeak;   ///< Maximum - Minimum im Fenster
+  uint16_t rms;          ///< Effektivwert der Abweichung vom Gleichanteil
+  uint16_t peak;         ///< Größte absolute Abweichung vom Gleichanteil
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Startet den Hüllkurven-Tracker für beide Mikrofone.
+ *
+ * Registriert die Sample-Callbacks im ADC-Scanner und erhöht die
+ * Abtastrate der Mikrofonkanäle (MIC_ENV_BURST Messwerte pro Besuch).
+ * Muss nach adcScanBegin() aufgerufen werden.
+ */
+void micEnvelopeBegin();
+
+/**
+ * @brief Schließt fällige Fenster ab (aus der Hauptschleife aufrufen).
+ *
+ * Prüft nur millis(); nach Ablauf von MIC_ENV_SHORT_MS werden die
+ * Akkumulatoren unter kurzer Interruptsperre übernommen und in die
+ * längeren Fenster kaskadiert.
+ */
+void micEnvelopeUpdate();
+
+/**
+ * @brief Liefert die Pegelwerte des letzten abgeschlossenen Fensters.
+ *
+ * @param mic Mikrofon-Index (0 = Klein, 1 = Gross)
+ * @param window Gewünschtes Fenster
+ * @param out Ausgabe der Pegelwerte
+ * @return true wenn für dieses Fenster bereits Werte vorliegen
+ */
+bool micEnvelopeGet(uint8_t mic, MicWindow window, MicEnvelope* out);
+
+/**
+ * @brief Liefert den gehaltenen Spitzenpegel (Peak-Hold).
+ *
+ * Größter Peak-to-Peak-Wert eines kurzen Fensters innerhalb der
+ * letzten LOGGING_INTERVAL Millisekunden. Damit geht zwischen zwei
+ * Log-Zeilen kein Geräusch verloren.
+ *
+ * @param mic Mikrofon-Index (0 = Klein, 1 = Gross)
+ * @return Gehaltener Peak-to-Peak-Wert
+ */
+uint16_t micEnvelopePeakHold(uint8_t mic);
+
+#endif // MIC_ENVELOPE_H
@@ -0,0 +1,228 @@
+/*
+ * Arduino-Kern für den Host-Build: Register, Zeit, Pins, Print/Serial
+ */
+
+#include <Arduino.h>
+#include <time.h>
+#include "sim.h"
+#include "../perf_probe.h"
+
+// ==============================================
+// REGISTER
+// ==============================================
+
+#define HS_REG8(name) volatile uint8_t name = 0;
+#define HS_REG16(name) volatile uint16_t name = 0;
+#define HS_FLAG8(name) HsFlagRegister name = {0};
+
+HS_REG8(SREG) HS_REG8(MCUSR) HS_REG8(SMCR)
+volatile uint16_t SP = RAMEND;
+
+HS_REG8(ADMUX) HS_REG8(ADCSRA) HS_REG8(ADCSRB) HS_REG16(ADC) HS_REG8(DIDR0) HS_REG8(DIDR2)
+
+HS_REG8(TCCR1A) HS_REG8(TCCR1B) HS_REG8(TCCR1C) HS_REG16(TCNT1) HS_REG8(TIMSK1) HS_FLAG8(TIFR1)
+HS_REG8(TCCR3A) HS_REG8(TCCR3B) HS_REG16(TCNT3) HS_REG16(OCR3A) HS_REG8(TIMSK3) HS_FLAG8(TIFR3)
+HS_REG8(TCCR5A) HS_REG8(TCCR5B) HS_REG8(TCCR5C) HS_REG16(TCNT5) HS_REG8(TIMSK5) HS_FLAG8(TIFR5)
+
+HS_REG8(EICRA) HS_REG8(EICRB) HS_REG8(EIMSK) HS_FLAG8(EIFR)
+
+HS_REG8(TWBR) HS_REG8(TWSR) HS_REG8(TWCR) HS_REG8(TWDR)
+
+// ==============================================
+// ZEIT
+// ==============================================
+
+unsigned long millis() {
+  return (unsigned long)(simMicros() / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)simMicros();
+}
+
+void delay(unsigned long ms) {
+  simAdvance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  simAdvance(us);
+}
+
+#if PERF_ENABLED
+// Messpunkte zählen im Host-Build Rechenzeit des Hosts, umgerechnet auf
+// den CPU-Takt des Controllers (16 Zyklen je µs), nicht simulierte Zeit
+uint32_t perfCycles() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  uint64_t ns = (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+  return (uint32_t)(ns * (F_CPU / 1000000UL) / 1000);
+}
+#endif
+
+// ==============================================
+// PINS
+// ==============================================
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  simPinMode(pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  simDigitalWrite(pin, value);
+}
+
+int digitalRead(uint8_t pin) {
+  return simDigitalRead(pin);
+}
+
+int analogRead(uint8_t pin) {
+  return simAnalogSample(pin >= A0 ? pin - A0 : pin);
+}
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode) {
+  // Die Firmware benutzt direkt EIMSK/INTx_vect, siehe sim.h
+  (void)interrupt;
+  (void)handler;
+  (void)mode;
+}
+
+void detachInterrupt(uint8_t interrupt) {
+  (void)interrupt;
+}
+
+char* dtostrf(double value, signed char width, unsigned char precision, char* buffer) {
+  sprintf(buffer, "%*.*f", width, precision, value);
+  return buffer;
+}
+
+// ==============================================
+// PRINT
+// ==============================================
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) n += write(*buffer++);
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper* str) {
+  return write((const char*)str);
+}
+
+size_t Print::print(const char* str) {
+  return write(str);
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char value, int base) {
+  return printNumber(value, base);
+}
+
+size_t Print::print(int value, int base) {
+  return print((long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+  return printNumber(value, base);
+}
+
+size_t Print::print(long value, int base) {
+  if (base == DEC && value < 0) {
+    return write('-') + printNumber(-(unsigned long)value, DEC);
+  }
+  return printNumber((unsigned long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+  return printNumber(value, base);
+}
+
+size_t Print::print(double value, int digits) {
+  return printFloat(value, digits);
+}
+
+size_t Print::println() {
+  return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper* str) { return print(str) + println(); }
+size_t Print::println(const char* str) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char value, int base) { return print(value, base) + println(); }
+size_t Print::println(int value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned int value, int base) { return print(value, base) + println(); }
+size_t Print::println(long value, int base) { return print(value, base) + println(); }
+size_t Print::println(unsigned long value, int base) { return print(value, base) + println(); }
+size_t Print::println(double value, int digits) { return print(value, digits) + println(); }
+
+size_t Print::printNumber(unsigned long value, uint8_t base) {
+  char buffer[8 * sizeof(long) + 1];
+  char* str = &buffer[sizeof(buffer) - 1];
+  *str = '\0';
+  if (base < 2) base = 10;
+  do {
+    char digit = value % base;
+    value /= base;
+    *--str = digit < 10 ? digit + '0' : digit + 'A' - 10;
+  } while (value);
+  return write(str);
+}
+
+// Wie der AVR-Kern: gerundet auf digits Stellen, ohne Exponentendarstellung
+size_t Print::printFloat(double value, uint8_t digits) {
+  if (isnan(value)) return print("nan");
+  if (isinf(value)) return print("inf");
+  if (value > 4294967040.0 || value < -4294967040.0) return print("ovf");
+
+  size_t n = 0;
+  if (value < 0.0) {
+    n += write('-');
+    value = -value;
+  }
+
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; i++) rounding /= 10.0;
+  value += rounding;
+
+  unsigned long integer = (unsigned long)value;
+  double remainder = value - (double)integer;
+  n += print(integer);
+  if (digits > 0) n += write('.');
+  while (digits-- > 0) {
+    remainder *= 10.0;
+    unsigned int digit = (unsigned int)remainder;
+    n += print(digit);
+    remainder -= digit;
+  }
+  return n;
+}
+
+// ==============================================
+// SERIAL
+// ==============================================
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+
+static bool serialOutput = false;
+
+void hsNativeSerialOutput(bool enabled) {
+  serialOutput = enabled;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  if (serialOutput && port == 0) putchar(c);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+  if (serialOutput && port == 0) fwrite(buffer, 1, size, stdout);
+  return size;
+}
+
+void HardwareSerial::flush() {
+  if (serialOutput && port == 0) fflush(stdout);
+}
@@ -0,0 +1,29 @@
+/*
+ * Adafruit_GFX für den Host-Build
+ *
+ * Nur die Schnittstelle, die display.h für die Klassendeklaration
+ * braucht. Das Display ist im Host-Build durch display_native.cpp
+ * ersetzt und zeichnet nichts.
+ */
+
+#ifndef NATIVE_ADAFRUIT_GFX_H
+#define NATIVE_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+class Adafruit_GFX : public Print {
+public:
+  Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h) {}
+
+  virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+  size_t write(uint8_t c) override { (void)c; return 1; }
+
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+protected:
+  int16_t _width;
+  int16_t _height;
+};
+
+#endif // NATIVE_ADAFRUIT_GFX_H
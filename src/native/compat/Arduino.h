@@ -0,0 +1,186 @@
+/*
+ * Arduino-Kern für den Host-Build (PlatformIO-Umgebung "native")
+ *
+ * Stellt die Teile der Arduino-API bereit, die die Firmware-Module
+ * benutzen: Zeit, Pins, Print/Serial und dtostrf. Zeit und Pins kommen
+ * aus dem Simulator (sim.h), die serielle Ausgabe geht wahlweise nach
+ * stdout. Register und Interrupt-Vektoren siehe avr/io.h und
+ * avr/interrupt.h in diesem Verzeichnis.
+ */
+
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <ctype.h>
+
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+// ==============================================
+// TYPEN UND KONSTANTEN
+// ==============================================
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// Analoge Pins des Mega 2560
+#define A0 54
+#define A1 55
+#define A2 56
+#define A3 57
+#define A4 58
+#define A5 59
+#define A6 60
+#define A7 61
+#define A8 62
+#define A9 63
+#define A10 64
+#define A11 65
+#define A12 66
+#define A13 67
+#define A14 68
+#define A15 69
+#define NUM_DIGITAL_PINS 70
+
+static const uint8_t SDA = 20;
+static const uint8_t SCL = 21;
+
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) ((p) == 2 ? 0 : ((p) == 3 ? 1 : ((p) >= 18 && (p) <= 21 ? 23 - (p) : NOT_AN_INTERRUPT)))
+
+#define noInterrupts() cli()
+#define interrupts() sei()
+
+// Wie im AVR-Kern als Makros (nach den C-Headern, die abs() deklarieren)
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define abs(x) ((x) > 0 ? (x) : -(x))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ==============================================
+// ZEIT UND PINS
+// ==============================================
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode);
+void detachInterrupt(uint8_t interrupt);
+
+char* dtostrf(double value, signed char width, unsigned char precision, char* buffer);
+
+// ==============================================
+// PRINT / SERIAL
+// ==============================================
+
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+  size_t write(const char* buffer, size_t size) { return write((const uint8_t*)buffer, size); }
+
+  size_t print(const __FlashStringHelper* str);
+  size_t print(const char* str);
+  size_t print(char c);
+  size_t print(unsigned char value, int base = DEC);
+  size_t print(int value, int base = DEC);
+  size_t print(unsigned int value, int base = DEC);
+  size_t print(long value, int base = DEC);
+  size_t print(unsigned long value, int base = DEC);
+  size_t print(double value, int digits = 2);
+
+  size_t println(const __FlashStringHelper* str);
+  size_t println(const char* str);
+  size_t println(char c);
+  size_t println(unsigned char value, int base = DEC);
+  size_t println(int value, int base = DEC);
+  size_t println(unsigned int value, int base = DEC);
+  size_t println(long value, int base = DEC);
+  size_t println(unsigned long value, int base = DEC);
+  size_t println(double value, int digits = 2);
+  size_t println();
+
+private:
+  size_t printNumber(unsigned long value, uint8_t base);
+  size_t printFloat(double value, uint8_t digits);
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+};
+
+/**
+ * @brief Serielle Schnittstelle ohne Baudraten-Drosselung.
+ *
+ * Ausgabe nach stdout, wenn mit hsNativeSerialOutput() eingeschaltet,
+ * sonst wird sie nur formatiert und verworfen (die Kosten der
+ * Formatierung bleiben damit in der Messung). Eingaben gibt es keine.
+ */
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(uint8_t port) : port(port) {}
+
+  void begin(unsigned long baud) { (void)baud; }
+  void end() {}
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  int availableForWrite() { return 63; }
+  void flush();
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+  operator bool() { return true; }
+
+private:
+  uint8_t port;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+
+/**
+ * @brief Schaltet die Ausgabe von Serial nach stdout ein oder aus.
+ */
+void hsNativeSerialOutput(bool enabled);
+
+#endif // NATIVE_ARDUINO_H
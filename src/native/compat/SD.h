@@ -0,0 +1,73 @@
+/*
+ * SD-Bibliothek für den Host-Build
+ *
+ * Die Karte ist ein Verzeichnis des Host-Dateisystems (hsNativeSdRoot(),
+ * Standard "sd"). Dateinamen werden wie auf der Karte ohne Pfad
+ * übergeben. File-Objekte sind wie in der Arduino-Bibliothek kopierbar;
+ * alle Kopien teilen sich die offene Datei.
+ */
+
+#ifndef NATIVE_SD_H
+#define NATIVE_SD_H
+
+#include <Arduino.h>
+
+#define FILE_READ 0x01
+#define FILE_WRITE 0x13
+
+struct NativeFileHandle;
+
+class File : public Stream {
+public:
+  File() : handle(NULL) {}
+  explicit File(NativeFileHandle* handle) : handle(handle) {}
+  File(const File& other);
+  File& operator=(const File& other);
+  ~File();
+
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t* buffer, size_t size) override;
+  using Print::write;
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  int read(void* buffer, uint16_t length);
+
+  void flush();
+  bool seek(uint32_t position);
+  uint32_t position();
+  uint32_t size();
+  void close();
+  operator bool() const { return handle != NULL; }
+
+private:
+  NativeFileHandle* handle;
+};
+
+class SDClass {
+public:
+  bool begin(uint8_t chipSelect);
+  bool exists(const char* filename);
+  bool remove(const char* filename);
+  File open(const char* filename, uint8_t mode = FILE_READ);
+};
+
+extern SDClass SD;
+
+class SdFile {
+public:
+  static void dateTimeCallback(void (*callback)(uint16_t* date, uint16_t* time)) { (void)callback; }
+};
+
+/**
+ * @brief Legt das Verzeichnis fest, das die SD-Karte darstellt.
+ */
+void hsNativeSdRoot(const char* directory);
+
+/**
+ * @brief Bisher auf die "Karte" geschriebene Bytes (alle Dateien).
+ */
+unsigned long hsNativeSdBytesWritten();
+
+#endif // NATIVE_SD_H
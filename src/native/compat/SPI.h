@@ -0,0 +1,9 @@
+/*
+ * SPI für den Host-Build: die SD-Karte ist ein Verzeichnis (siehe SD.h),
+ * die Firmware benutzt SPI nicht direkt
+ */
+
+#ifndef NATIVE_SPI_H
+#define NATIVE_SPI_H
+
+#endif // NATIVE_SPI_H
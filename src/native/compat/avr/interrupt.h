@@ -0,0 +1,21 @@
+/*
+ * Interrupts für den Host-Build
+ *
+ * ISR(vector) definiert eine gewöhnliche C-Funktion, die der Simulator
+ * zum Zeitpunkt des Hardware-Ereignisses aufruft. Da der Simulator nur
+ * innerhalb von delay() und sleep_cpu() Zeit fortschreibt, kann eine
+ * ISR nie mitten in einer Funktion der Hauptschleife laufen; cli() und
+ * sei() sind deshalb leer.
+ */
+
+#ifndef NATIVE_AVR_INTERRUPT_H
+#define NATIVE_AVR_INTERRUPT_H
+
+#define ISR(vector, ...) extern "C" void vector(void)
+#define ISR_NAKED
+#define ISR_NOBLOCK
+
+inline void cli() {}
+inline void sei() {}
+
+#endif // NATIVE_AVR_INTERRUPT_H
@@ -0,0 +1,113 @@
+/*
+ * Register des ATmega2560 für den Host-Build
+ *
+ * Die Register sind gewöhnliche Variablen (definiert in
+ * arduino_native.cpp). Die Firmware schreibt sie wie auf dem Controller;
+ * der Simulator (sim.cpp) liest die Konfiguration von ADC, Timer5 und
+ * externen Interrupts daraus und setzt Messwerte und Zählerstände.
+ */
+
+#ifndef NATIVE_AVR_IO_H
+#define NATIVE_AVR_IO_H
+
+#include <stdint.h>
+
+#define _BV(bit) (1U << (bit))
+
+// Interrupt-Flag-Register: eine geschriebene 1 löscht das Bit wie auf
+// dem Controller; gesetzt wird nur vom Simulator über raise().
+struct HsFlagRegister {
+  volatile uint8_t bits;
+  operator uint8_t() const { return bits; }
+  HsFlagRegister& operator=(uint8_t value) { bits &= (uint8_t)~value; return *this; }
+  void raise(uint8_t mask) { bits |= mask; }
+};
+
+#define HS_REG8(name) extern volatile uint8_t name;
+#define HS_REG16(name) extern volatile uint16_t name;
+#define HS_FLAG8(name) extern HsFlagRegister name;
+
+// Status und Stack
+HS_REG8(SREG) HS_REG16(SP) HS_REG8(MCUSR) HS_REG8(SMCR)
+
+// ADC
+HS_REG8(ADMUX) HS_REG8(ADCSRA) HS_REG8(ADCSRB) HS_REG16(ADC) HS_REG8(DIDR0) HS_REG8(DIDR2)
+
+// Timer1, Timer3, Timer5
+HS_REG8(TCCR1A) HS_REG8(TCCR1B) HS_REG8(TCCR1C) HS_REG16(TCNT1) HS_REG8(TIMSK1) HS_FLAG8(TIFR1)
+HS_REG8(TCCR3A) HS_REG8(TCCR3B) HS_REG16(TCNT3) HS_REG16(OCR3A) HS_REG8(TIMSK3) HS_FLAG8(TIFR3)
+HS_REG8(TCCR5A) HS_REG8(TCCR5B) HS_REG8(TCCR5C) HS_REG16(TCNT5) HS_REG8(TIMSK5) HS_FLAG8(TIFR5)
+
+// Externe Interrupts
+HS_REG8(EICRA) HS_REG8(EICRB) HS_REG8(EIMSK) HS_FLAG8(EIFR)
+
+// TWI (nur für Vollständigkeit, die TWI-Queue ist im Host-Build ersetzt)
+HS_REG8(TWBR) HS_REG8(TWSR) HS_REG8(TWCR) HS_REG8(TWDR)
+
+#undef HS_REG8
+#undef HS_REG16
+#undef HS_FLAG8
+
+#define RAMSTART 0x200
+#define RAMEND 0x21FF
+
+// ADMUX, ADCSRA, ADCSRB
+#define REFS1 7
+#define REFS0 6
+#define ADLAR 5
+#define ADEN 7
+#define ADSC 6
+#define ADATE 5
+#define ADIF 4
+#define ADIE 3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+#define MUX5 3
+#define ADTS2 2
+#define ADTS1 1
+#define ADTS0 0
+
+// Timer
+#define CS10 0
+#define CS11 1
+#define CS12 2
+#define CS30 0
+#define CS31 1
+#define CS32 2
+#define CS50 0
+#define CS51 1
+#define CS52 2
+#define WGM12 3
+#define WGM32 3
+#define TOIE1 0
+#define TOV1 0
+#define OCIE3A 1
+#define OCF3A 1
+#define TOIE5 0
+#define TOV5 0
+
+// Externe Interrupts
+#define INT4 4
+#define INT5 5
+#define INTF4 4
+#define INTF5 5
+#define ISC40 0
+#define ISC41 1
+#define ISC50 2
+#define ISC51 3
+
+// TWI
+#define TWINT 7
+#define TWEA 6
+#define TWSTA 5
+#define TWSTO 4
+#define TWEN 2
+#define TWIE 0
+
+// Port-Bits
+#define PE4 4
+#define PE5 5
+#define PL2 2
+
+#endif // NATIVE_AVR_IO_H
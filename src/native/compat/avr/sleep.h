@@ -0,0 +1,21 @@
+/*
+ * Schlafmodi für den Host-Build
+ *
+ * sleep_cpu() schreibt die simulierte Zeit bis zum nächsten Timer0-Tick
+ * fort und ruft dabei die fälligen Interrupts auf (siehe sim.h).
+ */
+
+#ifndef NATIVE_AVR_SLEEP_H
+#define NATIVE_AVR_SLEEP_H
+
+#define SLEEP_MODE_IDLE 0
+
+void simSleep();
+
+inline void set_sleep_mode(int mode) { (void)mode; }
+inline void sleep_enable() {}
+inline void sleep_disable() {}
+inline void sleep_cpu() { simSleep(); }
+inline void sleep_mode() { simSleep(); }
+
+#endif // NATIVE_AVR_SLEEP_H
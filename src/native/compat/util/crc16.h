@@ -0,0 +1,26 @@
+/*
+ * CRC-Funktionen der avr-libc für den Host-Build (gleiche Ergebnisse)
+ */
+
+#ifndef NATIVE_UTIL_CRC16_H
+#define NATIVE_UTIL_CRC16_H
+
+#include <stdint.h>
+
+// CRC-16/XMODEM (Polynom 0x1021, MSB zuerst)
+static inline uint16_t _crc_xmodem_update(uint16_t crc, uint8_t data) {
+  crc ^= (uint16_t)data << 8;
+  for (uint8_t i = 0; i < 8; i++) {
+    crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+  }
+  return crc;
+}
+
+// CRC-CCITT in der Bitreihenfolge der avr-libc (LSB zuerst)
+static inline uint16_t _crc_ccitt_update(uint16_t crc, uint8_t data) {
+  data ^= (uint8_t)(crc & 0xFF);
+  data ^= data << 4;
+  return ((((uint16_t)data << 8) | (crc >> 8)) ^ (uint8_t)(data >> 4) ^ ((uint16_t)data << 3));
+}
+
+#endif // NATIVE_UTIL_CRC16_H
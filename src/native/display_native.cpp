@@ -0,0 +1,63 @@
+/*
+ * OLED-Display im Host-Build
+ *
+ * Ohne Adafruit_GFX kein Zeichnen: Die Funktionen aus display.h zählen
+ * nur die Aufrufe, damit der Display-Task im Benchmark vorhanden ist.
+ * Kosten des Zeichnens nur auf dem Controller messen (PERF_DISPLAY).
+ */
+
+#include "../display.h"
+
+static DisplayStats displayStats = {0, 0, 0, 0, 0, 0};
+static unsigned long lastFrameMs = 0;
+static bool frameStarted = false;
+
+bool initDisplay() {
+  DEBUG_PRINTLN(F("Host-Build: OLED-Display nicht simuliert"));
+  return true;
+}
+
+void clearDisplay() {}
+
+void updateDisplay() {
+  // Takt wie auf dem Controller: ein Bild alle OLED_UPDATE_INTERVAL ms
+  unsigned long now = millis();
+  if (frameStarted && now - lastFrameMs < OLED_UPDATE_INTERVAL) return;
+  lastFrameMs = now;
+  frameStarted = true;
+  displayStats.frames++;
+}
+
+void flushDisplay() {}
+
+bool isDisplayFlushPending() {
+  return false;
+}
+
+void getDisplayStats(DisplayStats* stats) {
+  *stats = displayStats;
+}
+
+void printDisplayStats() {
+  DEBUG_PRINT(F("Display (Host-Build, nicht simuliert): Bilder "));
+  DEBUG_PRINTLN(displayStats.frames);
+}
+
+void displayPage1_Status() {}
+void displayPage2_Temperature() {}
+void displayPage3_Environment() {}
+void displayPage4_Gas() {}
+void displayPage5_Audio() {}
+
+void displayTitle(const char* title) { (void)title; }
+void displayValue(int line, const char* label, float value, const char* unit) {
+  (void)line;
+  (void)label;
+  (void)value;
+  (void)unit;
+}
+void displayText(int line, const char* text) {
+  (void)line;
+  (void)text;
+}
+void nextDisplayPage() {}
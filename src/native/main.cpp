@@ -0,0 +1,200 @@
+/*
+ * Host-Benchmark: Firmware gegen den Hardware-Simulator
+ *
+ * Übersetzt den Sketch mit allen Modulen für den Host, lässt ihn eine
+ * vorgegebene simulierte Zeit laufen (Standard 24 h, wegen des
+ * Idle-Schlafs in Sekunden statt Stunden) und gibt die Rechenzeit je
+ * Scheduler-Task und je PERF_SCOPE-Abschnitt aus. Die Zeiten sind
+ * Host-Zeiten - zum Vergleichen von Änderungen, nicht als Laufzeit auf
+ * dem Mega; dafür die Messpunkte auf dem Controller (Befehl "perf").
+ *
+ * Mit aufgezeichneten Logs (MMDDhhmm.CSV, siehe sim_replay.h) als
+ * Eingang beginnt die Simulation bei deren erster Zeile und läuft
+ * standardmäßig bis zur letzten; --speed begrenzt die Geschwindigkeit
+ * (z.B. 1000 = tausendfache Echtzeit), um Vorfälle mit --serial
+ * mitzuverfolgen.
+ *
+ * Aufruf: program [--hours H] [--script DATEI] [--sd VERZEICHNIS]
+ *                 [--epoch UNIXZEIT] [--seed N] [--speed FAKTOR] [--serial]
+ *                 [LOGDATEI.CSV ...]
+ */
+
+#include "../HydroSentinel.ino"
+#include "sim.h"
+#include "sim_replay.h"
+#include "sim_script.h"
+#include <time.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+static const uint32_t BENCH_DEFAULT_EPOCH = 1750000000UL;   // 2025-06-15 15:06:40 UTC
+static const double BENCH_NS_PER_CYCLE = 1000.0 / (F_CPU / 1000000UL);
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static double hostSeconds() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// Mit --speed: auf die Host-Zeit warten, bis die simulierte Zeit fällig ist
+static double pace(double speed, uint64_t startUs, double hostStart) {
+  double wait = hostStart + (simMicros() - startUs) / 1e6 / speed - hostSeconds();
+  if (wait < 0.001) return 0.0;
+  struct timespec duration;
+  duration.tv_sec = (time_t)wait;
+  duration.tv_nsec = (long)((wait - duration.tv_sec) * 1e9);
+  nanosleep(&duration, NULL);
+  return wait;
+}
+
+static void printCostRow(const char* name, unsigned long count, uint64_t totalCycles,
+                         uint32_t maxCycles, double hostTotalSeconds) {
+  double totalNs = totalCycles * BENCH_NS_PER_CYCLE;
+  printf("%-16s %10lu %10.1f %10.2f", name, count, totalNs / 1e6,
+         count ? totalNs / count / 1000.0 : 0.0);
+  if (maxCycles) {
+    printf(" %10.1f", maxCycles * BENCH_NS_PER_CYCLE / 1000.0);
+  } else {
+    printf(" %10s", "-");
+  }
+  printf(" %6.1f%%\n", hostTotalSeconds > 0 ? totalNs / 1e7 / hostTotalSeconds : 0.0);
+}
+
+// Spaltenbreiten in Bytes: "ä" und "µ" sind in UTF-8 zwei Bytes lang
+static void printTasks(double hostTotalSeconds) {
+  printf("\n%-16s %11s %10s %11s %11s %7s\n", "Task", "Läufe", "Summe ms", "Mittel µs", "Max µs", "Anteil");
+  TaskStats stats;
+  for (uint8_t id = 0; schedulerGetStats(id, &stats); id++) {
+    printCostRow((const char*)schedulerTaskName(id), stats.runs, stats.totalCycles,
+                 stats.maxCycles, hostTotalSeconds);
+  }
+}
+
+static void printSections(double hostTotalSeconds) {
+  printf("\n%-16s %10s %10s %11s %11s %7s\n", "Abschnitt", "Aufrufe", "Summe ms", "Mittel µs", "Max µs", "Anteil");
+  PerfSectionStats stats;
+  for (uint8_t section = 0; perfGetStats(section, &stats); section++) {
+    // Das Zeichnen ist im Host-Build nicht simuliert (display_native.cpp)
+    if (section == PERF_DISPLAY) continue;
+    printCostRow((const char*)perfSectionName(section), stats.count, stats.totalCycles,
+                 stats.count ? stats.maxCycles : 0, hostTotalSeconds);
+  }
+  printf("(Abschnitte sind verschachtelt: LogDrain enthält SD-Write/SD-Sync, Logging reiht nur ein;\n"
+         " SystemCheck kann einen Zeitbudget-Sync enthalten; Display nur auf dem Controller messbar)\n");
+}
+
+static void printSimulation(double simHours, double hostTotalSeconds) {
+  SimStats sim;
+  simGetStats(&sim);
+  LogWriterStats log;
+  logWriterGetStats(&log);
+
+  printf("\nSimuliert: %.2f h in %.2f s Rechenzeit (Faktor %.0f)\n",
+         simHours, hostTotalSeconds, hostTotalSeconds > 0 ? simHours * 3600.0 / hostTotalSeconds : 0.0);
+  printf("Hardware: %llu ADC-Wandlungen, %lu DHT-Frames, %lu Geiger-Impulse, %lu SQW-Flanken\n",
+         sim.adcConversions, sim.dhtFrames, sim.radiationPulses, sim.sqwEdges);
+  printf("SD: %lu Zeilen, %lu Bytes, %lu Syncs, %lu Fehler\n",
+         log.rowsWritten, log.bytesWritten, log.syncs, log.errors);
+
+  SimReplayStats replay;
+  simReplayGetStats(&replay);
+  if (replay.files) {
+    printf("Wiedergabe: %lu Dateien, %lu Zeilen (%lu im alten 16-Spalten-Format), %lu übersprungen, "
+           "%lu ohne DHT-Wert\n",
+           replay.files, replay.rows, replay.legacyRows, replay.skippedRows, replay.dhtMissingRows);
+    if (replay.layoutErrors) {
+      printf("WARNUNG: %lu Zeilen mit unbekannter Spaltenzahl verworfen\n", replay.layoutErrors);
+    }
+  }
+}
+
+// ==============================================
+// HAUPTPROGRAMM
+// ==============================================
+
+int main(int argc, char** argv) {
+  double hours = 0;
+  const char* scriptPath = NULL;
+  const char* sdDirectory = "sd";
+  uint32_t epoch = 0;
+  uint32_t seed = 1;
+  double speed = 0;
+  bool serialOutput = false;
+  bool replay = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--hours") == 0 && i + 1 < argc) {
+      hours = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--script") == 0 && i + 1 < argc) {
+      scriptPath = argv[++i];
+    } else if (strcmp(argv[i], "--sd") == 0 && i + 1 < argc) {
+      sdDirectory = argv[++i];
+    } else if (strcmp(argv[i], "--epoch") == 0 && i + 1 < argc) {
+      epoch = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+      seed = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+      speed = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--serial") == 0) {
+      serialOutput = true;
+    } else if (argv[i][0] != '-') {
+      if (!simReplayAddFile(argv[i])) return 1;
+      replay = true;
+    } else {
+      printf("Aufruf: %s [--hours H] [--script DATEI] [--sd VERZEICHNIS] [--epoch UNIXZEIT] [--seed N]\n"
+             "       [--speed FAKTOR] [--serial] [LOGDATEI.CSV ...]\n", argv[0]);
+      return strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+  if (replay && scriptPath) {
+    fprintf(stderr, "--script und Log-Wiedergabe schließen sich aus\n");
+    return 1;
+  }
+  if (replay) {
+    if (!simReplayPrepare()) return 1;
+    if (epoch == 0) epoch = simReplayStartEpoch();
+    // Etwas über die letzte Zeile hinaus, damit sie noch geloggt wird
+    if (hours == 0) hours = simReplayHours() + 10.0 / 3600.0;
+  }
+  if (epoch == 0) epoch = BENCH_DEFAULT_EPOCH;
+  if (hours == 0) hours = 24.0;
+  if (hours < 0 || speed < 0) {
+    fprintf(stderr, "--hours und --speed müssen größer als 0 sein\n");
+    return 1;
+  }
+
+  hsNativeSdRoot(sdDirectory);
+  hsNativeSerialOutput(serialOutput);
+  simBegin(epoch, seed);
+  if (scriptPath) {
+    if (!simScriptLoad(scriptPath)) return 1;
+    simSetInputSource(simScriptInputs);
+  }
+  if (replay) simSetInputSource(simReplayInputs);
+
+  setup();
+  perfReset();   // Nur den Dauerbetrieb messen, nicht die Initialisierung
+
+  uint64_t startUs = simMicros();
+  uint64_t endUs = startUs + (uint64_t)(hours * 3600.0 * 1e6);
+  double start = hostSeconds();
+  double waited = 0;
+  while (simMicros() < endUs) {
+    loop();
+    if (speed > 0) waited += pace(speed, startUs, start);
+  }
+  double elapsed = hostSeconds() - start - waited;
+  logWriterClose();
+  fflush(stdout);
+
+  printTasks(elapsed);
+  printSections(elapsed);
+  printSimulation(hours, elapsed);
+  return 0;
+}
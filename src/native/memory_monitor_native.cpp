@@ -0,0 +1,28 @@
+/*
+ * Speicherüberwachung im Host-Build
+ *
+ * Stack-Painting und __brkval gibt es auf dem Host nicht; der ganze
+ * RAM des Mega gilt als frei, damit der System-Check nicht warnt.
+ * RAM-Belegung nur auf dem Controller messen (memory_monitor.cpp, hsmap).
+ */
+
+#include "../memory_monitor.h"
+#include "../utilities.h"
+
+static const uint16_t NATIVE_RAM_SIZE = RAMEND - RAMSTART + 1;
+
+unsigned int getFreeRAM() {
+  return NATIVE_RAM_SIZE;
+}
+
+void memoryMonitorScan() {}
+
+void memoryMonitorGetStats(MemoryStats* stats) {
+  memset(stats, 0, sizeof(*stats));
+  stats->margin = NATIVE_RAM_SIZE;
+}
+
+void memoryMonitorPrintStats() {
+  DEBUG_PRINTLN(F("=== SPEICHER ==="));
+  DEBUG_PRINTLN(F("Host-Build: keine Messung"));
+}
@@ -0,0 +1,160 @@
+/*
+ * SD-Karte als Verzeichnis des Host-Dateisystems
+ */
+
+#include <SD.h>
+#include <sys/stat.h>
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+struct NativeFileHandle {
+  FILE* file;
+  unsigned int references;
+};
+
+SDClass SD;
+
+static char sdRoot[256] = "sd";
+static unsigned long sdBytesWritten = 0;
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static void buildPath(const char* filename, char* path, size_t size) {
+  while (*filename == '/') filename++;
+  snprintf(path, size, "%s/%s", sdRoot, filename);
+}
+
+static void release(NativeFileHandle* handle) {
+  if (!handle) return;
+  if (--handle->references == 0) {
+    fclose(handle->file);
+    delete handle;
+  }
+}
+
+void hsNativeSdRoot(const char* directory) {
+  snprintf(sdRoot, sizeof(sdRoot), "%s", directory);
+}
+
+unsigned long hsNativeSdBytesWritten() {
+  return sdBytesWritten;
+}
+
+// ==============================================
+// SDCLASS
+// ==============================================
+
+bool SDClass::begin(uint8_t chipSelect) {
+  (void)chipSelect;
+  struct stat info;
+  if (stat(sdRoot, &info) == 0) return S_ISDIR(info.st_mode);
+  return mkdir(sdRoot, 0755) == 0;
+}
+
+bool SDClass::exists(const char* filename) {
+  char path[300];
+  buildPath(filename, path, sizeof(path));
+  struct stat info;
+  return stat(path, &info) == 0;
+}
+
+bool SDClass::remove(const char* filename) {
+  char path[300];
+  buildPath(filename, path, sizeof(path));
+  return ::remove(path) == 0;
+}
+
+File SDClass::open(const char* filename, uint8_t mode) {
+  char path[300];
+  buildPath(filename, path, sizeof(path));
+
+  // FILE_WRITE wie in der SD-Bibliothek: anlegen, lesen und am Ende anhängen
+  FILE* file = fopen(path, mode == FILE_WRITE ? "a+b" : "rb");
+  if (!file) return File();
+
+  NativeFileHandle* handle = new NativeFileHandle;
+  handle->file = file;
+  handle->references = 1;
+  return File(handle);
+}
+
+// ==============================================
+// FILE
+// ==============================================
+
+File::File(const File& other) : handle(other.handle) {
+  if (handle) handle->references++;
+}
+
+File& File::operator=(const File& other) {
+  if (other.handle) other.handle->references++;
+  release(handle);
+  handle = other.handle;
+  return *this;
+}
+
+File::~File() {
+  release(handle);
+}
+
+size_t File::write(uint8_t c) {
+  return write(&c, 1);
+}
+
+size_t File::write(const uint8_t* buffer, size_t size) {
+  if (!handle) return 0;
+  size_t written = fwrite(buffer, 1, size, handle->file);
+  sdBytesWritten += written;
+  return written;
+}
+
+int File::available() {
+  if (!handle) return 0;
+  long remaining = (long)size() - (long)position();
+  return remaining > 0 ? (int)remaining : 0;
+}
+
+int File::read() {
+  if (!handle) return -1;
+  int c = fgetc(handle->file);
+  return c == EOF ? -1 : c;
+}
+
+int File::peek() {
+  int c = read();
+  if (c >= 0) ungetc(c, handle->file);
+  return c;
+}
+
+int File::read(void* buffer, uint16_t length) {
+  if (!handle) return -1;
+  return (int)fread(buffer, 1, length, handle->file);
+}
+
+void File::flush() {
+  if (handle) fflush(handle->file);
+}
+
+bool File::seek(uint32_t position) {
+  return handle && fseek(handle->file, position, SEEK_SET) == 0;
+}
+
+uint32_t File::position() {
+  return handle ? (uint32_t)ftell(handle->file) : 0;
+}
+
+uint32_t File::size() {
+  if (!handle) return 0;
+  struct stat info;
+  fflush(handle->file);
+  return fstat(fileno(handle->file), &info) == 0 ? (uint32_t)info.st_size : 0;
+}
+
+void File::close() {
+  release(handle);
+  handle = NULL;
+}
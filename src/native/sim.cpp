@@ -0,0 +1,328 @@
+/*
+ * Implementierung des Hardware-Simulators
+ */
+
+#include "sim.h"
+#include "../config.h"
+#include "../adc_scanner.h"
+#include <Arduino.h>
+
+// Interrupt-Vektoren der Firmware (ISR() in adc_scanner, dht_driver, sensors, time_service)
+extern "C" void ADC_vect(void);
+extern "C" void INT4_vect(void);
+extern "C" void INT5_vect(void);
+extern "C" void TIMER5_OVF_vect(void);
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+static const uint64_t SIM_NEVER = ~0ULL;
+static const uint64_t SIM_SECOND_US = 1000000ULL;
+
+// DHT-Antwort: Sensor zieht die Leitung 30 µs nach dem Loslassen auf Low,
+// dann 80 µs Low + 80 µs High bis zum ersten Datenbit; jedes Bit 50 µs Low
+// plus 28 µs (0) bzw. 70 µs (1) High
+static const uint32_t DHT_RESPONSE_US = 30;
+static const uint32_t DHT_PREAMBLE_US = 160;
+static const uint32_t DHT_BIT_LOW_US = 50;
+static const uint32_t DHT_BIT_ZERO_US = 28;
+static const uint32_t DHT_BIT_ONE_US = 70;
+static const uint32_t DHT_MIN_START_US = 1000;
+static const uint8_t DHT_FRAME_EDGES = 42;
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static uint64_t simNowUs = 0;
+static uint32_t simStartEpoch = 0;
+static int64_t simEpochOffset = 0;
+static bool simSquareWave = false;
+
+static SimInputs simInputs;
+static SimInputSource simSource = NULL;
+static SimStats simStats;
+static uint32_t simRandomState = 1;
+
+// Nächste Ereignisse (SIM_NEVER = keines geplant)
+static uint64_t nextAdcUs = SIM_NEVER;
+static uint64_t nextSecondUs = 0;
+static uint64_t nextPulseUs = SIM_NEVER;
+static float pulseRate = 0;
+
+// Pins
+static uint8_t pinModes[NUM_DIGITAL_PINS];
+static uint8_t pinLevels[NUM_DIGITAL_PINS];
+
+// DHT-Frame in Übertragung
+static uint64_t dhtLowSinceUs = 0;
+static bool dhtHeldLow = false;
+static uint64_t dhtEdgeUs[DHT_FRAME_EDGES];
+static uint8_t dhtEdgeIndex = DHT_FRAME_EDGES;
+
+// ==============================================
+// ZUFALL
+// ==============================================
+
+static inline uint32_t nextRandom() {
+  // xorshift32
+  uint32_t x = simRandomState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  simRandomState = x;
+  return x;
+}
+
+static void schedulePulse() {
+  pulseRate = simInputs.radiationCps;
+  if (pulseRate <= 0) {
+    nextPulseUs = SIM_NEVER;
+    return;
+  }
+  // Exponentialverteilter Abstand eines Poisson-Prozesses
+  double uniform = (nextRandom() + 1.0) / 4294967297.0;
+  nextPulseUs = simNowUs + 1 + (uint64_t)(-log(uniform) / pulseRate * 1e6);
+}
+
+// ==============================================
+// EINGÄNGE
+// ==============================================
+
+static void setDefaultInputs(SimInputs* inputs) {
+  inputs->temperature = 21.5f;
+  inputs->humidity = 45.0f;
+  inputs->dhtPresent = true;
+  for (uint8_t i = 0; i < SIM_ADC_CHANNELS; i++) {
+    inputs->adc[i] = 300;
+    inputs->noise[i] = 3;
+  }
+  inputs->adc[adcScanChannel(LDR_PIN)] = 600;
+  inputs->adc[adcScanChannel(TDS_SENSOR_PIN)] = 350;
+  inputs->adc[adcScanChannel(MIC_KLEIN_PIN)] = 512;
+  inputs->adc[adcScanChannel(MIC_GROSS_PIN)] = 512;
+  inputs->noise[adcScanChannel(MIC_KLEIN_PIN)] = 40;
+  inputs->noise[adcScanChannel(MIC_GROSS_PIN)] = 60;
+  inputs->radiationCps = 0.3f;
+}
+
+static void updateInputs() {
+  if (simSource) simSource(simNowUs / 1000, &simInputs);
+  if (simInputs.radiationCps != pulseRate) schedulePulse();
+}
+
+uint16_t simAnalogSample(uint8_t channel) {
+  if (channel >= SIM_ADC_CHANNELS) return 0;
+  int32_t value = simInputs.adc[channel];
+  uint16_t noise = simInputs.noise[channel];
+  if (noise) value += (int32_t)(nextRandom() % (2U * noise + 1)) - noise;
+  return value < 0 ? 0 : (value > 1023 ? 1023 : (uint16_t)value);
+}
+
+const SimInputs* simGetInputs() {
+  return &simInputs;
+}
+
+// ==============================================
+// PERIPHERIE
+// ==============================================
+
+static inline bool adcFreeRunning() {
+  const uint8_t running = _BV(ADEN) | _BV(ADATE) | _BV(ADIE);
+  return (ADCSRA & running) == running;
+}
+
+static void adcConversion() {
+  uint8_t channel = (ADMUX & 0x07) | ((ADCSRB & _BV(MUX5)) ? 0x08 : 0);
+  ADC = simAnalogSample(channel);
+  simStats.adcConversions++;
+  ADC_vect();
+}
+
+static void radiationPulse() {
+  simStats.radiationPulses++;
+  // Externer Takt an T5 (CS5 = 110 oder 111)
+  if ((TCCR5B & 0x06) == 0x06 && ++TCNT5 == 0) {
+    if (TIMSK5 & _BV(TOIE5)) {
+      TIMER5_OVF_vect();
+    } else {
+      TIFR5.raise(_BV(TOV5));
+    }
+  }
+  schedulePulse();
+}
+
+static void secondTick() {
+  updateInputs();
+  if (simSquareWave && (EIMSK & _BV(INT5))) {
+    simStats.sqwEdges++;
+    INT5_vect();
+  }
+}
+
+// Bitfolge eines DHT-Frames aus den aktuellen Messgrößen
+static void buildDhtFrame(uint8_t data[5]) {
+  int16_t temperature = (int16_t)lround(simInputs.temperature * 10.0f);
+  uint16_t humidity = (uint16_t)lround(constrain(simInputs.humidity, 0.0f, 100.0f) * 10.0f);
+  uint16_t magnitude = temperature < 0 ? -temperature : temperature;
+
+  if (DHT_SENSOR_TYPE == 22) {
+    data[0] = humidity >> 8;
+    data[1] = humidity & 0xFF;
+    data[2] = ((magnitude >> 8) & 0x7F) | (temperature < 0 ? 0x80 : 0);
+    data[3] = magnitude & 0xFF;
+  } else {
+    data[0] = humidity / 10;
+    data[1] = humidity % 10;
+    data[2] = magnitude / 10;
+    data[3] = (magnitude % 10) | (temperature < 0 ? 0x80 : 0);
+  }
+  data[4] = data[0] + data[1] + data[2] + data[3];
+}
+
+static void startDhtFrame() {
+  uint8_t data[5];
+  buildDhtFrame(data);
+
+  uint64_t t = simNowUs + DHT_RESPONSE_US;
+  dhtEdgeUs[0] = t;
+  t += DHT_PREAMBLE_US;
+  dhtEdgeUs[1] = t;
+  for (uint8_t bit = 0; bit < 40; bit++) {
+    bool one = data[bit >> 3] & (0x80 >> (bit & 7));
+    t += DHT_BIT_LOW_US + (one ? DHT_BIT_ONE_US : DHT_BIT_ZERO_US);
+    dhtEdgeUs[bit + 2] = t;
+  }
+  dhtEdgeIndex = 0;
+  simStats.dhtFrames++;
+}
+
+static void dhtEdge() {
+  dhtEdgeIndex++;
+  if (EIMSK & _BV(INT4)) INT4_vect();
+}
+
+// ==============================================
+// ZEIT
+// ==============================================
+
+void simBegin(uint32_t startEpoch, uint32_t seed) {
+  simNowUs = 0;
+  simStartEpoch = startEpoch;
+  simEpochOffset = 0;
+  simSquareWave = false;
+  simRandomState = seed ? seed : 1;
+  memset(&simStats, 0, sizeof(simStats));
+  memset(pinModes, INPUT, sizeof(pinModes));
+  memset(pinLevels, LOW, sizeof(pinLevels));
+  dhtHeldLow = false;
+  dhtEdgeIndex = DHT_FRAME_EDGES;
+
+  setDefaultInputs(&simInputs);
+  nextAdcUs = SIM_NEVER;
+  nextSecondUs = SIM_SECOND_US;
+  pulseRate = 0;
+  updateInputs();
+}
+
+void simSetInputSource(SimInputSource source) {
+  simSource = source;
+  updateInputs();
+}
+
+uint64_t simMicros() {
+  return simNowUs;
+}
+
+void simAdvance(uint64_t us) {
+  uint64_t target = simNowUs + us;
+
+  // ADC starten/stoppen erfolgt nur außerhalb des Simulators
+  if (!adcFreeRunning()) {
+    nextAdcUs = SIM_NEVER;
+  } else if (nextAdcUs == SIM_NEVER) {
+    nextAdcUs = simNowUs + SIM_ADC_CONVERSION_US;
+  }
+
+  while (true) {
+    uint64_t dhtUs = dhtEdgeIndex < DHT_FRAME_EDGES ? dhtEdgeUs[dhtEdgeIndex] : SIM_NEVER;
+    uint64_t next = target;
+    if (nextAdcUs < next) next = nextAdcUs;
+    if (nextSecondUs < next) next = nextSecondUs;
+    if (nextPulseUs < next) next = nextPulseUs;
+    if (dhtUs < next) next = dhtUs;
+
+    simNowUs = next;
+    if (next == dhtUs) {
+      dhtEdge();
+    } else if (next == nextAdcUs) {
+      nextAdcUs += SIM_ADC_CONVERSION_US;
+      adcConversion();
+    } else if (next == nextPulseUs) {
+      radiationPulse();
+    } else if (next == nextSecondUs) {
+      nextSecondUs += SIM_SECOND_US;
+      secondTick();
+    }
+    if (next == target) break;
+  }
+}
+
+void simSleep() {
+  simAdvance(1000 - simNowUs % 1000);
+}
+
+uint32_t simEpoch() {
+  return (uint32_t)(simStartEpoch + simEpochOffset + (int64_t)(simNowUs / SIM_SECOND_US));
+}
+
+void simSetEpoch(uint32_t epoch) {
+  simEpochOffset = (int64_t)epoch - simStartEpoch - (int64_t)(simNowUs / SIM_SECOND_US);
+}
+
+void simSetSquareWave(bool enabled) {
+  simSquareWave = enabled;
+}
+
+void simGetStats(SimStats* stats) {
+  *stats = simStats;
+}
+
+// ==============================================
+// PINS
+// ==============================================
+
+void simPinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= NUM_DIGITAL_PINS) return;
+  pinModes[pin] = mode;
+  // Wie beim AVR schaltet INPUT_PULLUP das PORT-Bit ein, INPUT aus
+  if (mode != OUTPUT) pinLevels[pin] = mode == INPUT_PULLUP ? HIGH : LOW;
+
+  if (pin == DHT_SENSOR_PIN) {
+    if (mode == OUTPUT) {
+      dhtHeldLow = pinLevels[pin] == LOW;
+      dhtLowSinceUs = simNowUs;
+    } else if (dhtHeldLow) {
+      // Leitung nach dem Startimpuls losgelassen: Sensor antwortet
+      dhtHeldLow = false;
+      if (simNowUs - dhtLowSinceUs >= DHT_MIN_START_US && simInputs.dhtPresent) startDhtFrame();
+    }
+  }
+}
+
+void simDigitalWrite(uint8_t pin, uint8_t value) {
+  if (pin >= NUM_DIGITAL_PINS) return;
+  pinLevels[pin] = value ? HIGH : LOW;
+
+  if (pin == DHT_SENSOR_PIN && pinModes[pin] == OUTPUT) {
+    if (value == LOW && !dhtHeldLow) dhtLowSinceUs = simNowUs;
+    dhtHeldLow = value == LOW;
+  }
+}
+
+int simDigitalRead(uint8_t pin) {
+  if (pin >= NUM_DIGITAL_PINS) return LOW;
+  if (pinModes[pin] == OUTPUT) return pinLevels[pin];
+  return pinModes[pin] == INPUT_PULLUP ? HIGH : LOW;
+}
@@ -0,0 +1,132 @@
+/*
+ * Hardware-Simulator für den Host-Build
+ * Simulierte Zeit, Sensor-Eingänge und Interrupt-Quellen
+ *
+ * Die Firmware läuft unverändert gegen die Register aus avr/io.h; der
+ * Simulator spielt die Rolle der Peripherie:
+ *   - Zeit: millis()/micros() liefern die simulierte Zeit. Sie läuft nur
+ *     in delay() und sleep_cpu() weiter (Rechenzeit kostet keine
+ *     simulierte Zeit), sleep_cpu() endet am nächsten Timer0-Tick (1 ms).
+ *   - ADC: Im Free-Running-Modus alle 104 µs eine Wandlung des über
+ *     ADMUX/ADCSRB gewählten Kanals, Aufruf von ADC_vect.
+ *   - DHT: Loslassen der Datenleitung nach dem Startimpuls erzeugt die
+ *     42 fallenden Flanken eines Frames mit den Bitzeiten des Sensors
+ *     (INT4_vect).
+ *   - Geigerzähler: Poisson-Impulse erhöhen TCNT5 (TIMER5_OVF_vect).
+ *   - RTC: Sekundenflanke an INT5, solange der SQW-Ausgang der DS1307
+ *     eingeschaltet ist (siehe twi_queue_native.cpp).
+ * Die Messgrößen liefert eine Eingangsquelle, die einmal pro simulierter
+ * Sekunde abgefragt wird: Standardwerte, ein Skript (sim_script.h) oder
+ * aufgezeichnete Daten.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+const uint8_t SIM_ADC_CHANNELS = 16;
+const uint32_t SIM_ADC_CONVERSION_US = 104;  // 13 ADC-Takte bei Prescaler 128
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Aktuelle Messgrößen an den Sensoreingängen.
+ */
+struct SimInputs {
+  float temperature;                  ///< DHT-Temperatur (°C)
+  float humidity;                     ///< DHT-Luftfeuchtigkeit (%)
+  bool dhtPresent;                    ///< false: DHT antwortet nicht auf den Startimpuls
+  uint16_t adc[SIM_ADC_CHANNELS];     ///< Mittelwert je ADC-Kanal (0-1023)
+  uint16_t noise[SIM_ADC_CHANNELS];   ///< Gleichverteiltes Rauschen ± je Kanal
+  float radiationCps;                 ///< Geiger-Impulse pro Sekunde
+};
+
+/**
+ * @brief Eingangsquelle; passt die Messgrößen an die simulierte Zeit an.
+ *
+ * @param simMs Simulierte Zeit seit dem Start (ms)
+ * @param inputs Messgrößen, enthält beim Aufruf die bisherigen Werte
+ */
+typedef void (*SimInputSource)(uint64_t simMs, SimInputs* inputs);
+
+/**
+ * @brief Zähler der simulierten Hardware-Ereignisse.
+ */
+struct SimStats {
+  unsigned long long adcConversions;  ///< ADC-Wandlungen (ADC_vect)
+  unsigned long dhtFrames;            ///< Beantwortete DHT-Abfragen
+  unsigned long radiationPulses;      ///< Geiger-Impulse
+  unsigned long sqwEdges;             ///< RTC-Sekundenflanken (INT5_vect)
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Setzt Zeit, Zustand und Eingänge auf den Anfang.
+ *
+ * @param startEpoch Uhrzeit der RTC beim Start (Unix-Zeit, UTC)
+ * @param seed Startwert des Rauschgenerators
+ */
+void simBegin(uint32_t startEpoch, uint32_t seed);
+
+/**
+ * @brief Setzt die Eingangsquelle (NULL = feste Standardwerte).
+ */
+void simSetInputSource(SimInputSource source);
+
+/**
+ * @brief Simulierte Zeit seit dem Start in µs.
+ */
+uint64_t simMicros();
+
+/**
+ * @brief Schreibt die simulierte Zeit fort und löst fällige Ereignisse aus.
+ */
+void simAdvance(uint64_t us);
+
+/**
+ * @brief Idle-Schlaf: bis zum nächsten Timer0-Tick (volle ms).
+ */
+void simSleep();
+
+/**
+ * @brief Uhrzeit der simulierten RTC (Unix-Zeit, UTC).
+ */
+uint32_t simEpoch();
+
+/**
+ * @brief Stellt die simulierte RTC (Schreiben der DS1307-Zeitregister).
+ */
+void simSetEpoch(uint32_t epoch);
+
+/**
+ * @brief Schaltet den 1-Hz-SQW-Ausgang der simulierten RTC.
+ */
+void simSetSquareWave(bool enabled);
+
+// Pins (von pinMode(), digitalWrite(), digitalRead(), analogRead())
+void simPinMode(uint8_t pin, uint8_t mode);
+void simDigitalWrite(uint8_t pin, uint8_t value);
+int simDigitalRead(uint8_t pin);
+uint16_t simAnalogSample(uint8_t channel);
+
+/**
+ * @brief Aktuelle Messgrößen (nur lesen).
+ */
+const SimInputs* simGetInputs();
+
+/**
+ * @brief Liefert die Ereigniszähler.
+ */
+void simGetStats(SimStats* stats);
+
+#endif // SIM_H
@@ -0,0 +1,393 @@
+/*
+ * Implementierung der Log-Wiedergabe
+ */
+
+#include "sim_replay.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+// Firmware-Header erst danach: Arduino.h definiert min/max als Makros
+#include "../config.h"
+#include "../adc_scanner.h"
+#include "../data_logger.h"
+#include "../tds_converter.h"
+#include "../time_convert.h"
+
+// ==============================================
+// SPALTEN
+// ==============================================
+
+enum ReplayField {
+  FIELD_TEMPERATURE,
+  FIELD_HUMIDITY,
+  FIELD_LIGHT,
+  FIELD_MQ2,
+  FIELD_MQ135 = FIELD_MQ2 + MAX_GAS_SENSORS - 1,
+  FIELD_MIC1,
+  FIELD_MIC2,
+  FIELD_TDS,
+  FIELD_CPS,
+  FIELD_COUNT
+};
+
+static const char* const FIELD_NAMES[FIELD_COUNT] = {
+  "Temperature_DHT_C", "Humidity_RH", "Light_Level",
+  "MQ2", "MQ3", "MQ4", "MQ5", "MQ6", "MQ7", "MQ8", "MQ9", "MQ135",
+  "Mic1", "Mic2", "TDS", "Radiation_CPS"
+};
+
+static const uint8_t GAS_PINS[MAX_GAS_SENSORS] = {
+  MQ2_PIN, MQ3_PIN, MQ4_PIN, MQ5_PIN, MQ6_PIN, MQ7_PIN, MQ8_PIN, MQ9_PIN, MQ135_PIN
+};
+
+// Zeilen der Ausgangsversion: DateTime, Temperatur, Feuchte, MQ2..MQ135,
+// Mic1, Mic2, TDS, Geiger-Impulse des Zyklus (unter der 19-Spalten-Kopfzeile)
+static const uint8_t LEGACY_COLUMN_COUNT = 16;
+static const int8_t LEGACY_COLUMNS[LEGACY_COLUMN_COUNT] = {
+  -1, FIELD_TEMPERATURE, FIELD_HUMIDITY,
+  FIELD_MQ2, FIELD_MQ2 + 1, FIELD_MQ2 + 2, FIELD_MQ2 + 3, FIELD_MQ2 + 4,
+  FIELD_MQ2 + 5, FIELD_MQ2 + 6, FIELD_MQ2 + 7, FIELD_MQ135,
+  FIELD_MIC1, FIELD_MIC2, FIELD_TDS, FIELD_CPS
+};
+// LOGGING_INTERVAL der Ausgangsversion; die Uhrzeit der Zeilen hat nur
+// ganze Sekunden und taugt nicht zum Messen des Zyklus
+static const float LEGACY_CYCLE_SECONDS = 2.0f;
+
+static const uint8_t REPLAY_MAX_COLUMNS = 32;
+static const uint16_t REPLAY_LINE_LENGTH = 512;
+static const uint16_t MIC_CENTER = 512;            // Mittellage der Mikrofon-Module
+static const int16_t TDS_DEFAULT_TEMP_DECI = 250;  // readTDSSensor() ohne DHT-Wert
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+struct ReplayFile {
+  std::string path;
+  uint64_t firstMs;                   // Unix-Zeit der ersten/letzten Zeile in ms
+  uint64_t lastMs;
+};
+
+struct ReplayRow {
+  uint64_t timeMs;
+  float values[FIELD_COUNT];          // NAN = Spalte fehlt oder leer
+  bool legacy;                        // 16-Spalten-Zeile der Ausgangsversion
+};
+
+enum RowResult {
+  ROW_OK,
+  ROW_INVALID,                        // Uhrzeit fehlt oder unlesbar
+  ROW_UNKNOWN_LAYOUT                  // Spaltenzahl passt zu keinem Format
+};
+
+static std::vector<ReplayFile> replayFiles;
+static size_t replayFileIndex = 0;
+static FILE* replayInput = NULL;
+static int8_t replayColumns[REPLAY_MAX_COLUMNS];   // Spalte -> ReplayField, -1 = ungenutzt
+static uint8_t replayHeaderColumns = 0;            // Spaltenzahl der Kopfzeile
+static ReplayRow replayNext;
+static bool replayHaveNext = false;
+static SimReplayStats replayStats = {0, 0, 0, 0, 0, 0};
+
+// ==============================================
+// EINLESEN
+// ==============================================
+
+// Zerlegt eine Zeile an Kommas (in place), Zeilenende wird abgeschnitten
+static uint8_t splitLine(char* line, char* columns[REPLAY_MAX_COLUMNS]) {
+  line[strcspn(line, "\r\n")] = '\0';
+  uint8_t count = 0;
+  char* p = line;
+  while (count < REPLAY_MAX_COLUMNS) {
+    columns[count++] = p;
+    p = strchr(p, ',');
+    if (!p) break;
+    *p++ = '\0';
+  }
+  return count;
+}
+
+static void mapColumns(char* line) {
+  char* columns[REPLAY_MAX_COLUMNS];
+  uint8_t count = splitLine(line, columns);
+  replayHeaderColumns = count;
+  memset(replayColumns, -1, sizeof(replayColumns));
+  for (uint8_t column = 0; column < count; column++) {
+    for (uint8_t field = 0; field < FIELD_COUNT; field++) {
+      if (strcmp(columns[column], FIELD_NAMES[field]) == 0) replayColumns[column] = field;
+    }
+  }
+}
+
+// Spaltenaufteilung der aktuellen Firmware, falls eine Datei keinen Kopf hat
+static void mapDefaultColumns() {
+  char header[REPLAY_LINE_LENGTH];
+  formatCSVHeader(header, sizeof(header));
+  mapColumns(header);
+}
+
+// "2025-06-15 17:06:45 MESZ" und "61605.403" -> Unix-Zeit in ms
+static bool parseTime(const char* dateTime, const char* secondsOfDay, uint64_t* timeMs) {
+  unsigned year, month, day, hour, minute, second;
+  char zone[8];
+  if (sscanf(dateTime, "%u-%u-%u %u:%u:%u %7s", &year, &month, &day, &hour, &minute, &second, zone) != 7) {
+    return false;
+  }
+  int32_t offset;
+  if (strcmp(zone, "MESZ") == 0) {
+    offset = TZ_OFFSET_MESZ;
+  } else if (strcmp(zone, "MEZ") == 0) {
+    offset = TZ_OFFSET_MEZ;
+  } else {
+    return false;
+  }
+  if (year < 2000 || month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 59) {
+    return false;
+  }
+
+  CivilTime local;
+  local.year = year;
+  local.month = month;
+  local.day = day;
+  local.hour = hour;
+  local.minute = minute;
+  local.second = second;
+
+  unsigned millisecond = 0;
+  const char* dot = secondsOfDay ? strchr(secondsOfDay, '.') : NULL;
+  if (dot) millisecond = (unsigned)strtoul(dot + 1, NULL, 10) % 1000;
+
+  *timeMs = ((uint64_t)civilToEpoch(&local) - offset) * 1000ULL + millisecond;
+  return true;
+}
+
+// Die Kopfzeile gilt nur für Zeilen mit ebenso vielen Spalten
+static bool isLegacyRow(uint8_t count) {
+  return count == LEGACY_COLUMN_COUNT && count != replayHeaderColumns;
+}
+
+// Uhrzeit einer zerlegten Zeile; alte Zeilen haben keine Millisekunden
+static bool rowTime(char* columns[], uint8_t count, uint64_t* timeMs) {
+  if (count < 2) return false;
+  return parseTime(columns[0], isLegacyRow(count) ? NULL : columns[1], timeMs);
+}
+
+static RowResult parseRow(char* line, ReplayRow* row) {
+  char* columns[REPLAY_MAX_COLUMNS];
+  uint8_t count = splitLine(line, columns);
+  row->legacy = isLegacyRow(count);
+  if (!row->legacy && count != replayHeaderColumns) return ROW_UNKNOWN_LAYOUT;
+  if (!rowTime(columns, count, &row->timeMs)) return ROW_INVALID;
+
+  for (uint8_t field = 0; field < FIELD_COUNT; field++) row->values[field] = NAN;
+  for (uint8_t column = row->legacy ? 1 : 2; column < count; column++) {
+    int8_t field = row->legacy ? LEGACY_COLUMNS[column] : replayColumns[column];
+    if (field < 0 || columns[column][0] == '\0') continue;
+    char* end;
+    float value = strtof(columns[column], &end);
+    if (end != columns[column]) row->values[field] = value;
+  }
+
+  // Alte Zeilen zählen die Impulse eines Logging-Zyklus
+  if (row->legacy) row->values[FIELD_CPS] /= LEGACY_CYCLE_SECONDS;
+  return ROW_OK;
+}
+
+// Nächste gültige Zeile der offenen Datei; Kopfzeilen stellen die Spalten neu ein.
+// stats = NULL: verworfene Zeilen nicht zählen
+static bool readRow(FILE* file, ReplayRow* row, SimReplayStats* stats) {
+  char line[REPLAY_LINE_LENGTH];
+  while (fgets(line, sizeof(line), file)) {
+    if (strncmp(line, "DateTime,", 9) == 0) {
+      mapColumns(line);
+      continue;
+    }
+    if (line[0] == '#' || line[strspn(line, " \t\r\n")] == '\0') continue;   // Dateikopf
+    RowResult result = parseRow(line, row);
+    if (result == ROW_OK) return true;
+    if (!stats) continue;
+    if (result == ROW_UNKNOWN_LAYOUT) {
+      stats->layoutErrors++;
+    } else {
+      stats->skippedRows++;
+    }
+  }
+  return false;
+}
+
+// Zeit der letzten gültigen Zeile: nur das Dateiende lesen
+static bool lastRowTime(FILE* file, uint64_t* timeMs) {
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, size > 2048 ? size - 2048 : 0, SEEK_SET);
+  if (size > 2048) {
+    char partial[REPLAY_LINE_LENGTH];
+    if (!fgets(partial, sizeof(partial), file)) return false;   // angeschnittene Zeile
+  }
+
+  char line[REPLAY_LINE_LENGTH];
+  bool found = false;
+  while (fgets(line, sizeof(line), file)) {
+    char* columns[REPLAY_MAX_COLUMNS];
+    uint8_t count = splitLine(line, columns);
+    uint64_t t;
+    if (rowTime(columns, count, &t)) {
+      *timeMs = t;
+      found = true;
+    }
+  }
+  return found;
+}
+
+static bool openFile(size_t index) {
+  if (replayInput) fclose(replayInput);
+  replayInput = fopen(replayFiles[index].path.c_str(), "r");
+  if (!replayInput) {
+    perror(replayFiles[index].path.c_str());
+    return false;
+  }
+  mapDefaultColumns();
+  return true;
+}
+
+// Nächste Zeile über Dateigrenzen hinweg
+static bool advance() {
+  while (replayInput) {
+    if (readRow(replayInput, &replayNext, &replayStats)) return true;
+    fclose(replayInput);
+    replayInput = NULL;
+    while (++replayFileIndex < replayFiles.size() && !openFile(replayFileIndex)) {}
+  }
+  return false;
+}
+
+// ==============================================
+// SCHNITTSTELLE
+// ==============================================
+
+bool simReplayAddFile(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+  mapDefaultColumns();
+  ReplayFile entry;
+  entry.path = path;
+  ReplayRow first;
+  bool ok = readRow(file, &first, NULL) && lastRowTime(file, &entry.lastMs);
+  fclose(file);
+  if (!ok) {
+    fprintf(stderr, "%s: keine Zeile mit Uhrzeit\n", path);
+    return false;
+  }
+  entry.firstMs = first.timeMs;
+  replayFiles.push_back(entry);
+  replayStats.files++;
+  return true;
+}
+
+bool simReplayPrepare() {
+  if (replayFiles.empty()) return false;
+  // Dateinamen MMDDhhmm enthalten kein Jahr: nach der ersten Zeile sortieren
+  std::stable_sort(replayFiles.begin(), replayFiles.end(),
+                   [](const ReplayFile& a, const ReplayFile& b) { return a.firstMs < b.firstMs; });
+  replayFileIndex = 0;
+  replayHaveNext = openFile(0) && advance();
+  return replayHaveNext;
+}
+
+uint32_t simReplayStartEpoch() {
+  return replayFiles.empty() ? 0 : (uint32_t)(replayFiles.front().firstMs / 1000);
+}
+
+double simReplayHours() {
+  uint64_t firstMs = 0;
+  uint64_t lastMs = 0;
+  for (const ReplayFile& file : replayFiles) {
+    if (firstMs == 0 || file.firstMs < firstMs) firstMs = file.firstMs;
+    if (file.lastMs > lastMs) lastMs = file.lastMs;
+  }
+  return lastMs > firstMs ? (lastMs - firstMs) / 3600000.0 : 0.0;
+}
+
+static void setChannel(SimInputs* inputs, uint8_t pin, float value) {
+  if (isnan(value)) return;
+  uint8_t channel = adcScanChannel(pin);
+  inputs->adc[channel] = (uint16_t)constrain(lroundf(value), 0L, 1023L);
+  inputs->noise[channel] = 0;
+}
+
+static void setMicrophone(SimInputs* inputs, uint8_t pin, float peakToPeak) {
+  if (isnan(peakToPeak)) return;
+  uint8_t channel = adcScanChannel(pin);
+  inputs->adc[channel] = MIC_CENTER;
+  inputs->noise[channel] = (uint16_t)constrain(lroundf(peakToPeak / 2.0f), 0L, (long)MIC_CENTER);
+}
+
+// Kleinster ADC-Wert, der mindestens den aufgezeichneten ppm-Wert ergibt
+static uint16_t tdsPpmToCode(float ppm, int16_t tempDeci) {
+  uint16_t low = 0;
+  uint16_t high = 1023;
+  while (low < high) {
+    uint16_t middle = (low + high) / 2;
+    if (tdsCodeToPpmQ4(middle, tempDeci) < (uint32_t)(ppm * (1 << TDS_PPM_FRAC_BITS))) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+static void applyRow(const ReplayRow* row, SimInputs* inputs) {
+  const float* values = row->values;
+
+  if (!isnan(values[FIELD_TEMPERATURE]) && !isnan(values[FIELD_HUMIDITY])) {
+    // 0.0/0.0 schreibt die Firmware, wenn der DHT keinen gültigen Wert hatte
+    inputs->dhtPresent = values[FIELD_TEMPERATURE] != 0.0f || values[FIELD_HUMIDITY] != 0.0f;
+    if (inputs->dhtPresent) {
+      inputs->temperature = values[FIELD_TEMPERATURE];
+      inputs->humidity = values[FIELD_HUMIDITY];
+    } else {
+      replayStats.dhtMissingRows++;
+    }
+  }
+
+  setChannel(inputs, LDR_PIN, values[FIELD_LIGHT]);
+  for (uint8_t i = 0; i < MAX_GAS_SENSORS; i++) {
+    setChannel(inputs, GAS_PINS[i], values[FIELD_MQ2 + i]);
+  }
+  setMicrophone(inputs, MIC_KLEIN_PIN, values[FIELD_MIC1]);
+  setMicrophone(inputs, MIC_GROSS_PIN, values[FIELD_MIC2]);
+
+  if (!isnan(values[FIELD_TDS]) && values[FIELD_TDS] >= 0) {
+    int16_t tempDeci = inputs->dhtPresent ? (int16_t)lroundf(inputs->temperature * 10.0f) : TDS_DEFAULT_TEMP_DECI;
+    uint8_t channel = adcScanChannel(TDS_SENSOR_PIN);
+    inputs->adc[channel] = tdsPpmToCode(values[FIELD_TDS], tempDeci);
+    inputs->noise[channel] = 0;
+  }
+
+  if (!isnan(values[FIELD_CPS]) && values[FIELD_CPS] >= 0) {
+    inputs->radiationCps = values[FIELD_CPS];
+  }
+  replayStats.rows++;
+  if (row->legacy) replayStats.legacyRows++;
+}
+
+void simReplayInputs(uint64_t simMs, SimInputs* inputs) {
+  if (replayFiles.empty()) return;
+  uint64_t nowMs = (uint64_t)simReplayStartEpoch() * 1000ULL + simMs;
+  while (replayHaveNext && replayNext.timeMs <= nowMs) {
+    applyRow(&replayNext, inputs);
+    replayHaveNext = advance();
+  }
+}
+
+void simReplayGetStats(SimReplayStats* stats) {
+  *stats = replayStats;
+}
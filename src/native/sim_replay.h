@@ -0,0 +1,79 @@
+/*
+ * Wiedergabe aufgezeichneter CSV-Logs als Eingangsquelle des Simulators
+ *
+ * Liest MMDDhhmm.CSV-Dateien der Firmware (createLogFile/logSensorData)
+ * und setzt ab dem Zeitstempel jeder Zeile die Messgrößen des Simulators,
+ * so dass ADC-Scanner, DHT-Treiber und Geigerzähler-Eingang die
+ * aufgezeichneten Werte sehen und Filter, Alarme und Logging sie wie im
+ * Feld verarbeiten:
+ *   - Temperature_DHT_C/Humidity_RH -> DHT-Frame; 0.0/0.0 (kein gültiger
+ *     Wert beim Aufzeichnen) lässt den DHT nicht antworten
+ *   - Light_Level, MQ2..MQ135 -> ADC-Kanal ohne Rauschen
+ *   - Mic1/Mic2 (Spitze-Spitze) -> Rauschen ±P2P/2 um die Mittellage
+ *   - TDS (ppm) -> ADC-Wert über die Umkehrung von tdsCodeToPpm()
+ *   - Radiation_CPS -> Impulsrate
+ * Spalten werden über die Kopfzeile zugeordnet, fehlende Spalten lassen
+ * die Größe unverändert. Zeilen ohne gültige Uhrzeit werden übersprungen.
+ *
+ * Die Ausgangsversion der Firmware schrieb unter dieselbe Kopfzeile nur
+ * 16 Werte (ohne SecSinceMidnight-MS, Light_Level und Light_Percent) und
+ * in der letzten Spalte die Geiger-Impulse pro Logging-Zyklus statt pro
+ * Sekunde. Solche Zeilen werden an ihrer Spaltenzahl erkannt, nach
+ * Position zugeordnet und auf CPS umgerechnet. Zeilen, deren Spaltenzahl
+ * weder zur Kopfzeile noch zu diesem Format passt, werden gezählt und
+ * nicht angewendet.
+ *
+ * Mehrere Dateien werden nach ihrer ersten Zeile sortiert nacheinander
+ * gelesen (zeilenweise, auch Monate an Daten ohne großen Speicherbedarf);
+ * Lücken zwischen den Dateien halten die letzten Werte.
+ */
+
+#ifndef SIM_REPLAY_H
+#define SIM_REPLAY_H
+
+#include "sim.h"
+
+/**
+ * @brief Zähler der Wiedergabe.
+ */
+struct SimReplayStats {
+  unsigned long files;                ///< Angemeldete Dateien
+  unsigned long rows;                 ///< Angewendete Zeilen
+  unsigned long legacyRows;           ///< Davon im 16-Spalten-Format der Ausgangsversion
+  unsigned long skippedRows;          ///< Zeilen ohne Uhrzeit oder unlesbar
+  unsigned long layoutErrors;         ///< Zeilen mit unbekannter Spaltenzahl (verworfen)
+  unsigned long dhtMissingRows;       ///< Zeilen mit 0.0/0.0 (DHT ohne Antwort)
+};
+
+/**
+ * @brief Meldet eine Log-Datei an (liest nur erste und letzte Zeile).
+ *
+ * @return false wenn die Datei fehlt oder keine Zeile mit Uhrzeit enthält
+ */
+bool simReplayAddFile(const char* path);
+
+/**
+ * @brief Sortiert die Dateien und öffnet die erste.
+ *
+ * @return false ohne angemeldete Dateien
+ */
+bool simReplayPrepare();
+
+/**
+ * @brief Unix-Zeit (UTC) der ersten Zeile, Startzeit für simBegin().
+ */
+uint32_t simReplayStartEpoch();
+
+/**
+ * @brief Zeitspanne von der ersten bis zur letzten Zeile in Stunden.
+ */
+double simReplayHours();
+
+/**
+ * @brief Eingangsquelle für simSetInputSource().
+ */
+void simReplayInputs(uint64_t simMs, SimInputs* inputs);
+
+void simReplayGetStats(SimReplayStats* stats);
+
+#endif // SIM_REPLAY_H
@@ -0,0 +1,115 @@
+/*
+ * Implementierung der Skript-Eingangsquelle
+ */
+
+#include "sim_script.h"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+enum ScriptSignal {
+  SCRIPT_TEMPERATURE,
+  SCRIPT_HUMIDITY,
+  SCRIPT_ADC,
+  SCRIPT_NOISE,
+  SCRIPT_CPS
+};
+
+struct ScriptStep {
+  uint64_t timeMs;
+  ScriptSignal signal;
+  uint8_t channel;
+  float value;
+};
+
+static std::vector<ScriptStep> scriptSteps;
+static size_t scriptNext = 0;
+
+// ==============================================
+// LADEN
+// ==============================================
+
+static bool parseLine(const char* line, ScriptStep* step) {
+  double seconds;
+  char name[16];
+  int consumed;
+  if (sscanf(line, "%lf %15s %n", &seconds, name, &consumed) != 2 || seconds < 0) return false;
+  step->timeMs = (uint64_t)(seconds * 1000.0 + 0.5);
+  step->channel = 0;
+  const char* rest = line + consumed;
+
+  if (strcmp(name, "adc") == 0 || strcmp(name, "noise") == 0) {
+    unsigned int channel;
+    if (sscanf(rest, "%u %f", &channel, &step->value) != 2 || channel >= SIM_ADC_CHANNELS) return false;
+    step->signal = name[0] == 'a' ? SCRIPT_ADC : SCRIPT_NOISE;
+    step->channel = (uint8_t)channel;
+    return step->value >= 0 && step->value <= 1023;
+  }
+
+  if (sscanf(rest, "%f", &step->value) != 1) return false;
+  if (strcmp(name, "temp") == 0) {
+    step->signal = SCRIPT_TEMPERATURE;
+  } else if (strcmp(name, "hum") == 0) {
+    step->signal = SCRIPT_HUMIDITY;
+  } else if (strcmp(name, "cps") == 0) {
+    step->signal = SCRIPT_CPS;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool simScriptLoad(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    fprintf(stderr, "Skript %s nicht lesbar\n", path);
+    return false;
+  }
+
+  scriptSteps.clear();
+  scriptNext = 0;
+  char line[128];
+  unsigned int lineNumber = 0;
+  bool ok = true;
+  while (fgets(line, sizeof(line), file)) {
+    lineNumber++;
+    const char* p = line + strspn(line, " \t");
+    if (*p == '\0' || *p == '\n' || *p == '\r' || *p == '#') continue;
+
+    ScriptStep step;
+    if (!parseLine(p, &step)) {
+      fprintf(stderr, "%s:%u: ungültige Zeile\n", path, lineNumber);
+      ok = false;
+      break;
+    }
+    if (!scriptSteps.empty() && step.timeMs < scriptSteps.back().timeMs) {
+      fprintf(stderr, "%s:%u: Zeit nicht aufsteigend\n", path, lineNumber);
+      ok = false;
+      break;
+    }
+    scriptSteps.push_back(step);
+  }
+  fclose(file);
+  return ok;
+}
+
+// ==============================================
+// EINGANGSQUELLE
+// ==============================================
+
+void simScriptInputs(uint64_t simMs, SimInputs* inputs) {
+  while (scriptNext < scriptSteps.size() && scriptSteps[scriptNext].timeMs <= simMs) {
+    const ScriptStep* step = &scriptSteps[scriptNext++];
+    switch (step->signal) {
+      case SCRIPT_TEMPERATURE: inputs->temperature = step->value; break;
+      case SCRIPT_HUMIDITY: inputs->humidity = step->value; break;
+      case SCRIPT_ADC: inputs->adc[step->channel] = (uint16_t)step->value; break;
+      case SCRIPT_NOISE: inputs->noise[step->channel] = (uint16_t)step->value; break;
+      case SCRIPT_CPS: inputs->radiationCps = step->value; break;
+    }
+  }
+}
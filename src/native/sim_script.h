@@ -0,0 +1,32 @@
+/*
+ * Skript-Eingangsquelle für den Hardware-Simulator
+ *
+ * Textdatei mit einer Änderung pro Zeile, aufsteigend nach Zeit:
+ *   <Sekunde> temp <°C>
+ *   <Sekunde> hum <%>
+ *   <Sekunde> adc <Kanal> <Wert 0-1023>
+ *   <Sekunde> noise <Kanal> <Amplitude>
+ *   <Sekunde> cps <Impulse pro Sekunde>
+ * Ab der angegebenen Sekunde gilt der neue Wert (Sprung); Kanal 0-12
+ * entspricht A0-A12. Leerzeilen und Zeilen mit '#' werden übersprungen.
+ */
+
+#ifndef SIM_SCRIPT_H
+#define SIM_SCRIPT_H
+
+#include "sim.h"
+
+/**
+ * @brief Lädt ein Skript.
+ *
+ * @param path Pfad der Skriptdatei
+ * @return false wenn die Datei fehlt oder eine Zeile ungültig ist (Meldung auf stderr)
+ */
+bool simScriptLoad(const char* path);
+
+/**
+ * @brief Eingangsquelle für simSetInputSource().
+ */
+void simScriptInputs(uint64_t simMs, SimInputs* inputs);
+
+#endif // SIM_SCRIPT_H
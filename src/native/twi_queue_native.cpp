@@ -0,0 +1,154 @@
+/*
+ * TWI-Queue im Host-Build
+ *
+ * Gleiche Schnittstelle wie twi_queue.cpp, aber jede Anfrage wird sofort
+ * beim Einreihen gegen ein Gerätemodell ausgeführt (Status und Callback
+ * wie nach dem Abschluss im TWI-Interrupt):
+ *   - RTC_I2C_ADDRESS: DS1307 mit Registerzeiger; die Zeitregister folgen
+ *     der simulierten Uhr (simEpoch()), Schreiben stellt sie, Register 7
+ *     schaltet den SQW-Ausgang, 0x08-0x3F sind RAM.
+ *   - OLED_I2C_ADDRESS: nimmt alle Bytes an.
+ *   - Jede andere Adresse antwortet mit NACK.
+ */
+
+#include "../twi_queue.h"
+#include "../time_convert.h"
+#include "sim.h"
+
+// ==============================================
+// DS1307-MODELL
+// ==============================================
+
+static const uint8_t DS1307_REGISTERS = 0x40;
+static const uint8_t DS1307_TIME_REGISTERS = 7;
+static const uint8_t DS1307_REG_CONTROL = 0x07;
+static const uint8_t DS1307_SQWE = 0x10;
+
+static uint8_t rtcRegisters[DS1307_REGISTERS];
+static uint8_t rtcPointer = 0;
+
+static TwiStats twiStats = {0, 0, 0, 0, 0, 0};
+
+static uint8_t toBcd(uint8_t value) {
+  return ((value / 10) << 4) | (value % 10);
+}
+
+static uint8_t fromBcd(uint8_t value) {
+  return (value >> 4) * 10 + (value & 0x0F);
+}
+
+// Zeitregister aus der simulierten Uhr (24-Stunden-Modus, Uhr läuft)
+static void rtcLatchTime() {
+  uint32_t epoch = simEpoch();
+  CivilTime now;
+  epochToCivil(epoch, &now);
+  rtcRegisters[0] = toBcd(now.second);
+  rtcRegisters[1] = toBcd(now.minute);
+  rtcRegisters[2] = toBcd(now.hour);
+  rtcRegisters[3] = (uint8_t)((epoch / 86400UL + 4) % 7) + 1;   // 1 = Sonntag
+  rtcRegisters[4] = toBcd(now.day);
+  rtcRegisters[5] = toBcd(now.month);
+  rtcRegisters[6] = toBcd((uint8_t)(now.year - 2000));
+}
+
+static void rtcStoreTime() {
+  CivilTime time;
+  time.second = fromBcd(rtcRegisters[0] & 0x7F);
+  time.minute = fromBcd(rtcRegisters[1]);
+  time.hour = fromBcd(rtcRegisters[2] & 0x3F);
+  time.day = fromBcd(rtcRegisters[4]);
+  time.month = fromBcd(rtcRegisters[5]);
+  time.year = 2000 + fromBcd(rtcRegisters[6]);
+  simSetEpoch(civilToEpoch(&time));
+}
+
+static bool rtcTransfer(const uint8_t* data, uint16_t length, uint8_t* readData, uint8_t readLength) {
+  rtcLatchTime();
+
+  // Erstes Schreibbyte setzt den Registerzeiger, weitere Bytes schreiben
+  bool timeWritten = false;
+  for (uint16_t i = 0; i < length; i++) {
+    if (i == 0) {
+      rtcPointer = data[0] % DS1307_REGISTERS;
+      continue;
+    }
+    if (rtcPointer < DS1307_TIME_REGISTERS) timeWritten = true;
+    rtcRegisters[rtcPointer] = data[i];
+    rtcPointer = (rtcPointer + 1) % DS1307_REGISTERS;
+  }
+  if (timeWritten) rtcStoreTime();
+  simSetSquareWave((rtcRegisters[DS1307_REG_CONTROL] & DS1307_SQWE) != 0);
+
+  for (uint8_t i = 0; i < readLength; i++) {
+    readData[i] = rtcRegisters[rtcPointer];
+    rtcPointer = (rtcPointer + 1) % DS1307_REGISTERS;
+  }
+  return true;
+}
+
+// ==============================================
+// QUEUE
+// ==============================================
+
+void twiBegin() {
+  memset(rtcRegisters, 0, sizeof(rtcRegisters));
+  rtcPointer = 0;
+}
+
+bool twiSubmit(TwiRequest* request, bool highPriority) {
+  (void)highPriority;
+  if (request->status == TWI_STATUS_PENDING) return false;
+
+  bool ok;
+  if (request->address == RTC_I2C_ADDRESS) {
+    ok = rtcTransfer(request->writeData, request->writeLength, request->readData, request->readLength);
+  } else {
+    ok = request->address == OLED_I2C_ADDRESS;
+  }
+
+  if (ok) {
+    // Mit TWI_FLAG_CHUNKED steht das Präfix vor jedem Teil
+    uint16_t prefixBytes = 0;
+    if (request->flags & TWI_FLAG_PREFIX) {
+      prefixBytes = (request->flags & TWI_FLAG_CHUNKED)
+          ? (request->writeLength + TWI_CHUNK_SIZE - 1) / TWI_CHUNK_SIZE : 1;
+    }
+    twiStats.completed++;
+    twiStats.bytes += request->writeLength + prefixBytes + request->readLength;
+  } else {
+    twiStats.errors++;
+  }
+
+  request->position = request->writeLength;
+  request->status = ok ? TWI_STATUS_DONE : TWI_STATUS_ERROR;
+  if (request->callback) request->callback(request);
+  return true;
+}
+
+bool twiWait(TwiRequest* request) {
+  return request->status == TWI_STATUS_DONE;
+}
+
+bool twiTransfer(TwiRequest* request, bool highPriority) {
+  return twiSubmit(request, highPriority) && twiWait(request);
+}
+
+bool twiIsIdle() {
+  return true;
+}
+
+void twiPoll() {}
+
+void twiGetStats(TwiStats* stats) {
+  *stats = twiStats;
+}
+
+void twiPrintStats() {
+  DEBUG_PRINTLN(F("=== I2C ==="));
+  DEBUG_PRINT(F("Anfragen: "));
+  DEBUG_PRINT(twiStats.completed);
+  DEBUG_PRINT(F(", Fehler: "));
+  DEBUG_PRINT(twiStats.errors);
+  DEBUG_PRINT(F(", Bytes: "));
+  DEBUG_PRINTLN(twiStats.bytes);
+}
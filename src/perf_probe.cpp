@@ -0,0 +1,199 @@
+/*
+ * Implementierung der Laufzeitmessung
+ */
+
+#include "perf_probe.h"
+#include <Arduino.h>
+
+#if PERF_ENABLED
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+static const char PERF_NAME_SENSORS[] PROGMEM = "Sensoren";
+static const char PERF_NAME_LOGGING[] PROGMEM = "Logging";
+static const char PERF_NAME_LOG_DRAIN[] PROGMEM = "LogDrain";
+static const char PERF_NAME_SD_WRITE[] PROGMEM = "SD-Write";
+static const char PERF_NAME_SD_SYNC[] PROGMEM = "SD-Sync";
+static const char PERF_NAME_DISPLAY[] PROGMEM = "Display";
+static const char PERF_NAME_SYSTEM_CHECK[] PROGMEM = "SystemCheck";
+
+static const char* const PERF_NAMES[] PROGMEM = {
+  PERF_NAME_SENSORS,
+  PERF_NAME_LOGGING,
+  PERF_NAME_LOG_DRAIN,
+  PERF_NAME_SD_WRITE,
+  PERF_NAME_SD_SYNC,
+  PERF_NAME_DISPLAY,
+  PERF_NAME_SYSTEM_CHECK,
+};
+
+static_assert(sizeof(PERF_NAMES) / sizeof(PERF_NAMES[0]) == PERF_SECTION_COUNT,
+              "Jeder Abschnitt braucht einen Namen");
+static_assert(PERF_HISTOGRAM_BUCKETS >= 2 && PERF_HISTOGRAM_MIN_SHIFT + PERF_HISTOGRAM_BUCKETS <= 33,
+              "Histogrammklassen müssen in 32 Bit passen");
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+volatile uint16_t perfOverflows = 0;
+
+static PerfSectionStats perfStats[PERF_SECTION_COUNT];
+static uint32_t perfOverheadCycles = 0;
+
+// ==============================================
+// TIMER1
+// ==============================================
+
+ISR(TIMER1_OVF_vect) {
+  perfOverflows++;
+}
+
+void perfBegin() {
+  noInterrupts();
+  TCCR1A = 0;                         // Normal-Modus, keine Ausgänge
+  TCCR1B = 0;
+  TCCR1C = 0;
+  TCNT1 = 0;
+  perfOverflows = 0;
+  TIFR1 = _BV(TOV1);                  // Anstehenden Überlauf löschen
+  TIMSK1 = _BV(TOIE1);                // Nur Überlauf-Interrupt
+  TCCR1B = _BV(CS10);                 // CPU-Takt ohne Vorteiler
+  interrupts();
+
+  // Eigenzeit eines leeren Messpunkts: kleinster Wert aus mehreren Versuchen
+  uint32_t overhead = 0xFFFFFFFFUL;
+  for (uint8_t i = 0; i < 8; i++) {
+    uint32_t start = perfCycles();
+    uint32_t cycles = perfCycles() - start;
+    if (cycles < overhead) overhead = cycles;
+  }
+  perfOverheadCycles = overhead;
+
+  perfReset();
+}
+
+// ==============================================
+// AUFZEICHNUNG
+// ==============================================
+
+// Histogrammklasse über die Bitlänge der Dauer
+static inline uint8_t bucketFor(uint32_t cycles) {
+  uint8_t bits = cycles ? 32 - __builtin_clzl(cycles) : 0;
+  if (bits <= PERF_HISTOGRAM_MIN_SHIFT) return 0;
+  uint8_t bucket = bits - PERF_HISTOGRAM_MIN_SHIFT;
+  return bucket < PERF_HISTOGRAM_BUCKETS ? bucket : PERF_HISTOGRAM_BUCKETS - 1;
+}
+
+void perfRecord(uint8_t section, uint32_t cycles) {
+  if (section >= PERF_SECTION_COUNT) return;
+  PerfSectionStats* stats = &perfStats[section];
+
+  cycles = cycles > perfOverheadCycles ? cycles - perfOverheadCycles : 0;
+  stats->count++;
+  stats->totalCycles += cycles;
+  if (cycles < stats->minCycles) stats->minCycles = cycles;
+  if (cycles > stats->maxCycles) stats->maxCycles = cycles;
+
+  uint16_t* slot = &stats->histogram[bucketFor(cycles)];
+  if (*slot < 0xFFFF) (*slot)++;
+}
+
+void perfReset() {
+  memset(perfStats, 0, sizeof(perfStats));
+  for (uint8_t i = 0; i < PERF_SECTION_COUNT; i++) {
+    perfStats[i].minCycles = 0xFFFFFFFFUL;
+  }
+}
+
+bool perfGetStats(uint8_t section, PerfSectionStats* stats) {
+  if (section >= PERF_SECTION_COUNT || !stats) return false;
+  *stats = perfStats[section];
+  return true;
+}
+
+// ==============================================
+// AUSGABE
+// ==============================================
+
+static inline unsigned long cyclesToMicros(uint32_t cycles) {
+  return cycles / (F_CPU / 1000000UL);
+}
+
+static uint32_t meanCycles(const PerfSectionStats* stats) {
+  return stats->count ? (uint32_t)(stats->totalCycles / stats->count) : 0;
+}
+
+const __FlashStringHelper* perfSectionName(uint8_t section) {
+  if (section >= PERF_SECTION_COUNT) return NULL;
+  return (const __FlashStringHelper*)pgm_read_ptr(&PERF_NAMES[section]);
+}
+
+void perfPrintReport() {
+  Serial.println(F("=== LAUFZEITEN (µs) ==="));
+  for (uint8_t i = 0; i < PERF_SECTION_COUNT; i++) {
+    const PerfSectionStats* stats = &perfStats[i];
+    Serial.print(perfSectionName(i));
+    Serial.print(F(": n="));
+    Serial.print(stats->count);
+    if (stats->count == 0) {
+      Serial.println();
+      continue;
+    }
+    Serial.print(F(", min "));
+    Serial.print(cyclesToMicros(stats->minCycles));
+    Serial.print(F(", Mittel "));
+    Serial.print(cyclesToMicros(meanCycles(stats)));
+    Serial.print(F(", max "));
+    Serial.println(cyclesToMicros(stats->maxCycles));
+
+    // Nur belegte Klassen, jeweils mit Obergrenze in µs
+    Serial.print(F("  "));
+    for (uint8_t b = 0; b < PERF_HISTOGRAM_BUCKETS; b++) {
+      if (stats->histogram[b] == 0) continue;
+      if (b == PERF_HISTOGRAM_BUCKETS - 1) {
+        Serial.print(F(">="));
+        Serial.print(cyclesToMicros(1UL << (PERF_HISTOGRAM_MIN_SHIFT + b - 1)));
+      } else {
+        Serial.print('<');
+        Serial.print(cyclesToMicros(1UL << (PERF_HISTOGRAM_MIN_SHIFT + b)));
+      }
+      Serial.print(':');
+      Serial.print(stats->histogram[b]);
+      Serial.print(' ');
+    }
+    Serial.println();
+  }
+}
+
+void perfPrintCsv() {
+  Serial.print(F("#perf,cpu_hz="));
+  Serial.print(F_CPU);
+  Serial.print(F(",min_shift="));
+  Serial.print(PERF_HISTOGRAM_MIN_SHIFT);
+  Serial.print(F(",buckets="));
+  Serial.println(PERF_HISTOGRAM_BUCKETS);
+
+  for (uint8_t i = 0; i < PERF_SECTION_COUNT; i++) {
+    const PerfSectionStats* stats = &perfStats[i];
+    Serial.print(F("perf,"));
+    Serial.print(perfSectionName(i));
+    Serial.print(',');
+    Serial.print(stats->count);
+    Serial.print(',');
+    Serial.print(stats->count ? stats->minCycles : 0);
+    Serial.print(',');
+    Serial.print(stats->maxCycles);
+    Serial.print(',');
+    Serial.print(meanCycles(stats));
+    for (uint8_t b = 0; b < PERF_HISTOGRAM_BUCKETS; b++) {
+      Serial.print(',');
+      Serial.print(stats->histogram[b]);
+    }
+    Serial.println();
+  }
+}
+
+#endif // PERF_ENABLED
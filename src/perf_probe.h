@@ -0,0 +1,161 @@
+/*
+ * Laufzeitmessung für das Umweltkontrollsystem
+ * Zyklengenaue Messpunkte mit Histogramm je Programmabschnitt
+ *
+ * Timer1 läuft frei mit dem CPU-Takt (Vorteiler 1, 62,5 ns); sein
+ * Überlauf-Interrupt erweitert ihn auf 32 Bit (Überlauf nach ca. 268 s).
+ * PERF_SCOPE(NAME) misst vom Anlegen bis zum Verlassen des umgebenden
+ * Blocks und trägt die Dauer in die Statistik des Abschnitts ein:
+ * Anzahl, Minimum, Maximum, Mittelwert und ein Histogramm mit
+ * Zweierpotenz-Klassen. Die Eigenzeit eines leeren Messpunkts (Zähler
+ * zweimal lesen) wird bei perfBegin() bestimmt und von jeder Messung
+ * abgezogen; das Eintragen läuft erst nach dem Ende der Messung.
+ * Messpunkte nur außerhalb von Interrupts verwenden. Ausgabe auf die
+ * seriellen Befehle "perf" (Text) und "perf csv" (maschinenlesbar), siehe
+ * serial_command.h. Ohne PERF_ENABLED erzeugen die Messpunkte keinen Code
+ * und Timer1 bleibt frei. Im Host-Build (HS_NATIVE, siehe native/) zählen
+ * sie die Rechenzeit des Hosts in derselben Einheit (16 Zyklen je µs).
+ */
+
+#ifndef PERF_PROBE_H
+#define PERF_PROBE_H
+
+#include "config.h"
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+// Gemessene Abschnitte (Namen in perf_probe.cpp)
+enum PerfSection : uint8_t {
+  PERF_SENSORS,             ///< performSensorReadings()
+  PERF_LOGGING,             ///< performDataLogging()
+  PERF_LOG_DRAIN,           ///< drainLogQueue() (Formatieren + Schreiben)
+  PERF_SD_WRITE,            ///< File::write() eines Sektorpuffers
+  PERF_SD_SYNC,             ///< File::flush()
+  PERF_DISPLAY,             ///< updateDisplay()
+  PERF_SYSTEM_CHECK,        ///< runSystemCheck()
+  PERF_SECTION_COUNT
+};
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Statistik eines Abschnitts (alle Zeiten in CPU-Zyklen).
+ *
+ * Histogrammklasse 0: < 2^PERF_HISTOGRAM_MIN_SHIFT Zyklen, Klasse k:
+ * [2^(MIN_SHIFT+k-1), 2^(MIN_SHIFT+k)), die letzte Klasse nimmt alles
+ * Längere auf. Die Zähler sättigen bei 65535.
+ */
+struct PerfSectionStats {
+  unsigned long count;      ///< Anzahl Messungen
+  uint32_t minCycles;       ///< Kürzeste Messung
+  uint32_t maxCycles;       ///< Längste Messung
+  uint64_t totalCycles;     ///< Summe für den Mittelwert
+  uint16_t histogram[PERF_HISTOGRAM_BUCKETS];
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+#if PERF_ENABLED
+
+extern volatile uint16_t perfOverflows;
+
+/**
+ * @brief Startet Timer1 als Zyklenzähler und kalibriert die Messkosten.
+ */
+void perfBegin();
+
+/**
+ * @brief Liefert den 32-Bit-Zyklenzähler (auch bei gesperrten Interrupts).
+ */
+#ifdef HS_NATIVE
+uint32_t perfCycles();    // Host-Build: Rechenzeit des Hosts (native/arduino_native.cpp)
+#else
+static inline uint32_t perfCycles() {
+  uint8_t sreg = SREG;
+  cli();
+  uint16_t low = TCNT1;
+  uint16_t high = perfOverflows;
+  // Überlauf bereits passiert, aber ISR wegen Sperre noch nicht gelaufen?
+  if ((TIFR1 & _BV(TOV1)) && low < 0x8000) {
+    high++;
+  }
+  SREG = sreg;
+  return ((uint32_t)high << 16) | low;
+}
+#endif
+
+/**
+ * @brief Trägt eine Messung ein.
+ *
+ * @param section PERF_*
+ * @param cycles Gemessene Dauer in Zyklen (einschließlich Messkosten)
+ */
+void perfRecord(uint8_t section, uint32_t cycles);
+
+/**
+ * @brief Messpunkt für die Lebensdauer des Objekts (siehe PERF_SCOPE).
+ */
+class PerfScope {
+public:
+  explicit PerfScope(uint8_t section) : section(section), start(perfCycles()) {}
+  ~PerfScope() { perfRecord(section, perfCycles() - start); }
+
+private:
+  uint8_t section;
+  uint32_t start;
+};
+
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+#define PERF_SCOPE(name) PerfScope PERF_CONCAT(perfScope, __LINE__)(PERF_##name)
+
+/**
+ * @brief Setzt alle Abschnitte zurück.
+ */
+void perfReset();
+
+/**
+ * @brief Liefert die Statistik eines Abschnitts.
+ *
+ * @return false bei ungültigem Abschnitt
+ */
+bool perfGetStats(uint8_t section, PerfSectionStats* stats);
+
+/**
+ * @brief Liefert den Namen eines Abschnitts (Flash-String).
+ */
+const __FlashStringHelper* perfSectionName(uint8_t section);
+
+/**
+ * @brief Gibt alle Abschnitte lesbar in µs aus (Befehl "perf").
+ */
+void perfPrintReport();
+
+/**
+ * @brief Gibt alle Abschnitte als CSV-Zeilen in Zyklen aus (Befehl "perf csv").
+ *
+ * Erste Zeile "#perf,cpu_hz=...,min_shift=...,buckets=...", danach pro
+ * Abschnitt "perf,Name,count,min,max,mean,h0,...,hN".
+ */
+void perfPrintCsv();
+
+#else
+
+#define PERF_SCOPE(name) do {} while (0)
+
+inline void perfBegin() {}
+inline void perfReset() {}
+inline bool perfGetStats(uint8_t, PerfSectionStats*) { return false; }
+inline const __FlashStringHelper* perfSectionName(uint8_t) { return NULL; }
+inline void perfPrintReport() {}
+inline void perfPrintCsv() {}
+
+#endif // PERF_ENABLED
+
+#endif // PERF_PROBE_H
@@ -0,0 +1,170 @@
+/*
+ * Implementierung des abtastenden Profilers
+ */
+
+#include "profiler.h"
+#include <Arduino.h>
+
+#if PROFILER_ENABLED
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+// Timer3 im CTC-Modus mit Vorteiler 8 (2 MHz bei 16 MHz)
+static const uint16_t PROFILER_TIMER_TOP = (F_CPU / 8 / PROFILER_SAMPLE_HZ) - 1;
+
+static_assert(F_CPU / 8 / PROFILER_SAMPLE_HZ <= 65536, "PROFILER_SAMPLE_HZ zu klein für Timer3");
+static_assert(PROFILER_SAMPLE_HZ <= 4000, "Mehr als 4 kHz kostet zu viel Rechenzeit");
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+// Nur im Timer3-Interrupt geschrieben; Leser sperren die Interrupts
+static uint16_t profilerBins[PROFILER_BINS];
+static ProfilerStats profilerStats = {0, 0, 0};
+
+// ==============================================
+// ABTASTUNG
+// ==============================================
+
+// Sortiert eine Rücksprungadresse ein (Wortadresse wie auf dem Stack)
+extern "C" void profilerRecordSample(uint32_t wordAddress) __attribute__((used));
+
+extern "C" void profilerRecordSample(uint32_t wordAddress) {
+  profilerStats.samples++;
+  uint32_t bin = (wordAddress << 1) >> PROFILER_BIN_SHIFT;
+  if (bin >= PROFILER_BINS) {
+    profilerStats.outside++;
+    return;
+  }
+
+  if (++profilerBins[bin] == 0xFFFF) {
+    for (uint16_t i = 0; i < PROFILER_BINS; i++) {
+      profilerBins[i] >>= 1;
+    }
+    if (profilerStats.halvings < 0xFF) profilerStats.halvings++;
+  }
+}
+
+// Ohne Prolog: Nur so liegt die Rücksprungadresse an einer bekannten
+// Stelle. Gesichert wird, was eine normale Funktion verändern darf
+// (r0, r1, r18-r27, r30, r31, SREG); profilerRecordSample() benutzt
+// weder RAMPZ noch EIND.
+ISR(TIMER3_COMPA_vect, ISR_NAKED) {
+  __asm__ __volatile__(
+    "push r0\n\t"
+    "in r0, __SREG__\n\t"
+    "push r0\n\t"
+    "push r1\n\t"
+    "clr r1\n\t"
+    "push r18\n\t"
+    "push r19\n\t"
+    "push r20\n\t"
+    "push r21\n\t"
+    "push r22\n\t"
+    "push r23\n\t"
+    "push r24\n\t"
+    "push r25\n\t"
+    "push r26\n\t"
+    "push r27\n\t"
+    "push r30\n\t"
+    "push r31\n\t"
+    // 15 gesicherte Bytes; darüber die Rücksprungadresse, höchstwertiges Byte zuerst
+    "in r30, __SP_L__\n\t"
+    "in r31, __SP_H__\n\t"
+    "ldd r24, Z+16\n\t"
+    "ldd r23, Z+17\n\t"
+    "ldd r22, Z+18\n\t"
+    "clr r25\n\t"
+    "call profilerRecordSample\n\t"
+    "pop r31\n\t"
+    "pop r30\n\t"
+    "pop r27\n\t"
+    "pop r26\n\t"
+    "pop r25\n\t"
+    "pop r24\n\t"
+    "pop r23\n\t"
+    "pop r22\n\t"
+    "pop r21\n\t"
+    "pop r20\n\t"
+    "pop r19\n\t"
+    "pop r18\n\t"
+    "pop r1\n\t"
+    "pop r0\n\t"
+    "out __SREG__, r0\n\t"
+    "pop r0\n\t"
+    "reti\n\t"
+  );
+}
+
+// ==============================================
+// STEUERUNG
+// ==============================================
+
+void profilerBegin() {
+  profilerReset();
+
+  noInterrupts();
+  TCCR3A = 0;
+  TCCR3B = 0;
+  TCNT3 = 0;
+  OCR3A = PROFILER_TIMER_TOP;
+  TIFR3 = _BV(OCF3A);                 // Anstehenden Vergleich löschen
+  TIMSK3 = _BV(OCIE3A);
+  TCCR3B = _BV(WGM32) | _BV(CS31);    // CTC bis OCR3A, Vorteiler 8
+  interrupts();
+}
+
+void profilerReset() {
+  noInterrupts();
+  memset(profilerBins, 0, sizeof(profilerBins));
+  profilerStats.samples = 0;
+  profilerStats.outside = 0;
+  profilerStats.halvings = 0;
+  interrupts();
+}
+
+void profilerGetStats(ProfilerStats* stats) {
+  noInterrupts();
+  *stats = profilerStats;
+  interrupts();
+}
+
+// ==============================================
+// AUSGABE
+// ==============================================
+
+void profilerPrint() {
+  ProfilerStats stats;
+  profilerGetStats(&stats);
+
+  Serial.print(F("#prof,hz="));
+  Serial.print(PROFILER_SAMPLE_HZ);
+  Serial.print(F(",shift="));
+  Serial.print(PROFILER_BIN_SHIFT);
+  Serial.print(F(",bins="));
+  Serial.print(PROFILER_BINS);
+  Serial.print(F(",samples="));
+  Serial.print(stats.samples);
+  Serial.print(F(",outside="));
+  Serial.print(stats.outside);
+  Serial.print(F(",halvings="));
+  Serial.println(stats.halvings);
+
+  for (uint16_t i = 0; i < PROFILER_BINS; i++) {
+    noInterrupts();
+    uint16_t count = profilerBins[i];
+    interrupts();
+    if (count == 0) continue;
+
+    Serial.print(F("prof,"));
+    Serial.print((uint32_t)i << PROFILER_BIN_SHIFT, HEX);
+    Serial.print(',');
+    Serial.println(count);
+  }
+  Serial.println(F("#prof,end"));
+}
+
+#endif // PROFILER_ENABLED
@@ -0,0 +1,76 @@
+/*
+ * Abtastender Profiler für das Umweltkontrollsystem
+ * Programmzähler-Histogramm über die gesamte Firmware (auch Bibliotheken)
+ *
+ * Timer3 löst mit PROFILER_SAMPLE_HZ einen Interrupt aus, der die
+ * Rücksprungadresse (= unterbrochener Programmzähler, 3 Byte auf dem
+ * ATmega2560) vom Stack liest und in ein Histogramm einsortiert: Klasse
+ * = Byteadresse >> PROFILER_BIN_SHIFT. Erreicht eine Klasse 65535, werden
+ * alle halbiert - die Anteile bleiben erhalten.
+ * Der Befehl "prof" gibt die belegten Klassen als Textzeilen aus;
+ * tools/hsprof ordnet sie über die Symboltabelle der ELF-Datei
+ * (avr-nm) Funktionen zu und druckt ein flaches Profil. Zeit im
+ * Idle-Schlaf erscheint dabei bei schedulerRun().
+ * Die Abtastrate ist bewusst kein Teiler der Task-Perioden, damit der
+ * Profiler nicht immer dieselbe Stelle eines periodischen Tasks trifft.
+ * Ohne PROFILER_ENABLED bleibt Timer3 frei und es entsteht kein Code.
+ */
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "config.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Zähler des Profilers.
+ */
+struct ProfilerStats {
+  unsigned long samples;    ///< Abtastungen gesamt
+  unsigned long outside;    ///< Adressen oberhalb der Histogramm-Abdeckung
+  uint8_t halvings;         ///< Wie oft das Histogramm halbiert wurde
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+#if PROFILER_ENABLED
+
+/**
+ * @brief Startet Timer3 und damit die Abtastung.
+ */
+void profilerBegin();
+
+/**
+ * @brief Löscht Histogramm und Zähler.
+ */
+void profilerReset();
+
+/**
+ * @brief Liefert eine konsistente Kopie der Zähler.
+ */
+void profilerGetStats(ProfilerStats* stats);
+
+/**
+ * @brief Gibt das Histogramm aus (Befehl "prof").
+ *
+ * Erste Zeile "#prof,hz=...,shift=...,bins=...,samples=...,outside=...,halvings=...",
+ * danach pro belegter Klasse "prof,<Startadresse hex>,<Anzahl>" und
+ * zum Schluss "#prof,end".
+ */
+void profilerPrint();
+
+#else
+
+inline void profilerBegin() {}
+inline void profilerReset() {}
+inline void profilerGetStats(ProfilerStats* stats) { *stats = ProfilerStats(); }
+inline void profilerPrint() {}
+
+#endif // PROFILER_ENABLED
+
+#endif // PROFILER_H
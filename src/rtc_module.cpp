@@ -3,98 +3,194 @@
  */
 
 #include "rtc_module.h"
+#include "twi_queue.h"
+#include "trace.h"
 #include <Arduino.h>
 
+// ==============================================
+// DS1307-REGISTER
+// ==============================================
+
+static const uint8_t DS1307_REG_SECONDS = 0x00;   // Sekunden (Bit 7 = Clock Halt)
+static const uint8_t DS1307_REG_CONTROL = 0x07;   // SQW-Steuerung
+static const uint8_t DS1307_SQW_1HZ = 0x10;       // SQWE = 1, RS = 00
+static const uint8_t DS1307_CLOCK_HALT = 0x80;
+static const uint8_t DS1307_TIME_REGISTERS = 7;
+
 // ==============================================
 // GLOBALE VARIABLEN
 // ==============================================
 
-RTC_DS1307 rtcClock;
+static const uint8_t rtcReadPointer = DS1307_REG_SECONDS;
+static uint8_t rtcRaw[DS1307_TIME_REGISTERS];
+static TwiRequest rtcReadRequest = {
+  RTC_I2C_ADDRESS, 0, 0, &rtcReadPointer, 1, rtcRaw, DS1307_TIME_REGISTERS, NULL, TWI_STATUS_IDLE, 0
+};
+static bool rtcRunning = false;
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static uint8_t bcdToBin(uint8_t value) {
+  return (value >> 4) * 10 + (value & 0x0F);
+}
+
+static uint8_t binToBcd(uint8_t value) {
+  return ((value / 10) << 4) | (value % 10);
+}
+
+// Schreibt Register ab startRegister (blockierend, nur selten benutzt)
+static bool rtcWriteRegisters(const uint8_t* data, uint8_t length) {
+  TwiRequest request = { RTC_I2C_ADDRESS, 0, 0, data, length, NULL, 0, NULL, TWI_STATUS_IDLE, 0 };
+  return twiTransfer(&request, true);
+}
+
+// Monatsname aus __DATE__ ("Jan", "Feb", ...) -> 1-12
+static uint8_t monthFromName(const char* name) {
+  static const char MONTHS[] PROGMEM = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  for (uint8_t i = 0; i < 12; i++) {
+    if (name[0] == (char)pgm_read_byte(&MONTHS[i * 3]) &&
+        name[1] == (char)pgm_read_byte(&MONTHS[i * 3 + 1]) &&
+        name[2] == (char)pgm_read_byte(&MONTHS[i * 3 + 2])) {
+      return i + 1;
+    }
+  }
+  return 1;
+}
+
+static uint8_t twoDigits(const char* text) {
+  uint8_t high = (text[0] >= '0' && text[0] <= '9') ? text[0] - '0' : 0;
+  return high * 10 + (text[1] - '0');
+}
 
 // ==============================================
 // RTC INITIALISIERUNG
 // ==============================================
 
 bool initRTC() {
-  DEBUG_PRINTLN(F("Initialisiere RTC..."));
+  TRACE(RTC_INIT);
   
-  Wire.begin();
-  rtcClock.begin();
+  twiBegin();
   
-  if (!rtcClock.isrunning()) {
-    DEBUG_PRINTLN(F("WARNUNG: RTC läuft nicht! Setze Compile-Zeit..."));
+  RTCData currentTime;
+  readRTCData(&currentTime);
+  if (rtcReadRequest.status != TWI_STATUS_DONE) {
+    TRACE(RTC_NO_RESPONSE);
+    return false;
+  }
+  
+  if (!rtcRunning) {
+    TRACE(RTC_STOPPED);
     setRTCFromCompileTime();
     return false;
   }
   
-  DEBUG_PRINTLN(F("RTC erfolgreich initialisiert."));
-  printCurrentTime();
+  TRACE(RTC_READY);
+  printRTCData(&currentTime);
   return true;
 }
 
 bool isRTCRunning() {
-  return rtcClock.isrunning();
+  return rtcRunning;
 }
 
 void setRTCTime(int year, byte month, byte day, byte hour, byte minute, byte second) {
-  DateTime newTime(year, month, day, hour, minute, second);
-  rtcClock.adjust(newTime);
-  
-  DEBUG_PRINT(F("RTC Zeit gesetzt: "));
-  DEBUG_PRINT(year);
-  DEBUG_PRINT('-');
-  DEBUG_PRINT(month);
-  DEBUG_PRINT('-');
-  DEBUG_PRINT(day);
-  DEBUG_PRINT(' ');
-  DEBUG_PRINT(hour);
-  DEBUG_PRINT(':');
-  DEBUG_PRINT(minute);
-  DEBUG_PRINT(':');
-  DEBUG_PRINTLN(second);
+  // Wochentag 1-7 (1 = Sonntag), 1970-01-01 war ein Donnerstag
+  uint8_t weekday = (uint8_t)((daysFromCivil(year, month, day) + 4) % 7) + 1;
+  uint8_t data[8] = {
+    DS1307_REG_SECONDS,
+    binToBcd(second),            // Clock-Halt-Bit gelöscht: Uhr läuft
+    binToBcd(minute),
+    binToBcd(hour),              // 24-Stunden-Modus
+    weekday,
+    binToBcd(day),
+    binToBcd(month),
+    binToBcd((uint8_t)(year - 2000))
+  };
+  if (!rtcWriteRegisters(data, sizeof(data))) {
+    TRACE(RTC_SET_FAILED);
+    return;
+  }
+  rtcRunning = true;
+  
+  TRACE(RTC_TIME_SET, (unsigned long)year * 10000UL + month * 100U + day, hour, minute, second);
 }
 
 void setRTCFromCompileTime() {
-  // Setzt RTC auf Compile-Zeit des Sketches
-  rtcClock.adjust(DateTime(F(__DATE__), F(__TIME__)));
+  // Setzt RTC auf Compile-Zeit des Sketches (__DATE__ = "Mmm dd yyyy", __TIME__ = "hh:mm:ss")
+  const char* date = __DATE__;
+  const char* time = __TIME__;
+  setRTCTime(2000 + twoDigits(date + 9), monthFromName(date), twoDigits(date + 4),
+             twoDigits(time), twoDigits(time + 3), twoDigits(time + 6));
   DEBUG_PRINTLN(F("RTC auf Compile-Zeit gesetzt."));
 }
 
+bool rtcEnableSquareWave() {
+  uint8_t data[2] = { DS1307_REG_CONTROL, DS1307_SQW_1HZ };
+  return rtcWriteRegisters(data, sizeof(data));
+}
+
 // ==============================================
 // ZEIT LESEN/SCHREIBEN
 // ==============================================
 
-bool readRTCData(RTCData* data) {
+bool rtcStartRead() {
+  return twiSubmit(&rtcReadRequest, true);
+}
+
+uint8_t rtcReadStatus() {
+  return rtcReadRequest.status;
+}
+
+bool rtcGetReadResult(RTCData* data) {
   if (!data) return false;
   
-  DateTime now = rtcClock.now();
+  if (rtcReadRequest.status != TWI_STATUS_DONE) {
+    memset(data, 0, sizeof(*data));
+    return false;
+  }
   
-  data->year = now.year();
-  data->month = now.month();
-  data->day = now.day();
-  data->hour = now.hour();
-  data->minute = now.minute();
-  data->second = now.second();
-  data->timestamp = now.unixtime();
+  // BCD-Register dekodieren (12-Stunden-Modus wird mit berücksichtigt)
+  rtcRunning = (rtcRaw[0] & DS1307_CLOCK_HALT) == 0;
+  data->second = bcdToBin(rtcRaw[0] & 0x7F);
+  data->minute = bcdToBin(rtcRaw[1] & 0x7F);
+  if (rtcRaw[2] & 0x40) {
+    data->hour = bcdToBin(rtcRaw[2] & 0x1F) % 12 + ((rtcRaw[2] & 0x20) ? 12 : 0);
+  } else {
+    data->hour = bcdToBin(rtcRaw[2] & 0x3F);
+  }
+  data->day = bcdToBin(rtcRaw[4] & 0x3F);
+  data->month = bcdToBin(rtcRaw[5] & 0x1F);
+  data->year = 2000 + bcdToBin(rtcRaw[6]);
+  data->millisecond = 0;
   
-  // Erweiterte Validierung: RTC läuft UND Zeit ist plausibel
-  bool rtcRunning = isRTCRunning();
-  bool timeValid = (data->year >= 2020 && data->year <= 2030 && 
-                   data->hour >= 0 && data->hour <= 23 &&
-                   data->minute >= 0 && data->minute <= 59);
+  // Erweiterte Validierung: RTC läuft UND Zeit ist plausibel (Jahre der
+  // Umstellungstabelle, wie isTimeValid())
+  bool timeValid = (data->year >= TZ_TABLE_FIRST_YEAR && data->year <= TZ_TABLE_LAST_YEAR &&
+                   data->month >= 1 && data->month <= 12 &&
+                   data->day >= 1 && data->day <= 31 &&
+                   data->hour <= 23 && data->minute <= 59 && data->second <= 59);
   
+  CivilTime civil = { (uint16_t)data->year, data->month, data->day, data->hour, data->minute, data->second };
+  data->timestamp = timeValid ? civilToEpoch(&civil) : 0;
   data->isValid = rtcRunning && timeValid;
-  
-  //DEBUG_PRINT(F("RTC: Running="));
-  //DEBUG_PRINT(rtcRunning);
-  //DEBUG_PRINT(F(", TimeValid="));
-  //DEBUG_PRINT(timeValid);
-  //DEBUG_PRINT(F(", Year="));
-  //DEBUG_PRINTLN(data->year);
-  
   return data->isValid;
 }
 
+bool readRTCData(RTCData* data) {
+  if (!data) return false;
+  
+  // Eine laufende Anfrage (Zeitdienst) erst abschließen lassen
+  twiWait(&rtcReadRequest);
+  if (!rtcStartRead()) {
+    memset(data, 0, sizeof(*data));
+    return false;
+  }
+  twiWait(&rtcReadRequest);
+  return rtcGetReadResult(data);
+}
+
 void printRTCData(const RTCData* data) {
   if (!data->isValid) {
     DEBUG_PRINTLN(F("RTC: Ungültige Zeit"));
@@ -125,7 +221,7 @@ void printCurrentTime() {
   if (readRTCData(&currentTime)) {
     printRTCData(&currentTime);
   } else {
-    DEBUG_PRINTLN(F("FEHLER: Kann aktuelle Zeit nicht lesen!"));
+    TRACE(RTC_READ_FAILED);
   }
 }
 
@@ -169,13 +265,13 @@ void formatTimestamp(const RTCData* data, char* buffer, byte bufferSize) {
 // ==============================================
 
 unsigned long getRTCTimestamp() {
-  DateTime now = rtcClock.now();
-  return now.unixtime();
+  RTCData currentTime;
+  return readRTCData(&currentTime) ? currentTime.timestamp : 0;
 }
 
 bool isTimeValid(const RTCData* data) {
   return data->isValid && 
-         data->year >= 2020 && data->year <= 2099 &&
+         data->year >= TZ_TABLE_FIRST_YEAR && data->year <= TZ_TABLE_LAST_YEAR &&
          data->month >= 1 && data->month <= 12 &&
          data->day >= 1 && data->day <= 31 &&
          data->hour <= 23 && data->minute <= 59 && data->second <= 59;
@@ -187,45 +283,27 @@ bool isTimeValid(const RTCData* data) {
 // ==============================================
 
 bool isDST(int year, int month, int day, int hour) {
-  // Vereinfachte MESZ-Berechnung für Europa
-  // MESZ: letzter Sonntag März 02:00 bis letzter Sonntag Oktober 03:00
-  
-  if (month < 3 || month > 10) return false; // Jan, Feb, Nov, Dez = MEZ
-  if (month > 3 && month < 10) return true;  // Apr-Sep = MESZ
-  
-  // März und Oktober: genauer berechnen
-  int lastSunday;
-  if (month == 3) {
-    // Letzter Sonntag im März
-    lastSunday = 31 - ((5 * year / 4 + 4) % 7);
-    return (day > lastSunday || (day == lastSunday && hour >= 2));
-  } else { // Oktober
-    // Letzter Sonntag im Oktober
-    lastSunday = 31 - ((5 * year / 4 + 1) % 7);
-    return (day < lastSunday || (day == lastSunday && hour < 3));
-  }
+  // Umstellungszeitpunkte aus der Tabelle (time_convert.h), keine Kalenderregel
+  if (year < 1970) return false;
+  CivilTime utc = { (uint16_t)year, (uint8_t)month, (uint8_t)day, (uint8_t)hour, 0, 0 };
+  bool summerTime;
+  localOffsetSeconds(civilToEpoch(&utc), &summerTime);
+  return summerTime;
 }
 
-void adjustUTCToLocal(RTCData* data) {
-  // Konvertiert UTC zu lokaler Zeit (MEZ/MESZ)
-  if (!data || !data->isValid) return;
-  
-  int offset = isDST(data->year, data->month, data->day, data->hour) ? 2 : 1; // MESZ = +2, MEZ = +1
-  
-  data->hour += offset;
-  if (data->hour >= 24) {
-    data->hour -= 24;
-    data->day++;
-    // Vereinfachte Datumsberechnung (für die meisten Fälle ausreichend)
-    if (data->day > 31) {
-      data->day = 1;
-      data->month++;
-      if (data->month > 12) {
-        data->month = 1;
-        data->year++;
-      }
-    }
-  }
+bool adjustUTCToLocal(RTCData* data) {
+  // Konvertiert UTC zu lokaler Zeit (MEZ/MESZ) über den Unix-Timestamp
+  if (!data || !data->isValid) return false;
+
+  CivilTime local;
+  bool summerTime = epochToLocal(data->timestamp, &local);
+  data->year = local.year;
+  data->month = local.month;
+  data->day = local.day;
+  data->hour = local.hour;
+  data->minute = local.minute;
+  data->second = local.second;
+  return summerTime;
 }
 
 void formatLocalDateTime(const RTCData* data, char* buffer, int bufferSize) {
@@ -234,12 +312,10 @@ void formatLocalDateTime(const RTCData* data, char* buffer, int bufferSize) {
     return;
   }
   
-  RTCData localTime = *data;
-  adjustUTCToLocal(&localTime);
-  
-  const char* timezone = isDST(data->year, data->month, data->day, data->hour) ? "MESZ" : "MEZ";
+  CivilTime local;
+  const char* timezone = epochToLocal(data->timestamp, &local) ? "MESZ" : "MEZ";
   
   snprintf(buffer, bufferSize, "%04d-%02d-%02d %02d:%02d:%02d %s",
-           localTime.year, localTime.month, localTime.day,
-           localTime.hour, localTime.minute, localTime.second, timezone);
+           local.year, local.month, local.day,
+           local.hour, local.minute, local.second, timezone);
 }
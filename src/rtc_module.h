@@ -1,13 +1,18 @@
 /*
  * RTC-Modul für das Umweltkontrollsystem
  * Verwaltet Echtzeituhren-Funktionen
+ *
+ * Eigener DS1307-Treiber über die TWI-Queue (twi_queue.h). Die Register
+ * werden als Anfrage hoher Priorität gelesen - blockierend nur über
+ * readRTCData() (Start/Diagnose), im Betrieb asynchron über
+ * rtcStartRead()/rtcGetReadResult() (Zeitdienst).
  */
 
 #ifndef RTC_MODULE_H
 #define RTC_MODULE_H
 
-#include "RTClib.h"
 #include "config.h"
+#include "time_convert.h"
 
 // ==============================================
 // RTC DATENSTRUKTUREN
@@ -26,16 +31,11 @@ struct RTCData {
   byte hour;                   ///< Stunde (0-23)
   byte minute;                 ///< Minute (0-59)
   byte second;                 ///< Sekunde (0-59)
+  uint16_t millisecond;        ///< Millisekunden (0-999), nur über den Zeitdienst (time_service.h), sonst 0
   unsigned long timestamp;     ///< Unix-Timestamp (Sekunden seit 1.1.1970)
   bool isValid;                ///< true wenn RTC-Daten gültig und verfügbar sind
 };
 
-// ==============================================
-// RTC OBJEKT
-// ==============================================
-
-extern RTC_DS1307 rtcClock;   ///< Globales RTC-Objekt für DS1307 Echtzeituhren-Chip
-
 // ==============================================
 // FUNKTIONS-DEKLARATIONEN
 // ==============================================
@@ -44,7 +44,7 @@ extern RTC_DS1307 rtcClock;   ///< Globales RTC-Objekt für DS1307 Echtzeituhren
 /**
  * @brief Initialisiert das RTC-Modul (DS1307 Echtzeituhren-Chip).
  *
- * Startet die I2C-Kommunikation mit dem RTC-Chip und prüft dessen
+ * Startet die TWI-Queue, liest den RTC-Chip und prüft dessen
  * Funktionsfähigkeit. Setzt bei Bedarf die Zeit auf Compile-Zeit.
  *
  * @return true wenn RTC erfolgreich initialisiert wurde, false bei Hardware-Fehlern
@@ -52,12 +52,12 @@ extern RTC_DS1307 rtcClock;   ///< Globales RTC-Objekt für DS1307 Echtzeituhren
 bool initRTC();
 
 /**
- * @brief Prüft, ob das RTC-Modul läuft und gültige Zeit liefert.
+ * @brief Prüft, ob das RTC-Modul läuft.
  *
- * Überprüft den internen Status des RTC-Chips und die Gültigkeit
- * der aktuellen Zeitangaben.
+ * Wertet das Clock-Halt-Bit des zuletzt gelesenen Sekundenregisters aus
+ * (kein eigener Buszugriff).
  *
- * @return true wenn RTC aktiv und funktionsfähig ist, false bei Problemen
+ * @return true wenn die letzte Abfrage erfolgreich war und die Uhr läuft
  */
 bool isRTCRunning();
 
@@ -89,13 +89,43 @@ void setRTCFromCompileTime();
  * @brief Liest die aktuelle Zeit vom RTC-Modul.
  *
  * Holt die aktuellen Datum- und Zeitinformationen vom RTC-Chip
- * und füllt die bereitgestellte RTCData-Struktur.
+ * und füllt die bereitgestellte RTCData-Struktur. Wartet auf den
+ * Abschluss der I2C-Anfrage - im Betrieb timeServiceNow() verwenden.
  *
  * @param data Zeiger auf RTCData-Struktur für die gelesenen Zeitdaten
  * @return true wenn Zeit erfolgreich gelesen wurde, false bei RTC-Fehlern
  */
 bool readRTCData(RTCData* data);
 
+/**
+ * @brief Stellt eine Leseanfrage der Zeitregister in die TWI-Queue (hohe Priorität).
+ *
+ * @return false wenn noch eine Leseanfrage läuft oder die Queue voll ist
+ */
+bool rtcStartRead();
+
+/**
+ * @brief Status der letzten Leseanfrage.
+ *
+ * @return TWI_STATUS_PENDING, TWI_STATUS_DONE oder TWI_STATUS_ERROR
+ */
+uint8_t rtcReadStatus();
+
+/**
+ * @brief Wertet die abgeschlossene Leseanfrage aus.
+ *
+ * @param data Ausgabe der gelesenen Zeit (millisecond = 0)
+ * @return true wenn die gelesene Zeit gültig ist
+ */
+bool rtcGetReadResult(RTCData* data);
+
+/**
+ * @brief Schaltet den SQW-Ausgang des DS1307 auf 1 Hz.
+ *
+ * @return true wenn das Steuerregister geschrieben wurde
+ */
+bool rtcEnableSquareWave();
+
 /**
  * @brief Gibt RTC-Daten formatiert über die serielle Schnittstelle aus.
  *
@@ -155,13 +185,14 @@ void formatTimestamp(const RTCData* data, char* buffer, byte bufferSize);
 /**
  * @brief Prüft, ob ein gegebenes Datum in der Sommerzeit (MESZ) liegt.
  *
- * Berechnet anhand der europäischen Sommerzeitregeln, ob zu einem
- * bestimmten Datum die Sommerzeit aktiv ist.
+ * Schlägt den UTC-Zeitpunkt in der Umstellungstabelle (time_convert.h)
+ * nach. Wer bereits einen Unix-Timestamp hat, ruft besser direkt
+ * localOffsetSeconds() auf.
  *
- * @param year Jahr zur Prüfung
- * @param month Monat zur Prüfung
- * @param day Tag zur Prüfung
- * @param hour Stunde zur Prüfung
+ * @param year Jahr zur Prüfung (UTC)
+ * @param month Monat zur Prüfung (UTC)
+ * @param day Tag zur Prüfung (UTC)
+ * @param hour Stunde zur Prüfung (UTC)
  * @return true wenn Sommerzeit aktiv ist, false für Normalzeit
  */
 bool isDST(int year, int month, int day, int hour);
@@ -169,12 +200,14 @@ bool isDST(int year, int month, int day, int hour);
 /**
  * @brief Konvertiert UTC-Zeit in lokale Zeit (MEZ/MESZ).
  *
- * Passt UTC-Zeitdaten an die lokale Zeitzone (Deutschland) an,
- * berücksichtigt automatisch Sommer-/Winterzeit.
+ * Berechnet Datum und Uhrzeit aus dem Unix-Timestamp neu
+ * (Monats- und Jahreswechsel korrekt), berücksichtigt automatisch
+ * Sommer-/Winterzeit. Der Timestamp selbst bleibt UTC.
  *
  * @param data Zeiger auf RTCData-Struktur, wird modifiziert
+ * @return true wenn die Lokalzeit MESZ ist, false bei MEZ oder ungültigen Daten
  */
-void adjustUTCToLocal(RTCData* data);
+bool adjustUTCToLocal(RTCData* data);
 
 /**
  * @brief Formatiert lokale Datum/Zeit mit Zeitzone-Information.
@@ -0,0 +1,198 @@
+/*
+ * Implementierung des kooperativen Schedulers
+ */
+
+#include "scheduler.h"
+#include "perf_probe.h"
+#include <Arduino.h>
+#include <avr/sleep.h>
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+struct SchedulerTask {
+  const __FlashStringHelper* name;
+  TaskFunction function;
+  unsigned long periodUs;
+  unsigned long phaseUs;
+  unsigned long deadlineUs;
+  unsigned long due;          // Nächste Fälligkeit (micros())
+  uint8_t priority;
+  TaskStats stats;
+};
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static SchedulerTask schedulerTasks[SCHEDULER_MAX_TASKS];
+static uint8_t schedulerTaskCount = 0;
+
+// Min-Heap der Task-IDs, Wurzel = nächster fälliger Task
+static uint8_t schedulerHeap[SCHEDULER_MAX_TASKS];
+static uint8_t schedulerHeapSize = 0;
+
+// ==============================================
+// MIN-HEAP
+// ==============================================
+
+// true wenn Task a vor Task b an der Reihe ist (überlaufsicher)
+static inline bool runsBefore(uint8_t a, uint8_t b) {
+  long diff = (long)(schedulerTasks[a].due - schedulerTasks[b].due);
+  if (diff != 0) return diff < 0;
+  return schedulerTasks[a].priority < schedulerTasks[b].priority;
+}
+
+static void siftUp(uint8_t pos) {
+  while (pos > 0) {
+    uint8_t parent = (pos - 1) >> 1;
+    if (!runsBefore(schedulerHeap[pos], schedulerHeap[parent])) break;
+    uint8_t tmp = schedulerHeap[pos];
+    schedulerHeap[pos] = schedulerHeap[parent];
+    schedulerHeap[parent] = tmp;
+    pos = parent;
+  }
+}
+
+static void siftDown(uint8_t pos) {
+  while (true) {
+    uint8_t smallest = pos;
+    uint8_t left = 2 * pos + 1;
+    uint8_t right = left + 1;
+    if (left < schedulerHeapSize && runsBefore(schedulerHeap[left], schedulerHeap[smallest])) smallest = left;
+    if (right < schedulerHeapSize && runsBefore(schedulerHeap[right], schedulerHeap[smallest])) smallest = right;
+    if (smallest == pos) break;
+    uint8_t tmp = schedulerHeap[pos];
+    schedulerHeap[pos] = schedulerHeap[smallest];
+    schedulerHeap[smallest] = tmp;
+    pos = smallest;
+  }
+}
+
+// ==============================================
+// TASK-VERWALTUNG
+// ==============================================
+
+uint8_t schedulerAddTask(const __FlashStringHelper* name, TaskFunction function,
+                         unsigned long periodMs, unsigned long phaseMs,
+                         unsigned long deadlineMs, uint8_t priority) {
+  if (schedulerTaskCount >= SCHEDULER_MAX_TASKS || !function || periodMs == 0) {
+    return SCHEDULER_INVALID_TASK;
+  }
+
+  uint8_t id = schedulerTaskCount++;
+  SchedulerTask* task = &schedulerTasks[id];
+  task->name = name;
+  task->function = function;
+  task->periodUs = periodMs * 1000UL;
+  task->phaseUs = phaseMs * 1000UL;
+  task->deadlineUs = (deadlineMs ? deadlineMs : periodMs) * 1000UL;
+  task->priority = priority;
+  task->due = 0;
+  memset(&task->stats, 0, sizeof(task->stats));
+  return id;
+}
+
+void schedulerStart() {
+  unsigned long start = micros();
+  schedulerHeapSize = 0;
+  for (uint8_t id = 0; id < schedulerTaskCount; id++) {
+    schedulerTasks[id].due = start + schedulerTasks[id].phaseUs;
+    schedulerHeap[schedulerHeapSize] = id;
+    siftUp(schedulerHeapSize++);
+  }
+
+  DEBUG_PRINT(F("Scheduler gestartet mit "));
+  DEBUG_PRINT(schedulerTaskCount);
+  DEBUG_PRINTLN(F(" Tasks"));
+}
+
+// ==============================================
+// AUSFÜHRUNG
+// ==============================================
+
+void schedulerRun() {
+  if (schedulerHeapSize == 0) return;
+
+  // Höchstens ein Durchlauf pro Task, damit loop() regelmäßig zurückkehrt
+  for (uint8_t executed = 0; executed < schedulerTaskCount; executed++) {
+    uint8_t id = schedulerHeap[0];
+    SchedulerTask* task = &schedulerTasks[id];
+    unsigned long start = micros();
+    if ((long)(start - task->due) < 0) break;  // Nichts fällig
+
+#if PERF_ENABLED
+    uint32_t startCycles = perfCycles();
+    task->function();
+    uint32_t cycles = perfCycles() - startCycles;
+    task->stats.totalCycles += cycles;
+    if (cycles > task->stats.maxCycles) task->stats.maxCycles = cycles;
+#else
+    task->function();
+#endif
+    unsigned long end = micros();
+
+    TaskStats* stats = &task->stats;
+    unsigned long jitter = start - task->due;
+    unsigned long runTime = end - start;
+    stats->runs++;
+    if (jitter > stats->maxJitterUs) stats->maxJitterUs = jitter;
+    if (runTime > stats->maxRunTimeUs) stats->maxRunTimeUs = runTime;
+    if (end - task->due > task->deadlineUs) stats->overruns++;
+
+    // Raster beibehalten; nach mehr als einer Periode Verspätung aufholen
+    task->due += task->periodUs;
+    if ((long)(end - task->due) >= 0) {
+      unsigned long missed = (end - task->due) / task->periodUs + 1;
+      stats->skipped += missed;
+      task->due += missed * task->periodUs;
+    }
+    siftDown(0);
+  }
+
+  // Idle-Schlaf bis zum nächsten Interrupt (spätestens Timer0 nach ~1 ms),
+  // sofern der nächste Task noch nicht fällig ist
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  noInterrupts();
+  if ((long)(schedulerTasks[schedulerHeap[0]].due - micros()) > 0) {
+    sleep_enable();
+    interrupts();
+    sleep_cpu();   // sei + sleep: kein Interrupt geht dazwischen verloren
+    sleep_disable();
+  }
+  interrupts();
+}
+
+// ==============================================
+// STATISTIK
+// ==============================================
+
+bool schedulerGetStats(uint8_t id, TaskStats* out) {
+  if (id >= schedulerTaskCount || !out) return false;
+  *out = schedulerTasks[id].stats;
+  return true;
+}
+
+const __FlashStringHelper* schedulerTaskName(uint8_t id) {
+  return id < schedulerTaskCount ? schedulerTasks[id].name : NULL;
+}
+
+void schedulerPrintStats() {
+  DEBUG_PRINTLN(F("=== SCHEDULER ==="));
+  DEBUG_PRINTLN(F("Task: Läufe / Overruns / Ausgelassen / max. Jitter us / max. Laufzeit us"));
+  for (uint8_t id = 0; id < schedulerTaskCount; id++) {
+    const SchedulerTask* task = &schedulerTasks[id];
+    DEBUG_PRINT(task->name);
+    DEBUG_PRINT(F(": "));
+    DEBUG_PRINT(task->stats.runs);
+    DEBUG_PRINT(F(" / "));
+    DEBUG_PRINT(task->stats.overruns);
+    DEBUG_PRINT(F(" / "));
+    DEBUG_PRINT(task->stats.skipped);
+    DEBUG_PRINT(F(" / "));
+    DEBUG_PRINT(task->stats.maxJitterUs);
+    DEBUG_PRINT(F(" / "));
+    DEBUG_PRINTLN(task->stats.maxRunTimeUs);
+  }
+}
@@ -0,0 +1,95 @@
+/*
+ * Kooperativer Scheduler für das Umweltkontrollsystem
+ * Periodische Tasks mit Phase, Deadline und Priorität
+ *
+ * Die Tasks liegen in einer statischen Tabelle, die Reihenfolge der
+ * Fälligkeiten in einem Min-Heap (Schlüssel: nächster Fälligkeitszeitpunkt,
+ * bei Gleichstand die Priorität). schedulerRun() führt alle fälligen Tasks
+ * aus und legt die CPU bis zur nächsten Fälligkeit in den Idle-Schlaf -
+ * Timer-, ADC- und Zähler-Interrupts wecken sie weiterhin.
+ * Alle Zeiten intern in Mikrosekunden (micros()); Perioden bis 30 Minuten.
+ */
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "config.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+typedef void (*TaskFunction)();
+
+/**
+ * @brief Laufzeitstatistik eines Tasks.
+ */
+struct TaskStats {
+  unsigned long runs;           ///< Anzahl Ausführungen
+  unsigned long overruns;       ///< Deadline verfehlt (Ende später als Fälligkeit + Deadline)
+  unsigned long skipped;        ///< Ausgelassene Perioden nach starker Verspätung
+  unsigned long maxJitterUs;    ///< Größte Startverspätung gegenüber der Fälligkeit
+  unsigned long maxRunTimeUs;   ///< Längste Ausführungsdauer
+#if PERF_ENABLED
+  uint64_t totalCycles;         ///< Summe der Ausführungsdauern in Zyklen (perf_probe.h)
+  uint32_t maxCycles;           ///< Längste Ausführungsdauer in Zyklen
+#endif
+};
+
+const uint8_t SCHEDULER_INVALID_TASK = 0xFF;
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Registriert einen periodischen Task.
+ *
+ * Muss vor schedulerStart() aufgerufen werden.
+ *
+ * @param name Name für die Statistikausgabe (F()-String)
+ * @param function Auszuführende Funktion
+ * @param periodMs Periode in ms
+ * @param phaseMs Versatz der ersten Ausführung nach schedulerStart() in ms
+ * @param deadlineMs Spätestes Ende nach Fälligkeit in ms (0 = Periode)
+ * @param priority Priorität bei gleicher Fälligkeit (0 = höchste)
+ * @return Task-ID oder SCHEDULER_INVALID_TASK wenn die Tabelle voll ist
+ */
+uint8_t schedulerAddTask(const __FlashStringHelper* name, TaskFunction function,
+                         unsigned long periodMs, unsigned long phaseMs,
+                         unsigned long deadlineMs, uint8_t priority);
+
+/**
+ * @brief Setzt den gemeinsamen Zeitbezug und baut den Heap auf.
+ */
+void schedulerStart();
+
+/**
+ * @brief Führt alle fälligen Tasks aus und schläft bis zur nächsten Fälligkeit.
+ *
+ * Aus loop() aufrufen. Kehrt nach spätestens einer Task-Periode zurück.
+ */
+void schedulerRun();
+
+/**
+ * @brief Liefert die Statistik eines Tasks.
+ *
+ * @param id Task-ID aus schedulerAddTask()
+ * @param out Ausgabe der Statistik
+ * @return true wenn die ID gültig ist
+ */
+bool schedulerGetStats(uint8_t id, TaskStats* out);
+
+/**
+ * @brief Liefert den Namen eines Tasks.
+ *
+ * @return Name aus schedulerAddTask() oder NULL bei ungültiger ID
+ */
+const __FlashStringHelper* schedulerTaskName(uint8_t id);
+
+/**
+ * @brief Gibt die Statistik aller Tasks seriell aus.
+ */
+void schedulerPrintStats();
+
+#endif // SCHEDULER_H
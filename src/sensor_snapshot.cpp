@@ -0,0 +1,73 @@
+/*
+ * Implementierung des Sensor-Snapshot-Moduls
+ */
+
+#include "sensor_snapshot.h"
+#include "sensors.h"
+#include "dht_driver.h"
+#include "time_service.h"
+#include <Arduino.h>
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static SensorSnapshot currentSnapshot = {};
+static RadiationCursor snapshotRadiationCursor = {0, 0};
+
+// ==============================================
+// ERFASSUNG
+// ==============================================
+
+const SensorSnapshot* acquireSensorSnapshot() {
+  SensorSnapshot* snap = &currentSnapshot;
+  unsigned long lastTimestamp = snap->rtc.timestamp;
+  bool hadTime = snap->rtc.isValid;
+
+  // Zeitstempel (einmal pro Zyklus, aus dem Zeitdienst ohne I2C-Zugriff)
+  if (!timeServiceNow(&snap->rtc)) {
+    DEBUG_PRINTLN(F("WARNUNG: RTC-Zeit nicht verfügbar!"));
+  } else if (hadTime) {
+    // RTC-Sprung-Detektion
+    long timeDiff = abs((long)snap->rtc.timestamp - (long)lastTimestamp);
+    if (timeDiff > 10) {  // Mehr als 10 Sekunden Sprung?
+      DEBUG_PRINT(F("WARNUNG: RTC-Zeitsprung erkannt! Diff: "));
+      DEBUG_PRINTLN(timeDiff);
+    }
+  }
+
+  // DHT11 (Temperatur + Luftfeuchtigkeit) - zwischengespeicherter Wert des Treibers
+  snap->dhtValid = readDHTSensor(&snap->temperature, &snap->humidity);
+  snap->dhtAgeMs = dhtReadingAge();
+
+  // Lichtsensor
+  snap->lightLevel = readLightSensor();
+  snap->lightPercent = getLightPercentFromRaw(snap->lightLevel);
+
+  // Gas-Sensoren und Mikrofone
+  readAllGasSensors(snap->gasSensors);
+  readAllMicrophones(snap->microphones);
+
+  // TDS mit Temperaturkompensation, sofern DHT11-Wert vorhanden
+  snap->tdsValue = snap->dhtValid ? readTDSSensor(snap->temperature) : readTDSSensor();
+
+  // Radioaktivität: eigener Cursor, der gemeinsame Zähler bleibt unberührt
+  if (snap->sequence == 0) {
+    initRadiationCursor(&snapshotRadiationCursor);
+  }
+  unsigned long elapsedMs = 0;
+  snap->radiationCount = readRadiationDelta(&snapshotRadiationCursor, &elapsedMs);
+  snap->radiationCPS = elapsedMs > 0 ? (snap->radiationCount * 1000.0) / elapsedMs : 0.0;
+
+  snap->acquiredAt = millis();
+  snap->sequence++;
+  return snap;
+}
+
+const SensorSnapshot* getSensorSnapshot() {
+  return &currentSnapshot;
+}
+
+bool hasSensorSnapshot() {
+  return currentSnapshot.sequence > 0;
+}
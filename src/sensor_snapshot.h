@@ -0,0 +1,74 @@
+/*
+ * Sensor-Snapshot-Modul für das Umweltkontrollsystem
+ * Einmalige Erfassung aller Sensoren pro Messzyklus
+ */
+
+#ifndef SENSOR_SNAPSHOT_H
+#define SENSOR_SNAPSHOT_H
+
+#include "config.h"
+#include "rtc_module.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Momentaufnahme aller Sensorwerte eines Messzyklus.
+ *
+ * Wird genau einmal pro Zyklus von acquireSensorSnapshot() gefüllt.
+ * Logger, OLED-Seiten und serielle Ausgabe lesen ausschließlich aus
+ * dieser Struktur und greifen nie selbst auf ADC oder DHT-Bus zu.
+ */
+struct SensorSnapshot {
+  unsigned long sequence;          ///< Versionszähler, +1 pro Erfassung (0 = noch keine Daten)
+  unsigned long acquiredAt;        ///< millis()-Zeitpunkt der Erfassung
+  RTCData rtc;                     ///< RTC-Zeit zum Erfassungszeitpunkt (UTC)
+
+  float temperature;               ///< Temperatur vom DHT11-Sensor in °C
+  float humidity;                  ///< Luftfeuchtigkeit vom DHT11-Sensor in %
+  bool dhtValid;                   ///< true wenn die DHT11-Messung gültig war
+  unsigned long dhtAgeMs;          ///< Alter des zwischengespeicherten DHT11-Werts (ms)
+
+  int lightLevel;                  ///< Lichtsensor-Rohwert (0-1023)
+  float lightPercent;              ///< Helligkeit in Prozent (0-100%)
+
+  int gasSensors[MAX_GAS_SENSORS]; ///< Alle 9 Gassensor-Werte (0-1023)
+  int microphones[MAX_MICROPHONES];///< Beide Mikrofon-Pegel (Peak-to-Peak)
+  float tdsValue;                  ///< TDS-Wert in ppm
+  unsigned long radiationCount;    ///< Radioaktivitäts-Impulse seit der letzten Erfassung
+  float radiationCPS;              ///< Impulse pro Sekunde im letzten Erfassungsintervall
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Liest alle Sensoren einmal aus und füllt den globalen Snapshot.
+ *
+ * Einzige Stelle im Messzyklus, die DHT11, ADC-Kanäle, TDS-Sensor,
+ * Radioaktivitätszähler und RTC abfragt. Erhöht die Sequenznummer.
+ *
+ * @return Zeiger auf den neu gefüllten Snapshot
+ */
+const SensorSnapshot* acquireSensorSnapshot();
+
+/**
+ * @brief Gibt den zuletzt erfassten Snapshot zurück.
+ *
+ * Löst keine Messung aus. Vor der ersten Erfassung ist die
+ * Sequenznummer 0 und alle Werte sind 0.
+ *
+ * @return Zeiger auf den aktuellen Snapshot (nie NULL)
+ */
+const SensorSnapshot* getSensorSnapshot();
+
+/**
+ * @brief Prüft, ob bereits ein Snapshot erfasst wurde.
+ *
+ * @return true wenn mindestens eine Erfassung stattgefunden hat
+ */
+bool hasSensorSnapshot();
+
+#endif // SENSOR_SNAPSHOT_H
@@ -5,25 +5,16 @@ void initTDSSensor() {
 
 
 #include "sensors.h"
+#include "trace.h"
+#include "adc_scanner.h"
+#include "mic_envelope.h"
+#include "streaming_stats.h"
+#include "tds_converter.h"
+#include "dht_driver.h"
 #include <Arduino.h>
 
-// DHT Library macht eigene DEBUG Macros - wir deaktivieren sie temporär
-#ifdef DEBUG_PRINT
-#undef DEBUG_PRINT
-#undef DEBUG_PRINTLN
-#endif
-
-#include <DHT.h>
-
-// Unsere DEBUG Macros wieder aktivieren
-#include "config.h"
 #define TdsSensorPin A12            // Pin, an dem der TDS-Sensor angeschlossen ist
-#define VREF 5.0                    // Referenzspannung des ADC (in Volt)
-#define SCOUNT  30                  // Anzahl der Messwerte für Mittelwertbildung
-
-int analogBuffer[SCOUNT];           // Puffer für die ADC-Messwerte
-int analogBufferIndex = 0;
-float averageVoltage = 0, tdsValue = 0, temperature = 18; // Temperatur für Kompensation
+#define SCOUNT  30                  // Anzahl der Messwerte im gleitenden Median
 
 
 // ==============================================
@@ -31,7 +22,6 @@ float averageVoltage = 0, tdsValue = 0, temperature = 18; // Temperatur für Kom
 // ==============================================
 
 // OneWire temperatureSensor(TEMP_SENSOR_PIN);  // DEAKTIVIERT
-DHT dhtSensor(DHT_SENSOR_PIN, DHT11);
 
 // ==============================================
 // DHT11 TEMPERATUR & LUFTFEUCHTIGKEIT
@@ -39,59 +29,33 @@ DHT dhtSensor(DHT_SENSOR_PIN, DHT11);
 
 bool initDHTSensor() {
   DEBUG_PRINTLN(F("Initialisiere DHT11 Sensor..."));
-  dhtSensor.begin();
-  // KEIN delay(2000) mehr - non-blocking Aufwärmung in State Machine
-  
-  // Ersten Test-Wert lesen
-  float testTemp = dhtSensor.readTemperature();
-  float testHum = dhtSensor.readHumidity();
-  
-  if (isnan(testTemp) || isnan(testHum)) {
-    DEBUG_PRINTLN(F("FEHLER: DHT11 antwortet nicht!"));
-    DEBUG_PRINTLN(F("Prüfe: VCC->5V, GND->GND, DATA->Pin 22"));
-    return false;
-  }
-  
-  DEBUG_PRINT(F("DHT11 Test OK: "));
-  DEBUG_PRINT(testTemp);
-  DEBUG_PRINT(F("°C, "));
-  DEBUG_PRINT(testHum);
-  DEBUG_PRINTLN(F("%"));
+  // Nicht-blockierend: erste Messung läuft im Hintergrund über dhtUpdate()
+  dhtBegin();
+  DEBUG_PRINT(F("DHT11 Treiber aktiv an Pin "));
+  DEBUG_PRINTLN(DHT_SENSOR_PIN);
   return true;
 }
 
 bool readDHTSensor(float* temperature, float* humidity) {
-  // DHT11 lesen mit mehreren Versuchen
-  for (int attempt = 0; attempt < 3; attempt++) {
-    *humidity = dhtSensor.readHumidity();
-    *temperature = dhtSensor.readTemperature();
-    
-    // Prüfen ob Messung gültig ist
-    if (!isnan(*humidity) && !isnan(*temperature)) {
-      // Zusätzliche Plausibilitätsprüfung
-      if (*temperature > -40 && *temperature < 80 && *humidity >= 0 && *humidity <= 100) {
-        return true;
-      }
+  // Nur zwischengespeicherten Wert lesen - keine Busübertragung
+  DhtReading reading;
+  if (dhtGetReading(&reading)) {
+    *temperature = reading.temperatureDeci / 10.0;
+    *humidity = reading.humidityDeci / 10.0;
+
+    // Zusätzliche Plausibilitätsprüfung
+    if (*temperature > -40 && *temperature < 80 && *humidity >= 0 && *humidity <= 100) {
+      return true;
     }
-    
-    DEBUG_PRINT(F("DHT11 Versuch "));
-    DEBUG_PRINT(attempt + 1);
-    DEBUG_PRINTLN(F(" fehlgeschlagen, wiederhole..."));
-    // KEIN delay(500) mehr - non-blocking!
   }
-  
-  DEBUG_PRINTLN(F("DHT11 komplett fehlgeschlagen!"));
+
   *temperature = 0.0;
   *humidity = 0.0;
   return false;
 }
 
 void printDHTValues(float temperature, float humidity) {
-  DEBUG_PRINT(F("DHT11 - Temperatur: "));
-  DEBUG_PRINT(temperature);
-  DEBUG_PRINT(F("°C, Luftfeuchtigkeit: "));
-  DEBUG_PRINT(humidity);
-  DEBUG_PRINTLN(F("%"));
+  TRACE(DHT_VALUES, temperature, humidity);
 }
 
 // ==============================================
@@ -111,7 +75,8 @@ void warmupGasSensors() {
 }
 
 int readGasSensor(uint8_t pin) {
-  return analogRead(pin);
+  // Gemittelter Wert aus dem ADC-Scanner - kein blockierendes analogRead()
+  return adcScanAverage(adcScanChannel(pin));
 }
 
 void readAllGasSensors(int* values) {
@@ -126,7 +91,7 @@ void readAllGasSensors(int* values) {
   values[8] = readGasSensor(MQ135_PIN);  // Luftqualität
 }
 
-void printGasSensorValues(int* values) {
+void printGasSensorValues(const int* values) {
 #if DEBUG_ENABLED
   const char* sensorNames[] = {
     "MQ2(Methan)", "MQ3(Alkohol)", "MQ4(CNG)", "MQ5(LPG)", 
@@ -147,124 +112,94 @@ void printGasSensorValues(int* values) {
 }
 
 // ==============================================
-// RADIOAKTIVITÄTS-SENSOR (INTERRUPT-BASIERT)
+// RADIOAKTIVITÄTS-SENSOR (HARDWARE-ZÄHLER TIMER5)
 // ==============================================
 
-#define RADIATION_INPUT_PIN 19  // Möglich: 2, 3, 18, 19, 20, 21
-
-volatile unsigned long tickCount = 0;    // Zähler, wird im Interrupt erhöht
-unsigned long lastEventTime = 0;         // Für Entprellung (in µs)
-unsigned long lastRadiationPrint = 0;    // Zeitstempel der letzten Ausgabe
+// Timer5 wird extern über T5 (PL2 = Digitalpin 47) getaktet: jeder
+// Geiger-Impuls erhöht TCNT5 in Hardware, ohne Interrupt pro Impuls.
+// Nur der Überlauf (alle 65536 Impulse) erweitert den Zähler auf 32 Bit.
+static volatile uint16_t radiationOverflows = 0;
 
-void countTick() {
-  unsigned long now = micros();
-  if (now - lastEventTime > 2000) {  // Entprellung: 2 ms
-    tickCount++;
-    lastEventTime = now;
-  }
+ISR(TIMER5_OVF_vect) {
+  radiationOverflows++;
 }
 
 void initRadiationSensor() {
   pinMode(RADIATION_INPUT_PIN, INPUT);
-  attachInterrupt(digitalPinToInterrupt(RADIATION_INPUT_PIN), countTick, CHANGE);
+
+  noInterrupts();
+  TCCR5A = 0;                         // Normal-Modus, keine Ausgänge
+  TCCR5B = 0;
+  TCCR5C = 0;
+  TCNT5 = 0;
+  radiationOverflows = 0;
+  TIFR5 = _BV(TOV5);                  // Anstehenden Überlauf löschen
+  TIMSK5 = _BV(TOIE5);                // Nur Überlauf-Interrupt
+  TCCR5B = _BV(CS52) | _BV(CS51);     // Externer Takt an T5, fallende Flanke
+  interrupts();
 }
 
-unsigned long getRadiationCountAndReset() {
+unsigned long getRadiationTotalCount() {
   noInterrupts();
-  unsigned long countCopy = tickCount;
-  tickCount = 0;
+  uint16_t low = TCNT5;
+  uint16_t high = radiationOverflows;
+  // Überlauf bereits passiert, aber ISR wegen Sperre noch nicht gelaufen?
+  if ((TIFR5 & _BV(TOV5)) && low < 0x8000) {
+    high++;
+  }
   interrupts();
-  return countCopy;
+  return ((unsigned long)high << 16) | low;
+}
+
+void initRadiationCursor(RadiationCursor* cursor) {
+  cursor->lastCount = getRadiationTotalCount();
+  cursor->lastTime = millis();
+}
+
+unsigned long readRadiationDelta(RadiationCursor* cursor, unsigned long* elapsedMs) {
+  unsigned long count = getRadiationTotalCount();
+  unsigned long now = millis();
+  unsigned long delta = count - cursor->lastCount;
+  if (elapsedMs) {
+    *elapsedMs = now - cursor->lastTime;
+  }
+  cursor->lastCount = count;
+  cursor->lastTime = now;
+  return delta;
 }
 
 
 // ==============================================
-// MIKROFON-SENSOREN (OPTIMIERT FÜR SOUND-ERKENNUNG)
+// MIKROFON-SENSOREN (KONTINUIERLICHE HÜLLKURVE)
 // ==============================================
 
 int readMicrophone(uint8_t pin) {
-  // MEHRFACH-SAMPLING für bessere Schall-Erkennung
-  int maxValue = 0;
-  int minValue = 1023;
-  
-  // 20 schnelle Messungen in 10ms
-  for (int i = 0; i < 20; i++) {
-    int value = analogRead(pin);
-    if (value > maxValue) maxValue = value;
-    if (value < minValue) minValue = value;
-    delayMicroseconds(500); // 0.5ms zwischen Messungen
-  }
-  
-  // Peak-to-Peak Wert zurückgeben (Amplitude)
-  return maxValue - minValue;
+  // Gehaltener Spitzenpegel aus dem Hüllkurven-Tracker - O(1), nicht-blockierend
+  return micEnvelopePeakHold(pin == MIC_KLEIN_PIN ? 0 : 1);
 }
 
 void readAllMicrophones(int* micValues) {
-  DEBUG_PRINTLN(F("=== MIKROFON-TESTS (OPTIMIERT) ==="));
-  
-  // Mehrere Messungen für Stabilität - OHNE delay()
-  int mic1_readings[5], mic2_readings[5];
-  
-  for (int i = 0; i < 5; i++) {
-    mic1_readings[i] = readMicrophone(MIC_KLEIN_PIN);
-    mic2_readings[i] = readMicrophone(MIC_GROSS_PIN);
-    // KEIN delay(20) mehr - non-blocking!
-  }
-  
-  // Maximum der letzten 5 Messungen (für Schall-Peaks)
-  micValues[0] = 0;
-  micValues[1] = 0;
-  
-  for (int i = 0; i < 5; i++) {
-    if (mic1_readings[i] > micValues[0]) micValues[0] = mic1_readings[i];
-    if (mic2_readings[i] > micValues[1]) micValues[1] = mic2_readings[i];
-  }
-  
-  DEBUG_PRINT(F("Mikrofon Klein (A"));
-  DEBUG_PRINT(MIC_KLEIN_PIN - A0);
-  DEBUG_PRINT(F("): Peak-Peak = "));
-  DEBUG_PRINT(micValues[0]);
-  DEBUG_PRINT(F(" (Messungen: "));
-  for (int i = 0; i < 5; i++) {
-    DEBUG_PRINT(mic1_readings[i]);
-    if (i < 4) DEBUG_PRINT(F(","));
-  }
-  DEBUG_PRINTLN(F(")"));
+  micValues[0] = readMicrophone(MIC_KLEIN_PIN);
+  micValues[1] = readMicrophone(MIC_GROSS_PIN);
   
-  DEBUG_PRINT(F("Mikrofon Gross (A"));
-  DEBUG_PRINT(MIC_GROSS_PIN - A0);
-  DEBUG_PRINT(F("): Peak-Peak = "));
-  DEBUG_PRINT(micValues[1]);
-  DEBUG_PRINT(F(" (Messungen: "));
-  for (int i = 0; i < 5; i++) {
-    DEBUG_PRINT(mic2_readings[i]);
-    if (i < 4) DEBUG_PRINT(F(","));
-  }
-  DEBUG_PRINTLN(F(")"));
-  
-  // Verbesserte Bewertung der Mikrofon-Pegel (Peak-to-Peak)
-  for (int i = 0; i < 2; i++) {
-    const char* micName = (i == 0) ? "Klein" : "Gross";
-    DEBUG_PRINT(F("Mikrofon "));
-    DEBUG_PRINT(micName);
-    DEBUG_PRINT(F(" (P2P): "));
-    
-    // Vermeide Compiler-Warnung bei ausgeschaltetem Debug
-    (void)micName;
-    
+  // Verbesserte Bewertung der Mikrofon-Pegel (Peak-to-Peak), Stufen
+  // siehe MIC_LEVEL in trace_messages.def
+  for (uint8_t i = 0; i < 2; i++) {
+    uint8_t level;
     if (micValues[i] < 2) {
-      DEBUG_PRINTLN(F("SEHR LEISE/RAUSCHEN"));
+      level = 0;  // SEHR LEISE/RAUSCHEN
     } else if (micValues[i] < 5) {
-      DEBUG_PRINTLN(F("Leise"));
+      level = 1;  // Leise
     } else if (micValues[i] < 15) {
-      DEBUG_PRINTLN(F("Normal"));
+      level = 2;  // Normal
     } else if (micValues[i] < 30) {
-      DEBUG_PRINTLN(F("LAUT"));
+      level = 3;  // LAUT
     } else if (micValues[i] < 50) {
-      DEBUG_PRINTLN(F("SEHR LAUT"));
+      level = 4;  // SEHR LAUT
     } else {
-      DEBUG_PRINTLN(F("EXTREM LAUT"));
+      level = 5;  // EXTREM LAUT
     }
+    TRACE(MIC_LEVEL, i, micValues[i], level);
   }
 }
 
@@ -273,36 +208,35 @@ void readAllMicrophones(int* micValues) {
 // ==============================================
 
 int readLightSensor() {
-  return analogRead(LDR_PIN);
+  return adcScanAverage(adcScanChannel(LDR_PIN));
 }
 
 float getLightPercent() {
-  int lightValue = readLightSensor();
+  return getLightPercentFromRaw(readLightSensor());
+}
+
+float getLightPercentFromRaw(int lightValue) {
   // INVERTIERTE Umrechnung für typische LDR-Schaltung:
-  // Hell: niedriger analogRead() = hohe Lichtintensität
-  // Dunkel: hoher analogRead() = niedrige Lichtintensität
+  // Hell: niedriger ADC-Wert = hohe Lichtintensität
+  // Dunkel: hoher ADC-Wert = niedrige Lichtintensität
   return ((1023 - lightValue) / 1023.0) * 100.0;
 }
 
 void printLightLevel(int lightValue, float lightPercent) {
-  DEBUG_PRINT(F("Licht RAW: "));
-  DEBUG_PRINT(lightValue);
-  DEBUG_PRINT(F(" -> "));
-  DEBUG_PRINT(lightPercent, 1);
-  DEBUG_PRINT(F("% | "));
-  
-  // Zusätzliche Klassifizierung
+  // Zusätzliche Klassifizierung (0 = DUNKEL ... 4 = SEHR HELL, siehe LIGHT_LEVEL)
+  uint8_t lightClass;
   if (lightPercent > 80) {
-    DEBUG_PRINTLN(F("SEHR HELL"));
+    lightClass = 4;
   } else if (lightPercent > 60) {
-    DEBUG_PRINTLN(F("Hell"));
+    lightClass = 3;
   } else if (lightPercent > 40) {
-    DEBUG_PRINTLN(F("Normal"));
+    lightClass = 2;
   } else if (lightPercent > 20) {
-    DEBUG_PRINTLN(F("Dämmrig"));
+    lightClass = 1;
   } else {
-    DEBUG_PRINTLN(F("DUNKEL"));
+    lightClass = 0;
   }
+  TRACE(LIGHT_LEVEL, lightValue, lightPercent, lightClass);
 }
 
 
@@ -318,60 +252,21 @@ void printLightLevel(int lightValue, float lightPercent) {
 // TDS SENSOR (WASSERQUALITÄT) - Integration für Hauptsystem
 // ==============================================
 
-// Median-Berechnung für stabile Messwerte
-int getMedianNum(int bArray[], int iFilterLen)
-{
-  int bTab[30];
-  for (byte i = 0; i < iFilterLen; i++)
-    bTab[i] = bArray[i];
-  int i, j, bTemp;
-  for (j = 0; j < iFilterLen - 1; j++)
-  {
-    for (i = 0; i < iFilterLen - j - 1; i++)
-    {
-      if (bTab[i] > bTab[i + 1])
-      {
-        bTemp = bTab[i];
-        bTab[i] = bTab[i + 1];
-        bTab[i + 1] = bTemp;
-      }
-    }
-  }
-  // Gibt den Medianwert zurück
-  if ((iFilterLen & 1) > 0)
-    bTemp = bTab[(iFilterLen - 1) / 2];
-  else
-    bTemp = (bTab[iFilterLen / 2] + bTab[iFilterLen / 2 - 1]) / 2;
-  return bTemp;
-}
-
 float readTDSSensor(float temperature) {
-  // TDS-Buffer und Index als static, damit sie zwischen Aufrufen erhalten bleiben
-  static int analogBuffer[30];
-  static int analogBufferIndex = 0;
+  // Gleitender Median über die letzten SCOUNT Messwerte (O(1) auslesbar)
+  static StreamingMedian<uint16_t, SCOUNT> tdsMedian;
   static unsigned long lastSampleTime = 0;
-  static float lastTDSValue = 0;
-  static unsigned long lastCalcTime = 0;
 
-  // Sample alle 33ms
+  // Sample alle 33ms (gemittelter Wert aus dem ADC-Scanner)
   if (millis() - lastSampleTime >= 33) {
     lastSampleTime = millis();
-    analogBuffer[analogBufferIndex] = analogRead(TdsSensorPin);
-    analogBufferIndex++;
-    if (analogBufferIndex >= 30) analogBufferIndex = 0;
+    tdsMedian.add(adcScanAverage(adcScanChannel(TdsSensorPin)));
   }
 
-  // Nur alle 1s Median berechnen und Wert merken
-  if (millis() - lastCalcTime >= 1000) {
-    lastCalcTime = millis();
-    int analogBufferTemp[30];
-    for (int i = 0; i < 30; i++) analogBufferTemp[i] = analogBuffer[i];
-    float averageVoltage = getMedianNum(analogBufferTemp, 30) * (float)VREF / 1024.0;
-    float compensationCoefficient = 1.0 + 0.02 * (temperature - 25.0);
-    float compensationVolatge = averageVoltage / compensationCoefficient;
-    lastTDSValue = (133.42 * compensationVolatge * compensationVolatge * compensationVolatge - 255.86 * compensationVolatge * compensationVolatge + 857.39 * compensationVolatge) * 0.5;
-  }
-  return lastTDSValue;
+  // Festkomma-Umrechnung (Tabelle + Q12-Temperaturkompensation), kein Float-Polynom
+  int16_t tempDeci = (int16_t)(temperature * 10.0f + (temperature < 0 ? -0.5f : 0.5f));
+  uint32_t ppmQ4 = tdsCodeToPpmQ4(tdsMedian.median(), tempDeci);
+  return ppmQ4 / (float)(1 << TDS_PPM_FRAC_BITS);
 }
 
 // ==============================================
@@ -405,7 +300,7 @@ void testAllSensors() {
   DEBUG_PRINT(F("LDR: "));
   DEBUG_PRINT(readLightSensor());
   DEBUG_PRINT(F(" ("));
-  DEBUG_PRINT(getLightPercent(), 1);
+  DEBUG_PRINT(getLightPercent());
   DEBUG_PRINTLN(F("%) - OK"));
   
   // Gas-Sensoren Test
@@ -420,8 +315,8 @@ void testAllSensors() {
   
   // Radioaktivität Test
   DEBUG_PRINT(F("Radioaktivität: "));
-  DEBUG_PRINT(getRadiationCountAndReset());
-  DEBUG_PRINTLN(F(" Impulse (seit letztem Test) - OK"));
+  DEBUG_PRINT(getRadiationTotalCount());
+  DEBUG_PRINTLN(F(" Impulse (gesamt seit Start) - OK"));
   
   DEBUG_PRINTLN(F("================================="));
 }
@@ -1,6 +1,3 @@
-// Interruptbasierte Radioaktivitätszählung (Geigerzähler)
-void initRadiationSensor();
-unsigned long getRadiationCountAndReset();
 /*
  * Sensoren-Modul für das Umweltkontrollsystem
  * Verwaltet alle Sensor-Funktionen (Temperatur, Gas, Radioaktivität)
@@ -28,23 +25,22 @@ float readTDSSensor(float temperature = 25.0);
 /**
  * @brief Initialisiert den DHT11 Temperatur- und Luftfeuchtigkeitssensor.
  *
- * Konfiguriert den DHT11-Sensor auf dem definierten Pin und führt einen
- * Funktionstest durch. Der Sensor benötigt eine kurze Aufwärmzeit.
+ * Startet den interruptgesteuerten DHT-Treiber (dht_driver.h). Die erste
+ * Messung läuft im Hintergrund; der Sensor benötigt eine kurze Aufwärmzeit.
  *
- * @return true wenn Sensor erfolgreich initialisiert und getestet wurde, false bei Fehlern
+ * @return true wenn der Treiber gestartet wurde
  */
 bool initDHTSensor();
 
 /**
  * @brief Liest Temperatur und Luftfeuchtigkeit vom DHT11-Sensor.
  *
- * Führt eine Messung mit dem DHT11-Sensor durch und gibt die Werte
- * über die bereitgestellten Zeiger zurück. Implementiert Retry-Logik
- * für verbesserte Zuverlässigkeit.
+ * Liefert den zuletzt im Hintergrund dekodierten Messwert, ohne den Bus
+ * anzusprechen. Werte älter als DHT_STALE_MS gelten als ungültig.
  *
  * @param temperature Zeiger auf Variable für Temperaturwert in °C
  * @param humidity Zeiger auf Variable für Luftfeuchtigkeit in %
- * @return true wenn Messung erfolgreich, false bei Sensor-Fehlern
+ * @return true wenn ein aktueller, plausibler Messwert vorliegt
  */
 bool readDHTSensor(float* temperature, float* humidity);
 
@@ -78,8 +74,8 @@ void warmupGasSensors();
 /**
  * @brief Liest den Wert eines einzelnen Gassensors.
  *
- * Führt eine analoge Messung an dem angegebenen Pin durch und
- * gibt den digitalen Wert zurück.
+ * Liefert den gemittelten Wert des Kanals aus dem ADC-Scanner,
+ * ohne selbst eine Wandlung abzuwarten.
  *
  * @param pin Analoger Pin-Nummer (A0-A8) des Gassensors
  * @return Sensorwert als 10-bit ADC-Wert (0-1023)
@@ -104,26 +100,27 @@ void readAllGasSensors(int* values);
  *
  * @param values Array mit 9 Gassensor-Werten
  */
-void printGasSensorValues(int* values);
+void printGasSensorValues(const int* values);
 
 
 // Mikrofon-Sensoren
 /**
  * @brief Liest den Wert eines einzelnen Mikrofon-Sensors.
  *
- * Führt eine analoge Messung des Schallpegels durch und
- * gibt den entsprechenden digitalen Wert zurück.
+ * Liefert den gehaltenen Peak-to-Peak-Pegel (größtes 100-ms-Fenster
+ * des letzten Logging-Intervalls) aus dem Hüllkurven-Tracker.
+ * Nicht-blockierend, O(1).
  *
  * @param pin Analoger Pin des Mikrofon-Sensors (A9 oder A10)
- * @return Schallpegel als 10-bit ADC-Wert (0-1023)
+ * @return Schallpegel als Peak-to-Peak-Spanne (0-1023)
  */
 int readMicrophone(uint8_t pin);
 
 /**
  * @brief Liest beide Mikrofon-Sensoren gleichzeitig.
  *
- * Führt simultane Messungen beider Mikrofone durch für
- * Stereo-Schallpegelmessungen oder Richtungsbestimmung.
+ * Übernimmt die gehaltenen Spitzenpegel beider Mikrofone aus dem
+ * kontinuierlich laufenden Hüllkurven-Tracker.
  *
  * @param micValues Array mit mindestens 2 Elementen für die Mikrofon-Werte
  */
@@ -133,8 +130,8 @@ void readAllMicrophones(int* micValues);
 /**
  * @brief Liest den Rohwert des Lichtsensors (LDR).
  *
- * Misst die Lichtintensität über den lichtsensitiven Widerstand (LDR)
- * und gibt den entsprechenden ADC-Wert zurück.
+ * Liefert den gemittelten Scanner-Wert des lichtsensitiven
+ * Widerstands (LDR).
  *
  * @return Lichtwert als 10-bit ADC-Wert (0-1023), höher = heller
  */
@@ -150,6 +147,16 @@ int readLightSensor();
  */
 float getLightPercent();
 
+/**
+ * @brief Konvertiert einen bereits gelesenen Lichtsensor-Rohwert in Prozent.
+ *
+ * Wie getLightPercent(), jedoch ohne erneute ADC-Messung.
+ *
+ * @param lightValue Rohwert des Lichtsensors (0-1023)
+ * @return Helligkeit in Prozent (0-100%), 100% = maximale Helligkeit
+ */
+float getLightPercentFromRaw(int lightValue);
+
 /**
  * @brief Gibt Lichtsensor-Werte formatiert aus.
  *
@@ -161,6 +168,55 @@ float getLightPercent();
  */
 void printLightLevel(int lightValue, float lightPercent);
 
+// Radioaktivität (Geigerzähler, Hardware-Zähler Timer5)
+/**
+ * @brief Lesezeiger eines Verbrauchers auf den Radioaktivitätszähler.
+ *
+ * Jeder Verbraucher (Snapshot, Diagnose, ...) hält einen eigenen Cursor
+ * und berechnet Differenzen, ohne den gemeinsamen Zähler zurückzusetzen.
+ */
+struct RadiationCursor {
+  unsigned long lastCount;   ///< Zählerstand beim letzten Auslesen
+  unsigned long lastTime;    ///< millis()-Zeitpunkt des letzten Auslesens
+};
+
+/**
+ * @brief Initialisiert die Hardware-Impulszählung des Geigerzählers.
+ *
+ * Timer5 wird mit dem externen Takteingang T5 (Pin 47) getaktet und
+ * zählt jede fallende Flanke ohne CPU-Last. Nur der Überlauf alle
+ * 65536 Impulse löst einen Interrupt aus, der den Zähler auf 32 Bit erweitert.
+ */
+void initRadiationSensor();
+
+/**
+ * @brief Liefert den monoton steigenden Gesamtzählerstand.
+ *
+ * Wird nie zurückgesetzt. Differenzen zweier Zählerstände sind auch
+ * über den 32-Bit-Überlauf hinweg korrekt (vorzeichenlose Subtraktion).
+ *
+ * @return Anzahl Impulse seit initRadiationSensor()
+ */
+unsigned long getRadiationTotalCount();
+
+/**
+ * @brief Setzt einen Cursor auf den aktuellen Zählerstand.
+ *
+ * @param cursor Zu initialisierender Cursor
+ */
+void initRadiationCursor(RadiationCursor* cursor);
+
+/**
+ * @brief Liefert die Impulse seit dem letzten Auslesen dieses Cursors.
+ *
+ * Rückt nur den übergebenen Cursor vor; andere Verbraucher sind nicht betroffen.
+ *
+ * @param cursor Cursor des Verbrauchers (wird aktualisiert)
+ * @param elapsedMs Optional: vergangene Zeit seit dem letzten Auslesen in ms
+ * @return Anzahl Impulse im Intervall
+ */
+unsigned long readRadiationDelta(RadiationCursor* cursor, unsigned long* elapsedMs);
+
 // Sensor-Diagnose
 /**
  * @brief Führt einen umfassenden Test aller Sensoren durch.
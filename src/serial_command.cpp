@@ -0,0 +1,117 @@
+/*
+ * Implementierung der seriellen Befehle
+ */
+
+#include "serial_command.h"
+#include "perf_probe.h"
+#include "profiler.h"
+#include <Arduino.h>
+
+// ==============================================
+// BEFEHLSTABELLE
+// ==============================================
+
+typedef void (*CommandHandler)();
+
+struct SerialCommand {
+  const char* name;             ///< Befehl (PROGMEM)
+  const char* help;             ///< Kurzbeschreibung (PROGMEM)
+  CommandHandler handler;
+};
+
+static void printHelp();
+
+static const char CMD_HELP[] PROGMEM = "help";
+static const char CMD_HELP_TEXT[] PROGMEM = "Diese Liste";
+#if PERF_ENABLED
+static const char CMD_PERF[] PROGMEM = "perf";
+static const char CMD_PERF_TEXT[] PROGMEM = "Laufzeiten je Abschnitt (µs, Histogramm)";
+static const char CMD_PERF_CSV[] PROGMEM = "perf csv";
+static const char CMD_PERF_CSV_TEXT[] PROGMEM = "Laufzeiten als CSV (Zyklen)";
+static const char CMD_PERF_RESET[] PROGMEM = "perf reset";
+static const char CMD_PERF_RESET_TEXT[] PROGMEM = "Laufzeiten zurücksetzen";
+#endif
+#if PROFILER_ENABLED
+static const char CMD_PROF[] PROGMEM = "prof";
+static const char CMD_PROF_TEXT[] PROGMEM = "Programmzähler-Histogramm (für tools/hsprof)";
+static const char CMD_PROF_RESET[] PROGMEM = "prof reset";
+static const char CMD_PROF_RESET_TEXT[] PROGMEM = "Profiler zurücksetzen";
+#endif
+
+static const SerialCommand COMMANDS[] PROGMEM = {
+  { CMD_HELP, CMD_HELP_TEXT, printHelp },
+#if PERF_ENABLED
+  { CMD_PERF, CMD_PERF_TEXT, perfPrintReport },
+  { CMD_PERF_CSV, CMD_PERF_CSV_TEXT, perfPrintCsv },
+  { CMD_PERF_RESET, CMD_PERF_RESET_TEXT, perfReset },
+#endif
+#if PROFILER_ENABLED
+  { CMD_PROF, CMD_PROF_TEXT, profilerPrint },
+  { CMD_PROF_RESET, CMD_PROF_RESET_TEXT, profilerReset },
+#endif
+};
+
+static const uint8_t COMMAND_COUNT = sizeof(COMMANDS) / sizeof(COMMANDS[0]);
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static char lineBuffer[SERIAL_COMMAND_MAX_LENGTH + 1];
+static uint8_t lineLength = 0;
+static bool lineOverflow = false;
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static void printHelp() {
+  Serial.println(F("Befehle:"));
+  for (uint8_t i = 0; i < COMMAND_COUNT; i++) {
+    Serial.print(F("  "));
+    Serial.print((const __FlashStringHelper*)pgm_read_ptr(&COMMANDS[i].name));
+    Serial.print(F(" - "));
+    Serial.println((const __FlashStringHelper*)pgm_read_ptr(&COMMANDS[i].help));
+  }
+}
+
+static void executeLine() {
+  for (uint8_t i = 0; i < COMMAND_COUNT; i++) {
+    const char* name = (const char*)pgm_read_ptr(&COMMANDS[i].name);
+    if (strcmp_P(lineBuffer, name) == 0) {
+      CommandHandler handler = (CommandHandler)pgm_read_ptr(&COMMANDS[i].handler);
+      handler();
+      return;
+    }
+  }
+  Serial.print(F("Unbekannter Befehl: "));
+  Serial.println(lineBuffer);
+}
+
+// ==============================================
+// SCHNITTSTELLE
+// ==============================================
+
+void serialCommandPoll() {
+  int available = Serial.available();
+  while (available-- > 0) {
+    char c = (char)Serial.read();
+
+    if (c != '\r' && c != '\n') {
+      if (lineLength < SERIAL_COMMAND_MAX_LENGTH) {
+        lineBuffer[lineLength++] = c;
+      } else {
+        lineOverflow = true;
+      }
+      continue;
+    }
+
+    // Zeilenende (CR, LF oder CRLF); leere Zeilen ignorieren
+    if (lineLength > 0 && !lineOverflow) {
+      lineBuffer[lineLength] = '\0';
+      executeLine();
+    }
+    lineLength = 0;
+    lineOverflow = false;
+  }
+}
@@ -0,0 +1,30 @@
+/*
+ * Serielle Befehle für das Umweltkontrollsystem
+ * Zeilenweise Diagnosebefehle über den seriellen Monitor
+ *
+ * Der Task liest nur die bereits empfangenen Bytes (nie blockierend) in
+ * einen kurzen Zeilenpuffer; eine Zeile endet mit CR oder LF. Befehle
+ * stehen in einer Tabelle in serial_command.cpp, "help" listet sie auf.
+ * Antworten gehen immer als Text hinaus (auch ohne DEBUG_ENABLED, sie
+ * wurden ja ausdrücklich angefordert). Mit TELEMETRY_ENABLED stören sie
+ * den Rahmenstrom bis zum nächsten Trennbyte; hstelemetry zählt das als
+ * Rahmenfehler.
+ */
+
+#ifndef SERIAL_COMMAND_H
+#define SERIAL_COMMAND_H
+
+#include "config.h"
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Liest empfangene Zeichen und führt vollständige Befehle aus.
+ *
+ * Als Scheduler-Task aufrufen. Zu lange Zeilen werden verworfen.
+ */
+void serialCommandPoll();
+
+#endif // SERIAL_COMMAND_H
@@ -0,0 +1,180 @@
+/*
+ * Streaming-Statistik für verrauschte Messkanäle
+ * Gleitender Median und Perzentile über ein festes Fenster
+ *
+ * Das Fenster wird zusätzlich zur Einfügereihenfolge sortiert gehalten.
+ * Jeder neue Messwert ersetzt den ältesten: Position per binärer Suche,
+ * Verschieben nur des Bereichs zwischen alter und neuer Position.
+ * Median und Perzentile sind danach reine Indexzugriffe (O(1)).
+ * Keine dynamische Speicherverwaltung - beide Puffer liegen im Objekt.
+ */
+
+#ifndef STREAMING_STATS_H
+#define STREAMING_STATS_H
+
+#include <stdint.h>
+#include <string.h>
+
+// ==============================================
+// SORTIERTES FENSTER (BASISKLASSE)
+// ==============================================
+
+/**
+ * @brief Gleitendes Fenster der letzten N Werte, zusätzlich sortiert.
+ *
+ * @tparam T Wertetyp (Ganzzahl oder Float, muss mit < vergleichbar sein)
+ * @tparam N Fenstergröße (1-255)
+ */
+template <typename T, uint8_t N>
+class SortedWindow {
+ public:
+  SortedWindow() : count_(0), head_(0) {}
+
+  /**
+   * @brief Fügt einen Messwert hinzu und verdrängt bei vollem Fenster den ältesten.
+   *
+   * @param value Neuer Messwert
+   */
+  void add(T value) {
+    if (count_ < N) {
+      insertAt(lowerBound(value, 0, count_), value);
+      count_++;
+    } else {
+      replace(history_[head_], value);
+    }
+    history_[head_] = value;
+    head_ = (head_ + 1 >= N) ? 0 : head_ + 1;
+  }
+
+  /** @brief Verwirft alle Messwerte. */
+  void clear() {
+    count_ = 0;
+    head_ = 0;
+  }
+
+  /** @return Anzahl Werte im Fenster (0-N) */
+  uint8_t size() const { return count_; }
+
+  /** @return true wenn das Fenster vollständig gefüllt ist */
+  bool full() const { return count_ == N; }
+
+  /**
+   * @brief Wert an einer Rangposition (0 = kleinster Wert).
+   *
+   * @param rank Rang (0 bis size()-1)
+   * @return Wert an dieser Position
+   */
+  T atRank(uint8_t rank) const { return sorted_[rank]; }
+
+  /** @return Kleinster Wert im Fenster */
+  T minimum() const { return count_ ? sorted_[0] : T(); }
+
+  /** @return Größter Wert im Fenster */
+  T maximum() const { return count_ ? sorted_[count_ - 1] : T(); }
+
+ protected:
+  // Erste Position im Bereich [first, last), deren Wert nicht kleiner als value ist
+  uint8_t lowerBound(T value, uint8_t first, uint8_t last) const {
+    while (first < last) {
+      uint8_t mid = first + ((last - first) >> 1);
+      if (sorted_[mid] < value) {
+        first = mid + 1;
+      } else {
+        last = mid;
+      }
+    }
+    return first;
+  }
+
+  void insertAt(uint8_t pos, T value) {
+    memmove(&sorted_[pos + 1], &sorted_[pos], (count_ - pos) * sizeof(T));
+    sorted_[pos] = value;
+  }
+
+  // Ersetzt oldValue durch newValue und verschiebt nur den Bereich dazwischen
+  void replace(T oldValue, T newValue) {
+    uint8_t oldPos = lowerBound(oldValue, 0, count_);
+    if (newValue < oldValue) {
+      uint8_t newPos = lowerBound(newValue, 0, oldPos);
+      memmove(&sorted_[newPos + 1], &sorted_[newPos], (oldPos - newPos) * sizeof(T));
+      sorted_[newPos] = newValue;
+    } else {
+      // Letzte Position im Bereich (oldPos, count_), deren Wert kleiner als newValue ist
+      uint8_t newPos = lowerBound(newValue, oldPos + 1, count_) - 1;
+      memmove(&sorted_[oldPos], &sorted_[oldPos + 1], (newPos - oldPos) * sizeof(T));
+      sorted_[newPos] = newValue;
+    }
+  }
+
+  T history_[N];     // Werte in Einfügereihenfolge (Ring)
+  T sorted_[N];      // Dieselben Werte aufsteigend sortiert
+  uint8_t count_;
+  uint8_t head_;
+};
+
+// ==============================================
+// GLEITENDER MEDIAN
+// ==============================================
+
+/**
+ * @brief Gleitender Median über die letzten N Werte.
+ *
+ * Bei gerader Anzahl wird wie bisher (getMedianNum) der Mittelwert
+ * der beiden mittleren Werte geliefert.
+ *
+ * @tparam T Wertetyp
+ * @tparam N Fenstergröße (1-255)
+ */
+template <typename T, uint8_t N>
+class StreamingMedian : public SortedWindow<T, N> {
+ public:
+  /**
+   * @brief Aktueller Median des Fensters (O(1)).
+   *
+   * @return Median, T() wenn das Fenster leer ist
+   */
+  T median() const {
+    uint8_t n = this->count_;
+    if (n == 0) return T();
+    if (n & 1) return this->sorted_[n >> 1];
+    return (this->sorted_[(n >> 1) - 1] + this->sorted_[n >> 1]) / 2;
+  }
+};
+
+// ==============================================
+// GLEITENDE PERZENTILE
+// ==============================================
+
+/**
+ * @brief Gleitende Perzentile (z.B. p10/p90-Band) über die letzten N Werte.
+ *
+ * Nearest-Rank-Verfahren ohne Interpolation.
+ *
+ * @tparam T Wertetyp
+ * @tparam N Fenstergröße (1-255)
+ */
+template <typename T, uint8_t N>
+class StreamingPercentile : public StreamingMedian<T, N> {
+ public:
+  /**
+   * @brief Perzentil des Fensters (O(1)).
+   *
+   * @param percent Perzentil in Prozent (0-100)
+   * @return Wert am entsprechenden Rang, T() wenn das Fenster leer ist
+   */
+  T percentile(uint8_t percent) const {
+    uint8_t n = this->count_;
+    if (n == 0) return T();
+    if (percent > 100) percent = 100;
+    uint8_t rank = (uint8_t)(((uint16_t)percent * (n - 1) + 50) / 100);
+    return this->sorted_[rank];
+  }
+
+  /** @return 10. Perzentil (untere Bandgrenze) */
+  T p10() const { return percentile(10); }
+
+  /** @return 90. Perzentil (obere Bandgrenze) */
+  T p90() const { return percentile(90); }
+};
+
+#endif // STREAMING_STATS_H
@@ -0,0 +1,91 @@
+/*
+ * Implementierung des TDS-Umrechnungsmoduls
+ */
+
+#include "tds_converter.h"
+
+#ifdef ARDUINO
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#endif
+
+// ==============================================
+// TABELLEN-ERZEUGUNG (COMPILE-ZEIT)
+// ==============================================
+
+// Kompensationsfaktor 1 / (1 + 0.02 * (T - 25)) = 500 / (250 + T_deci) in Q12
+static constexpr uint16_t tdsFactorQ12(int16_t tempDeci) {
+  return (uint16_t)((((uint32_t)500 << 12) + (250 + tempDeci) / 2) / (uint32_t)(250 + tempDeci));
+}
+
+// Abstand der Stützstellen in ADC-Codes (2^TDS_LUT_SHIFT)
+static constexpr uint8_t TDS_LUT_SHIFT = 2;
+
+// Größter kompensierter Code (bei -10 °C) bestimmt die Tabellengröße
+static constexpr uint32_t TDS_MAX_CODE_Q12 = 1023UL * tdsFactorQ12(TDS_TEMP_MIN_DECI);
+static constexpr uint16_t TDS_LUT_SIZE = (uint16_t)(TDS_MAX_CODE_Q12 >> (12 + TDS_LUT_SHIFT)) + 2;
+
+// Polynom der Gravity-Formel für einen (kompensierten) ADC-Code, Ergebnis in Q4.
+// Ganzzahlig mit gemeinsamem Nenner 100 * 2^30, damit die Tabelle unabhängig
+// von der double-Genauigkeit des Compilers (AVR: 32 bit) exakt ist.
+static constexpr uint32_t tdsPolynomialQ4(uint32_t code) {
+  int64_t c = code;
+  int64_t numerator = 13342LL * 125 * c * c * c
+                    - 25586LL * 25 * 1024 * c * c
+                    + 85739LL * 5 * 1048576 * c;
+  // * 0.5 (Formel) * 16 (Q4) = * 8
+  int64_t denominator = 100LL * (1LL << 30) / 8;
+  return (uint32_t)((numerator + denominator / 2) / denominator);
+}
+
+struct TdsTable {
+  uint32_t ppmQ4[TDS_LUT_SIZE];
+};
+
+static constexpr TdsTable makeTdsTable() {
+  TdsTable table = {};
+  for (uint16_t i = 0; i < TDS_LUT_SIZE; i++) {
+    table.ppmQ4[i] = tdsPolynomialQ4((uint32_t)i << TDS_LUT_SHIFT);
+  }
+  return table;
+}
+
+static constexpr TdsTable tdsTable PROGMEM = makeTdsTable();
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static int16_t cachedTempDeci = TDS_TEMP_REF_DECI;
+static uint16_t cachedFactorQ12 = tdsFactorQ12(TDS_TEMP_REF_DECI);
+
+// ==============================================
+// UMRECHNUNG
+// ==============================================
+
+uint32_t tdsCodeToPpmQ4(uint16_t adcCode, int16_t tempDeci) {
+  if (adcCode > 1023) adcCode = 1023;
+  if (tempDeci < TDS_TEMP_MIN_DECI) tempDeci = TDS_TEMP_MIN_DECI;
+  if (tempDeci > TDS_TEMP_MAX_DECI) tempDeci = TDS_TEMP_MAX_DECI;
+
+  // Division nur bei Temperaturwechsel
+  if (tempDeci != cachedTempDeci) {
+    cachedTempDeci = tempDeci;
+    cachedFactorQ12 = tdsFactorQ12(tempDeci);
+  }
+
+  // Kompensierter Code in Q12, aufgeteilt in Stützstelle und 8-bit-Bruchteil
+  uint32_t codeQ12 = (uint32_t)adcCode * cachedFactorQ12;
+  uint16_t index = (uint16_t)(codeQ12 >> (12 + TDS_LUT_SHIFT));
+  uint8_t fraction = (uint8_t)(codeQ12 >> (12 + TDS_LUT_SHIFT - 8));
+
+  uint32_t low = pgm_read_dword(&tdsTable.ppmQ4[index]);
+  uint32_t high = pgm_read_dword(&tdsTable.ppmQ4[index + 1]);
+  return low + (((high - low) * fraction + 128) >> 8);
+}
+
+uint32_t tdsCodeToPpm(uint16_t adcCode, int16_t tempDeci) {
+  return (tdsCodeToPpmQ4(adcCode, tempDeci) + (1 << (TDS_PPM_FRAC_BITS - 1))) >> TDS_PPM_FRAC_BITS;
+}
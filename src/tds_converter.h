@@ -0,0 +1,57 @@
+/*
+ * TDS-Umrechnungsmodul für das Umweltkontrollsystem
+ * Festkomma-Umrechnung ADC-Median -> ppm ohne Float-Arithmetik
+ *
+ * Die bisherige Formel (Gravity TDS-Sensor)
+ *   V   = code * 5.0 / 1024
+ *   Vk  = V / (1 + 0.02 * (T - 25))
+ *   ppm = (133.42 * Vk^3 - 255.86 * Vk^2 + 857.39 * Vk) * 0.5
+ * wird aufgeteilt: Die Temperaturkompensation ist ein Q12-Faktor auf den
+ * ADC-Code, das Polynom steckt in einer zur Compile-Zeit (constexpr)
+ * erzeugten PROGMEM-Tabelle, zwischen deren Stützstellen linear
+ * interpoliert wird.
+ */
+
+#ifndef TDS_CONVERTER_H
+#define TDS_CONVERTER_H
+
+#include <stdint.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+const int16_t TDS_TEMP_MIN_DECI = -100;   // Untergrenze Kompensation: -10.0 °C
+const int16_t TDS_TEMP_MAX_DECI = 500;    // Obergrenze Kompensation: 50.0 °C
+const int16_t TDS_TEMP_REF_DECI = 250;    // Referenztemperatur: 25.0 °C
+
+const uint8_t TDS_PPM_FRAC_BITS = 4;      // ppm-Ergebnis in Q4 (1/16 ppm)
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Rechnet einen ADC-Code temperaturkompensiert in ppm um.
+ *
+ * Temperaturen außerhalb von -10..50 °C werden auf diesen Bereich
+ * begrenzt. Der Kompensationsfaktor wird nur bei Temperaturwechsel neu
+ * berechnet (eine Division), sonst sind es eine Multiplikation, ein
+ * Tabellenzugriff und eine Interpolation.
+ *
+ * @param adcCode ADC-Wert (0-1023, typischerweise der Median)
+ * @param tempDeci Wassertemperatur in 1/10 °C
+ * @return TDS-Wert in ppm als Q4-Festkommazahl (ppm * 16)
+ */
+uint32_t tdsCodeToPpmQ4(uint16_t adcCode, int16_t tempDeci);
+
+/**
+ * @brief Wie tdsCodeToPpmQ4(), gerundet auf ganze ppm.
+ *
+ * @param adcCode ADC-Wert (0-1023)
+ * @param tempDeci Wassertemperatur in 1/10 °C
+ * @return TDS-Wert in ppm
+ */
+uint32_t tdsCodeToPpm(uint16_t adcCode, int16_t tempDeci);
+
+#endif // TDS_CONVERTER_H
@@ -0,0 +1,139 @@
+/*
+ * Implementierung des Telemetrie-Moduls
+ */
+
+#include "telemetry.h"
+
+#if TELEMETRY_ENABLED
+
+#include "data_logger.h"
+#include "log_queue.h"
+#include "log_writer.h"
+#include "memory_monitor.h"
+#include "scheduler.h"
+#include "time_service.h"
+#include "twi_queue.h"
+#include "utilities.h"
+#include <Arduino.h>
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+static uint8_t telemetrySequence = 0;
+static TelemetryStats telemetryStats = {0, 0, 0};
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static uint16_t saturate16(unsigned long value) {
+  return value > 0xFFFF ? 0xFFFF : (uint16_t)value;
+}
+
+// Baut Kopf + Nutzdaten + CRC, kodiert und sendet ohne zu blockieren
+static bool sendFrame(uint8_t type, const void* body, uint8_t length) {
+  uint8_t frame[TELEMETRY_MAX_PAYLOAD];
+  uint8_t encoded[TELEMETRY_MAX_FRAME];
+
+  TelemetryHeader header = { type, telemetrySequence++ };
+  memcpy(frame, &header, sizeof(header));
+  memcpy(frame + sizeof(header), body, length);
+  uint8_t frameLength = sizeof(header) + length;
+  uint16_t crc = hslogCrc16(0xFFFF, frame, frameLength);
+  memcpy(frame + frameLength, &crc, sizeof(crc));
+  frameLength += sizeof(crc);
+
+  uint8_t encodedLength = telemetryCobsEncode(frame, frameLength, encoded);
+  encoded[encodedLength++] = 0x00;
+
+  // Nur ganze Rahmen senden: Serial.write() würde bei vollem Puffer warten
+  if (Serial.availableForWrite() < encodedLength) {
+    telemetryStats.dropped++;
+    return false;
+  }
+  Serial.write(encoded, encodedLength);
+  telemetryStats.frames++;
+  telemetryStats.bytes += encodedLength;
+  return true;
+}
+
+// ==============================================
+// RAHMEN
+// ==============================================
+
+void telemetryBegin() {
+  telemetrySendEvent(TELEMETRY_EVENT_BOOT, 0, TELEMETRY_VERSION);
+}
+
+bool telemetrySendSnapshot(const SensorSnapshot* snapshot) {
+  // Gleiche Festkommadarstellung wie im Binär-Log
+  LogEntry entry;
+  HsLogRecord record;
+  fillLogEntry(snapshot, &entry);
+  packLogRecord(&entry, &record);
+  return sendFrame(TELEMETRY_FRAME_SNAPSHOT, &record, sizeof(record));
+}
+
+bool telemetrySendEvent(uint8_t kind, uint8_t code, uint16_t value) {
+  TelemetryEvent event;
+  event.uptimeMs = millis();
+  event.epoch = timeServiceEpoch();
+  event.kind = kind;
+  event.code = code;
+  event.value = value;
+  return sendFrame(TELEMETRY_FRAME_EVENT, &event, sizeof(event));
+}
+
+bool telemetrySendHealth() {
+  TelemetryHealth health;
+  health.uptimeMs = millis();
+  health.freeRam = getFreeRAM();
+
+  unsigned long overruns = 0;
+  TaskStats task;
+  for (uint8_t id = 0; schedulerGetStats(id, &task); id++) {
+    overruns += task.overruns;
+  }
+  health.schedulerOverruns = saturate16(overruns);
+
+  LogQueueStats queue;
+  logQueueGetStats(&queue);
+  health.logDropped = saturate16(queue.dropped);
+  health.logHighWater = queue.highWater;
+
+  LogWriterStats writer;
+  logWriterGetStats(&writer);
+  health.logErrors = saturate16(writer.errors);
+
+  TwiStats twi;
+  twiGetStats(&twi);
+  health.i2cErrors = saturate16(twi.errors);
+
+  health.framesDropped = saturate16(telemetryStats.dropped);
+  health.lastError = getLastError();
+  health.flags = (isSDCardAvailable() ? TELEMETRY_HEALTH_SD_OK : 0) |
+                 (isRTCRunning() ? TELEMETRY_HEALTH_RTC_OK : 0);
+
+  // Stand der letzten Suche im System-Check
+  MemoryStats memory;
+  memoryMonitorGetStats(&memory);
+  health.stackPeak = memory.stackPeak;
+  health.heapPeak = memory.heapPeak;
+  health.ramMargin = memory.margin;
+  return sendFrame(TELEMETRY_FRAME_HEALTH, &health, sizeof(health));
+}
+
+bool telemetrySendTrace(const uint8_t* records, uint8_t length) {
+  if (length == 0 || length > TELEMETRY_TRACE_MAX_BODY) return false;
+  // Kein Platz: Meldungen bleiben im Trace-Puffer (kein Verwerfen, keine Sequenzlücke)
+  int encodedLength = sizeof(TelemetryHeader) + length + sizeof(uint16_t) + 2;
+  if (Serial.availableForWrite() < encodedLength) return false;
+  return sendFrame(TELEMETRY_FRAME_TRACE, records, length);
+}
+
+void telemetryGetStats(TelemetryStats* stats) {
+  *stats = telemetryStats;
+}
+
+#endif // TELEMETRY_ENABLED
@@ -0,0 +1,96 @@
+/*
+ * Telemetrie-Modul für das Umweltkontrollsystem
+ * Kompakte, CRC-gesicherte Binärrahmen auf der seriellen Schnittstelle
+ *
+ * Mit TELEMETRY_ENABLED ersetzt das Modul die Textausgabe: Pro
+ * Messzyklus geht ein Snapshot-Rahmen (45 statt ca. 150 Bytes CSV plus
+ * Debug-Zeilen) hinaus, dazu Ereignis-Rahmen (Start, Fehler) und mit dem
+ * System-Check ein Zustandsrahmen. Protokoll siehe telemetry_format.h,
+ * Dekodierung am PC mit tools/hstelemetry.
+ * Gesendet wird nie blockierend: Passt ein Rahmen nicht vollständig in
+ * den freien Platz des Sendepuffers, wird er verworfen und gezählt
+ * (Lücke in der Sequenznummer). Ein Rahmen ist kleiner als der 64-Byte-
+ * Sendepuffer; bei SERIAL_BAUD = 115200 ist er nach ca. 4 ms draußen.
+ * Ohne TELEMETRY_ENABLED sind alle Funktionen leer.
+ */
+
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "config.h"
+#include "sensor_snapshot.h"
+#include "telemetry_format.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Zähler der gesendeten und verworfenen Rahmen.
+ */
+struct TelemetryStats {
+  unsigned long frames;     ///< Gesendete Rahmen
+  unsigned long bytes;      ///< Gesendete Bytes (kodiert, inkl. Trennbyte)
+  unsigned long dropped;    ///< Verworfene Rahmen (Sendepuffer voll)
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+#if TELEMETRY_ENABLED
+
+/**
+ * @brief Sendet das Start-Ereignis. Nach Serial.begin() aufrufen.
+ */
+void telemetryBegin();
+
+/**
+ * @brief Sendet einen Messzyklus als Snapshot-Rahmen.
+ *
+ * @param snapshot Snapshot des aktuellen Zyklus
+ * @return false wenn der Rahmen verworfen wurde
+ */
+bool telemetrySendSnapshot(const SensorSnapshot* snapshot);
+
+/**
+ * @brief Sendet ein Ereignis.
+ *
+ * @param kind TELEMETRY_EVENT_*
+ * @param code Ereignisabhängiger Code (z.B. SystemError)
+ * @param value Ereignisabhängiger Wert
+ * @return false wenn der Rahmen verworfen wurde
+ */
+bool telemetrySendEvent(uint8_t kind, uint8_t code, uint16_t value);
+
+/**
+ * @brief Sendet den Systemzustand (RAM, Scheduler, Log, I2C).
+ */
+bool telemetrySendHealth();
+
+/**
+ * @brief Sendet ganze Trace-Meldungen (siehe trace.h) als einen Rahmen.
+ *
+ * @param records Eine oder mehrere Meldungen
+ * @param length Gesamtlänge, höchstens TELEMETRY_TRACE_MAX_BODY
+ * @return false wenn der Rahmen verworfen wurde
+ */
+bool telemetrySendTrace(const uint8_t* records, uint8_t length);
+
+/**
+ * @brief Liefert die Sendezähler.
+ */
+void telemetryGetStats(TelemetryStats* stats);
+
+#else
+
+inline void telemetryBegin() {}
+inline bool telemetrySendSnapshot(const SensorSnapshot*) { return false; }
+inline bool telemetrySendEvent(uint8_t, uint8_t, uint16_t) { return false; }
+inline bool telemetrySendHealth() { return false; }
+inline bool telemetrySendTrace(const uint8_t*, uint8_t) { return false; }
+inline void telemetryGetStats(TelemetryStats* stats) { *stats = TelemetryStats(); }
+
+#endif // TELEMETRY_ENABLED
+
+#endif // TELEMETRY_H
@@ -0,0 +1,160 @@
+/*
+ * Binäres Telemetrie-Protokoll für das Umweltkontrollsystem
+ * Gemeinsame Definition für Firmware (telemetry) und Host-Werkzeuge (tools/hstelemetry)
+ *
+ * Rahmenaufbau vor der Kodierung (alle Zahlen little-endian):
+ *   uint8_t  type       TELEMETRY_FRAME_*
+ *   uint8_t  sequence   Laufende Rahmennummer (mit Überlauf, Lücken = verlorene Rahmen)
+ *   ...      Nutzdaten  je nach Typ (siehe unten)
+ *   uint16_t CRC-16/CCITT über type, sequence und Nutzdaten
+ *
+ * Der Rahmen wird COBS-kodiert (Consistent Overhead Byte Stuffing) und
+ * mit einem 0x00-Byte abgeschlossen. Da 0x00 im kodierten Rahmen nie
+ * vorkommt, findet der Empfänger nach Störungen oder beim Einstieg in
+ * einen laufenden Strom am nächsten Trennbyte wieder Anschluss.
+ * Die Datei ist ohne Arduino-Header übersetzbar.
+ */
+
+#ifndef TELEMETRY_FORMAT_H
+#define TELEMETRY_FORMAT_H
+
+#include <stdint.h>
+#include "log_format.h"
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+#define TELEMETRY_VERSION 2
+
+// Rahmentypen
+enum TelemetryFrameType {
+  TELEMETRY_FRAME_SNAPSHOT = 1,   ///< Messzyklus (HsLogRecord)
+  TELEMETRY_FRAME_EVENT = 2,      ///< Einzelereignis (TelemetryEvent)
+  TELEMETRY_FRAME_HEALTH = 3,     ///< Systemzustand (TelemetryHealth)
+  TELEMETRY_FRAME_TRACE = 4       ///< Tokenisierte Debug-Meldungen (siehe trace_format.h)
+};
+
+// Ereignisarten in TelemetryEvent::kind
+enum TelemetryEventKind {
+  TELEMETRY_EVENT_BOOT = 1,           ///< Systemstart, value = TELEMETRY_VERSION
+  TELEMETRY_EVENT_ERROR = 2,          ///< reportError(), code = SystemError
+  TELEMETRY_EVENT_SENSORS_READY = 3,  ///< Aufwärmphase abgeschlossen
+  TELEMETRY_EVENT_LOG_DROPPED = 4     ///< Log-Queue voll, value = verworfene Einträge gesamt
+};
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Kopf eines Telemetrie-Rahmens.
+ */
+struct __attribute__((packed)) TelemetryHeader {
+  uint8_t type;             ///< TELEMETRY_FRAME_*
+  uint8_t sequence;         ///< Laufende Rahmennummer
+};
+
+/**
+ * @brief Nutzdaten eines Ereignis-Rahmens (12 Bytes).
+ */
+struct __attribute__((packed)) TelemetryEvent {
+  uint32_t uptimeMs;        ///< millis() beim Ereignis
+  uint32_t epoch;           ///< Unix-Zeit (UTC), 0 wenn unbekannt
+  uint8_t kind;             ///< TELEMETRY_EVENT_*
+  uint8_t code;             ///< Ereignisabhängig (z.B. SystemError)
+  uint16_t value;           ///< Ereignisabhängig
+};
+
+/**
+ * @brief Nutzdaten eines Systemzustands-Rahmens (25 Bytes).
+ *
+ * Zähler sind seit dem Start kumuliert und bei 65535 gesättigt.
+ */
+struct __attribute__((packed)) TelemetryHealth {
+  uint32_t uptimeMs;        ///< millis()
+  uint16_t freeRam;         ///< Freier Speicher zwischen Heap und Stack (Bytes)
+  uint16_t schedulerOverruns; ///< Verfehlte Deadlines aller Tasks
+  uint16_t logDropped;      ///< Verworfene Log-Einträge (Queue voll)
+  uint16_t logErrors;       ///< Fehlgeschlagene SD-Schreibvorgänge
+  uint16_t i2cErrors;       ///< I2C-Anfragen mit NACK, Busfehler oder Timeout
+  uint16_t framesDropped;   ///< Nicht gesendete Telemetrie-Rahmen (Sendepuffer voll)
+  uint8_t logHighWater;     ///< Höchster Füllstand der Log-Queue
+  uint8_t lastError;        ///< Letzter SystemError
+  uint8_t flags;            ///< TELEMETRY_HEALTH_*
+  uint16_t stackPeak;       ///< Tiefster Stack seit dem Start (Stack-Painting)
+  uint16_t heapPeak;        ///< Größte Heap-Ausdehnung seit dem Start
+  uint16_t ramMargin;       ///< Nie benutzter Bereich zwischen Heap und Stack
+};
+
+// Bits in TelemetryHealth::flags
+#define TELEMETRY_HEALTH_SD_OK 0x01
+#define TELEMETRY_HEALTH_RTC_OK 0x02
+
+static_assert(sizeof(TelemetryHeader) == 2, "TelemetryHeader muss 2 Bytes groß sein");
+static_assert(sizeof(TelemetryEvent) == 12, "TelemetryEvent muss 12 Bytes groß sein");
+static_assert(sizeof(TelemetryHealth) == 25, "TelemetryHealth muss 25 Bytes groß sein");
+
+// Größter Rahmen: Kopf + Messzyklus + CRC; COBS fügt bis 254 Bytes genau ein Byte hinzu
+#define TELEMETRY_MAX_PAYLOAD (sizeof(TelemetryHeader) + sizeof(HsLogRecord) + sizeof(uint16_t))
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_PAYLOAD + 2)   // + COBS-Codebyte + Trennbyte
+
+// Meldungen eines Trace-Rahmens dürfen den größten Rahmen nicht überschreiten
+#define TELEMETRY_TRACE_MAX_BODY sizeof(HsLogRecord)
+
+static_assert(TELEMETRY_MAX_PAYLOAD < 254, "Rahmen muss in einen COBS-Block passen");
+
+// ==============================================
+// COBS
+// ==============================================
+
+/**
+ * @brief COBS-Kodierung eines Rahmens (ohne Trennbyte).
+ *
+ * @param input Rahmen (darf 0x00 enthalten), höchstens 253 Bytes
+ * @param length Länge des Rahmens
+ * @param output Ziel, mindestens length + 1 Bytes
+ * @return Länge der Kodierung (length + 1)
+ */
+static inline uint8_t telemetryCobsEncode(const uint8_t* input, uint8_t length, uint8_t* output) {
+  uint8_t codeIndex = 0;
+  uint8_t code = 1;
+  uint8_t out = 1;
+  for (uint8_t i = 0; i < length; i++) {
+    if (input[i] == 0) {
+      output[codeIndex] = code;
+      codeIndex = out++;
+      code = 1;
+    } else {
+      output[out++] = input[i];
+      code++;
+    }
+  }
+  output[codeIndex] = code;
+  return out;
+}
+
+/**
+ * @brief COBS-Dekodierung eines Rahmens (ohne Trennbyte).
+ *
+ * @param input Kodierter Rahmen
+ * @param length Länge der Kodierung
+ * @param output Ziel, mindestens length Bytes
+ * @return Länge des Rahmens, -1 bei ungültiger Kodierung
+ */
+static inline int telemetryCobsDecode(const uint8_t* input, uint16_t length, uint8_t* output) {
+  uint16_t in = 0;
+  uint16_t out = 0;
+  while (in < length) {
+    uint8_t code = input[in++];
+    if (code == 0 || in + code - 1 > length) return -1;
+    for (uint8_t i = 1; i < code; i++) {
+      output[out++] = input[in++];
+    }
+    // Codebyte < 0xFF steht für eine 0x00, außer am Rahmenende
+    if (code < 0xFF && in < length) output[out++] = 0;
+  }
+  return out;
+}
+
+#endif // TELEMETRY_FORMAT_H
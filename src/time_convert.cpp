@@ -0,0 +1,140 @@
+/*
+ * Implementierung des Zeitumrechnungsmoduls
+ */
+
+#include "time_convert.h"
+
+#ifdef ARDUINO
+#include <avr/pgmspace.h>
+#else
+#define PROGMEM
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#endif
+
+// ==============================================
+// KALENDERRECHNUNG
+// ==============================================
+
+// Verfahren nach H. Hinnant ("chrono-compatible low-level date algorithms"),
+// auf vorzeichenlose Werte ab 1970 beschränkt. Jahre beginnen intern am
+// 1. März, damit der Schalttag am Jahresende liegt.
+static constexpr uint32_t daysFromCivilImpl(uint16_t year, uint8_t month, uint8_t day) {
+  uint16_t y = year - (month <= 2 ? 1 : 0);
+  uint32_t era = y / 400;
+  uint32_t yoe = y - era * 400;                                        // [0, 399]
+  uint32_t doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;  // [0, 365]
+  uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;                // [0, 146096]
+  return era * 146097 + doe - 719468;
+}
+
+uint32_t daysFromCivil(uint16_t year, uint8_t month, uint8_t day) {
+  return daysFromCivilImpl(year, month, day);
+}
+
+void epochToCivil(uint32_t epoch, CivilTime* civil) {
+  uint32_t days = epoch / 86400;
+  uint32_t secondsOfDay = epoch - days * 86400;
+
+  uint32_t z = days + 719468;
+  uint32_t era = z / 146097;
+  uint32_t doe = z - era * 146097;
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint16_t mp = (uint16_t)((5 * doy + 2) / 153);
+  uint8_t month = mp < 10 ? mp + 3 : mp - 9;
+
+  civil->year = (uint16_t)(yoe + era * 400) + (month <= 2 ? 1 : 0);
+  civil->month = month;
+  civil->day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+
+  uint16_t minutes = (uint16_t)(secondsOfDay / 60);
+  civil->hour = (uint8_t)(minutes / 60);
+  civil->minute = (uint8_t)(minutes % 60);
+  civil->second = (uint8_t)(secondsOfDay - minutes * 60UL);
+}
+
+uint32_t civilToEpoch(const CivilTime* civil) {
+  return daysFromCivil(civil->year, civil->month, civil->day) * 86400UL +
+         civil->hour * 3600UL + civil->minute * 60UL + civil->second;
+}
+
+// ==============================================
+// UMSTELLUNGSTABELLE (COMPILE-ZEIT)
+// ==============================================
+
+// Letzter Sonntag des Monats um 01:00 UTC (EU-weit einheitlich)
+static constexpr uint32_t lastSundayTransition(uint16_t year, uint8_t month) {
+  uint32_t days = daysFromCivilImpl(year, month, 31);
+  uint32_t weekday = (days + 4) % 7;  // 1970-01-01 war ein Donnerstag (0 = Sonntag)
+  return (days - weekday) * 86400UL + 3600UL;
+}
+
+static constexpr uint8_t TZ_TRANSITION_COUNT = (TZ_TABLE_LAST_YEAR - TZ_TABLE_FIRST_YEAR + 1) * 2;
+
+// Gerade Indizes: Beginn MESZ (März), ungerade: Ende MESZ (Oktober)
+struct TzTable {
+  uint32_t transitions[TZ_TRANSITION_COUNT];
+};
+
+static constexpr TzTable makeTzTable() {
+  TzTable table = {};
+  for (uint16_t year = TZ_TABLE_FIRST_YEAR; year <= TZ_TABLE_LAST_YEAR; year++) {
+    uint8_t i = (uint8_t)((year - TZ_TABLE_FIRST_YEAR) * 2);
+    table.transitions[i] = lastSundayTransition(year, 3);
+    table.transitions[i + 1] = lastSundayTransition(year, 10);
+  }
+  return table;
+}
+
+static constexpr TzTable tzTable PROGMEM = makeTzTable();
+
+static_assert(lastSundayTransition(2025, 3) == 1743296400UL, "MESZ-Beginn 2025 muss 30.03. 01:00 UTC sein");
+static_assert(lastSundayTransition(2025, 10) == 1761440400UL, "MESZ-Ende 2025 muss 26.10. 01:00 UTC sein");
+
+static inline uint32_t tzTransition(uint8_t index) {
+  return pgm_read_dword(&tzTable.transitions[index]);
+}
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+// Zwischengespeicherter Offset und sein Gültigkeitsbereich [from, until)
+static uint32_t cachedFrom = 1;
+static uint32_t cachedUntil = 0;
+static int32_t cachedOffset = TZ_OFFSET_MEZ;
+
+// ==============================================
+// ZEITZONE
+// ==============================================
+
+int32_t localOffsetSeconds(uint32_t epoch, bool* summerTime) {
+  if (epoch < cachedFrom || epoch >= cachedUntil) {
+    // Erste Umstellung nach epoch suchen (binäre Suche, höchstens 8 Schritte)
+    uint8_t low = 0;
+    uint8_t high = TZ_TRANSITION_COUNT;
+    while (low < high) {
+      uint8_t mid = (low + high) / 2;
+      if (tzTransition(mid) <= epoch) {
+        low = mid + 1;
+      } else {
+        high = mid;
+      }
+    }
+
+    cachedFrom = low > 0 ? tzTransition(low - 1) : 0;
+    cachedUntil = low < TZ_TRANSITION_COUNT ? tzTransition(low) : 0xFFFFFFFFUL;
+    // Zuletzt vergangene Umstellung war ein Sommerzeitbeginn (gerader Index)?
+    cachedOffset = (low > 0 && ((low - 1) & 1) == 0) ? TZ_OFFSET_MESZ : TZ_OFFSET_MEZ;
+  }
+
+  if (summerTime) *summerTime = (cachedOffset == TZ_OFFSET_MESZ);
+  return cachedOffset;
+}
+
+bool epochToLocal(uint32_t epoch, CivilTime* local) {
+  bool summerTime;
+  int32_t offset = localOffsetSeconds(epoch, &summerTime);
+  epochToCivil(epoch + (uint32_t)offset, local);
+  return summerTime;
+}
@@ -0,0 +1,86 @@
+/*
+ * Zeitumrechnungsmodul für das Umweltkontrollsystem
+ * Unix-Zeit (UTC) -> Kalenderdatum und MEZ/MESZ ohne Kalenderregeln zur Laufzeit
+ *
+ * Die EU-Umstellungszeitpunkte (letzter Sonntag im März bzw. Oktober,
+ * jeweils 01:00 UTC) für 2020-2099 liegen als zur Compile-Zeit
+ * (constexpr) erzeugte PROGMEM-Tabelle vor. Der aktuelle Offset wird
+ * samt Gültigkeitsende zwischengespeichert; im Normalfall kostet eine
+ * Umrechnung einen Vergleich plus die Datumsberechnung civilFromDays().
+ * Außerhalb des Tabellenbereichs gilt MEZ.
+ * Ohne Arduino-Abhängigkeiten, damit es auch auf dem PC übersetzbar ist.
+ */
+
+#ifndef TIME_CONVERT_H
+#define TIME_CONVERT_H
+
+#include <stdint.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+const uint16_t TZ_TABLE_FIRST_YEAR = 2020;   // Erstes Jahr der Umstellungstabelle
+const uint16_t TZ_TABLE_LAST_YEAR = 2099;    // Letztes Jahr der Umstellungstabelle
+const int32_t TZ_OFFSET_MEZ = 3600;          // MEZ = UTC+1 (Sekunden)
+const int32_t TZ_OFFSET_MESZ = 7200;         // MESZ = UTC+2 (Sekunden)
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Kalenderdatum und Uhrzeit ohne Zeitzonenbezug.
+ */
+struct CivilTime {
+  uint16_t year;    ///< Jahr (4-stellig)
+  uint8_t month;    ///< Monat (1-12)
+  uint8_t day;      ///< Tag (1-31)
+  uint8_t hour;     ///< Stunde (0-23)
+  uint8_t minute;   ///< Minute (0-59)
+  uint8_t second;   ///< Sekunde (0-59)
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Tage seit 1970-01-01 für ein Kalenderdatum (ab 1970).
+ */
+uint32_t daysFromCivil(uint16_t year, uint8_t month, uint8_t day);
+
+/**
+ * @brief Zerlegt eine Unix-Zeit in Kalenderdatum und Uhrzeit.
+ *
+ * Reine Ganzzahlrechnung ohne Schleifen über Jahre oder Monate.
+ *
+ * @param epoch Sekunden seit 1970-01-01 00:00:00
+ * @param civil Ausgabe
+ */
+void epochToCivil(uint32_t epoch, CivilTime* civil);
+
+/**
+ * @brief Unix-Zeit eines Kalenderdatums (als UTC interpretiert).
+ */
+uint32_t civilToEpoch(const CivilTime* civil);
+
+/**
+ * @brief Offset der deutschen Lokalzeit zu UTC.
+ *
+ * @param epoch Unix-Zeit (UTC)
+ * @param summerTime Optional: Ausgabe true bei MESZ
+ * @return TZ_OFFSET_MEZ oder TZ_OFFSET_MESZ
+ */
+int32_t localOffsetSeconds(uint32_t epoch, bool* summerTime = 0);
+
+/**
+ * @brief Rechnet eine Unix-Zeit (UTC) in deutsche Lokalzeit um.
+ *
+ * @param epoch Unix-Zeit (UTC)
+ * @param local Ausgabe der Lokalzeit
+ * @return true bei MESZ, false bei MEZ
+ */
+bool epochToLocal(uint32_t epoch, CivilTime* local);
+
+#endif // TIME_CONVERT_H
@@ -0,0 +1,319 @@
+/*
+ * Implementierung des Zeitdienstes
+ */
+
+#include "time_service.h"
+#include "twi_queue.h"
+#include "trace.h"
+#include <Arduino.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+// Flanken mit kürzerem Abstand sind Störungen (Sollabstand 1000 ms)
+static const unsigned long TIME_SQW_MIN_INTERVAL_MS = 500;
+// Gangmessung erst nach so vielen Sekunden seit dem Bezugspunkt auswerten
+static const unsigned long TIME_DRIFT_MIN_SECONDS = 60;
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+// Zeitbezug: cacheEpoch galt ab dem millis()-Zeitpunkt cacheRefMillis.
+// cacheFromEdge = true: Bezug ist eine SQW-Flanke (Sekundenbeginn),
+// sonst der Zeitpunkt eines RTC-Lesevorgangs.
+static volatile unsigned long cacheEpoch = 0;
+static volatile unsigned long cacheRefMillis = 0;
+static volatile bool cacheFromEdge = false;
+static volatile bool cacheValid = false;
+
+// Von der ISR geschrieben
+static volatile unsigned long isrEdges = 0;
+static volatile unsigned long isrMissedEdges = 0;
+static volatile unsigned long isrGlitches = 0;
+
+static TimeServiceStats timeStats = {0, 0, 0, 0, 0, 0, 0, 0, false};
+static unsigned long lastSyncMillis = 0;
+
+// Laufender asynchroner RTC-Lesevorgang
+static bool syncPending = false;
+static bool syncWithEdge = false;
+static unsigned long syncEdges = 0;
+
+// Bezugspunkt der Gangmessung
+static bool driftRefValid = false;
+static unsigned long driftRefEpoch = 0;
+static unsigned long driftRefMillis = 0;
+
+// ==============================================
+// SQW-INTERRUPT
+// ==============================================
+
+// RTC_SQW_PIN = Digitalpin 3 = PE5 = INT5
+ISR(INT5_vect) {
+  unsigned long now = millis();
+  unsigned long elapsed = now - cacheRefMillis;
+
+  if (cacheFromEdge && elapsed < TIME_SQW_MIN_INTERVAL_MS) {
+    isrGlitches++;
+    return;
+  }
+
+  if (cacheValid) {
+    unsigned long seconds;
+    if (cacheFromEdge) {
+      // Regulär 1; ein größerer Abstand bedeutet verlorene Flanken
+      seconds = (elapsed + 500) / 1000;
+      if (seconds > 1) isrMissedEdges += seconds - 1;
+    } else {
+      // Erste Flanke nach einem RTC-Lesevorgang: beendet die gelesene Sekunde.
+      // Die Lesung liegt irgendwo in dieser Sekunde, der Abstand ist also
+      // (0, 1000] ms - aufrunden, sonst zählt elapsed = 1000 doppelt
+      seconds = (elapsed + 999) / 1000;
+      if (seconds == 0) seconds = 1;
+    }
+    cacheEpoch += seconds;
+  }
+
+  cacheRefMillis = now;
+  cacheFromEdge = true;
+  isrEdges++;
+}
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+struct TimeCacheCopy {
+  unsigned long epoch;
+  unsigned long refMillis;
+  unsigned long edges;
+  bool fromEdge;
+  bool valid;
+};
+
+static void copyCache(TimeCacheCopy* copy) {
+  noInterrupts();
+  copy->epoch = cacheEpoch;
+  copy->refMillis = cacheRefMillis;
+  copy->edges = isrEdges;
+  copy->fromEdge = cacheFromEdge;
+  copy->valid = cacheValid;
+  interrupts();
+}
+
+// Setzt den Bezug auf einen gerade gelesenen RTC-Wert (ohne Flankenbezug)
+static void anchorToRead(unsigned long epoch) {
+  noInterrupts();
+  cacheEpoch = epoch;
+  cacheRefMillis = millis();
+  cacheFromEdge = false;
+  cacheValid = true;
+  interrupts();
+}
+
+static void updateClockDrift(unsigned long epoch, unsigned long edgeMillis) {
+  if (!driftRefValid) {
+    driftRefEpoch = epoch;
+    driftRefMillis = edgeMillis;
+    driftRefValid = true;
+    return;
+  }
+
+  unsigned long seconds = epoch - driftRefEpoch;
+  if (seconds < TIME_DRIFT_MIN_SECONDS) return;
+
+  // Abweichung in ms pro 1000 s = ppm
+  long deviationMs = (long)(edgeMillis - driftRefMillis) - (long)(seconds * 1000UL);
+  timeStats.clockDriftPpm = deviationMs * 1000L / (long)seconds;
+}
+
+// ==============================================
+// STEUERUNG
+// ==============================================
+
+bool timeServiceBegin() {
+  TRACE(TIME_SERVICE_START);
+
+  // SQW ist ein Open-Drain-Ausgang
+  pinMode(RTC_SQW_PIN, INPUT_PULLUP);
+  if (!rtcEnableSquareWave()) {
+    TRACE(TIME_SQW_ENABLE_FAILED);
+  }
+
+  EIMSK &= ~_BV(INT5);
+  EICRB = (EICRB & ~(_BV(ISC51) | _BV(ISC50))) | _BV(ISC51);  // Fallende Flanke
+  EIFR = _BV(INTF5);
+  EIMSK |= _BV(INT5);
+
+  RTCData rtc;
+  lastSyncMillis = millis();
+  if (!readRTCData(&rtc)) {
+    timeStats.syncErrors++;
+    TRACE(TIME_NO_VALID_RTC);
+    return false;
+  }
+  anchorToRead(rtc.timestamp);
+  timeStats.syncs++;
+  return true;
+}
+
+// Wertet einen abgeschlossenen RTC-Lesevorgang aus
+static void finishSync(unsigned long now) {
+  syncPending = false;
+  lastSyncMillis = now;
+
+  RTCData rtc;
+  if (!rtcGetReadResult(&rtc)) {
+    timeStats.syncErrors++;
+    TRACE(TIME_SYNC_FAILED);
+    return;
+  }
+
+  TimeCacheCopy cache;
+  copyCache(&cache);
+
+  long diff = 0;
+  if (syncWithEdge) {
+    noInterrupts();
+    if (isrEdges != syncEdges) {
+      // Flanke während des Lesens: Zuordnung unklar, im nächsten Fenster wiederholen
+      interrupts();
+      lastSyncMillis = now - TIME_RESYNC_INTERVAL_MS;
+      return;
+    }
+    diff = (long)(rtc.timestamp - cacheEpoch);
+    cacheEpoch = rtc.timestamp;
+    interrupts();
+  } else {
+    if (cache.valid) {
+      diff = (long)(rtc.timestamp - (cache.epoch + (now - cache.refMillis) / 1000));
+    }
+    anchorToRead(rtc.timestamp);
+  }
+
+  timeStats.syncs++;
+  if (diff != 0 && cache.valid) {
+    timeStats.corrections++;
+    timeStats.lastCorrection = diff;
+    driftRefValid = false;
+    TRACE(TIME_CORRECTED, diff);
+  }
+  if (syncWithEdge) {
+    updateClockDrift(rtc.timestamp, cache.refMillis);
+  }
+}
+
+void timeServiceUpdate() {
+  unsigned long now = millis();
+
+  // Ergebnis eines im letzten Durchlauf gestarteten Lesevorgangs abholen
+  if (syncPending) {
+    if (rtcReadStatus() == TWI_STATUS_PENDING) return;
+    finishSync(now);
+    return;
+  }
+
+  TimeCacheCopy cache;
+  copyCache(&cache);
+
+  bool sqwActive = cache.fromEdge && (now - cache.refMillis) < TIME_SQW_TIMEOUT_MS;
+  if (sqwActive != timeStats.sqwActive) {
+    timeStats.sqwActive = sqwActive;
+    driftRefValid = false;
+    TRACE(TIME_SQW_STATE, (uint8_t)sqwActive);
+  }
+
+  unsigned long interval = sqwActive ? TIME_RESYNC_INTERVAL_MS : TIME_FALLBACK_RESYNC_MS;
+  if (now - lastSyncMillis < interval) return;
+
+  // Nur kurz nach einer Flanke lesen, sonst könnte die RTC schon weiter sein
+  if (sqwActive && (now - cache.refMillis) > TIME_SYNC_WINDOW_MS) return;
+
+  // Lesen mit hoher Priorität einreihen, Auswertung im nächsten Durchlauf
+  if (!rtcStartRead()) return;
+  syncPending = true;
+  syncWithEdge = sqwActive;
+  syncEdges = cache.edges;
+}
+
+// ==============================================
+// ZEITABFRAGE
+// ==============================================
+
+unsigned long timeServiceEpoch(uint16_t* millisecond) {
+  TimeCacheCopy cache;
+  copyCache(&cache);
+
+  if (!cache.valid) {
+    if (millisecond) *millisecond = 0;
+    return 0;
+  }
+
+  unsigned long elapsed = millis() - cache.refMillis;
+  if (millisecond) *millisecond = elapsed % 1000;
+  return cache.epoch + elapsed / 1000;
+}
+
+bool timeServiceNow(RTCData* data) {
+  if (!data) return false;
+  if (!cacheValid) {
+    return readRTCData(data);
+  }
+
+  uint16_t millisecond;
+  unsigned long epoch = timeServiceEpoch(&millisecond);
+  CivilTime now;
+  epochToCivil(epoch, &now);
+
+  data->year = now.year;
+  data->month = now.month;
+  data->day = now.day;
+  data->hour = now.hour;
+  data->minute = now.minute;
+  data->second = now.second;
+  data->millisecond = millisecond;
+  data->timestamp = epoch;
+  data->isValid = true;
+  data->isValid = isTimeValid(data);
+  return data->isValid;
+}
+
+// ==============================================
+// STATISTIK
+// ==============================================
+
+void timeServiceGetStats(TimeServiceStats* stats) {
+  *stats = timeStats;
+  noInterrupts();
+  stats->edges = isrEdges;
+  stats->missedEdges = isrMissedEdges;
+  stats->glitches = isrGlitches;
+  interrupts();
+}
+
+void timeServicePrintStats() {
+  TimeServiceStats stats;
+  timeServiceGetStats(&stats);
+
+  DEBUG_PRINTLN(F("=== ZEITDIENST ==="));
+  DEBUG_PRINT(F("SQW: "));
+  DEBUG_PRINT(stats.sqwActive ? F("aktiv") : F("FEHLT"));
+  DEBUG_PRINT(F(", Flanken: "));
+  DEBUG_PRINT(stats.edges);
+  DEBUG_PRINT(F(", fehlend: "));
+  DEBUG_PRINT(stats.missedEdges);
+  DEBUG_PRINT(F(", Störungen: "));
+  DEBUG_PRINTLN(stats.glitches);
+  DEBUG_PRINT(F("Abgleiche: "));
+  DEBUG_PRINT(stats.syncs);
+  DEBUG_PRINT(F(", Korrekturen: "));
+  DEBUG_PRINT(stats.corrections);
+  DEBUG_PRINT(F(" (zuletzt s: "));
+  DEBUG_PRINT(stats.lastCorrection);
+  DEBUG_PRINT(F("), Fehler: "));
+  DEBUG_PRINT(stats.syncErrors);
+  DEBUG_PRINT(F(", Gang ppm: "));
+  DEBUG_PRINTLN(stats.clockDriftPpm);
+}
@@ -0,0 +1,99 @@
+/*
+ * Zeitdienst für das Umweltkontrollsystem
+ * RTC-Zeit mit Millisekundenauflösung ohne I2C-Zugriff pro Abfrage
+ *
+ * Der DS1307 liefert an seinem SQW-Ausgang 1 Hz (RTC_SQW_PIN, INT5).
+ * Jede fallende Flanke markiert den Beginn einer neuen RTC-Sekunde; die
+ * ISR zählt die Unix-Zeit weiter und merkt sich den millis()-Zeitpunkt.
+ * Abfragen liefern Sekunde + (millis() - Flankenzeit) als Millisekunden.
+ * Die RTC-Register werden nur beim Start und danach alle
+ * TIME_RESYNC_INTERVAL_MS gelesen - kurz nach einer Flanke, damit der
+ * gelesene Wert eindeutig zur aktuellen Sekunde gehört. Abweichungen
+ * werden korrigiert und gezählt; zusätzlich wird der Gangunterschied
+ * des Arduino-Taktes gegenüber der RTC in ppm gemessen.
+ * Ohne SQW-Signal extrapoliert der Dienst über millis() und liest die
+ * RTC alle TIME_FALLBACK_RESYNC_MS neu (Millisekunden dann ohne festen
+ * Bezug zur Sekundengrenze).
+ */
+
+#ifndef TIME_SERVICE_H
+#define TIME_SERVICE_H
+
+#include "config.h"
+#include "rtc_module.h"
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Zähler zur Beurteilung von SQW-Signal und Uhrengang.
+ */
+struct TimeServiceStats {
+  unsigned long edges;          ///< Gezählte SQW-Flanken
+  unsigned long missedEdges;    ///< Aus Flankenabständen erkannte fehlende Flanken
+  unsigned long glitches;       ///< Verworfene Flanken (Abstand zu kurz)
+  unsigned long syncs;          ///< Erfolgreiche Abgleiche mit den RTC-Registern
+  unsigned long corrections;    ///< Abgleiche, bei denen die Sekunde korrigiert wurde
+  unsigned long syncErrors;     ///< Fehlgeschlagene RTC-Lesevorgänge
+  long lastCorrection;          ///< Zuletzt korrigierte Abweichung in Sekunden
+  long clockDriftPpm;           ///< Gang von millis() gegenüber der RTC (+ = Arduino zu schnell)
+  bool sqwActive;               ///< true wenn das SQW-Signal regelmäßig eintrifft
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Aktiviert den 1-Hz-SQW-Ausgang und liest die Startzeit.
+ *
+ * Nach initRTC() aufrufen.
+ *
+ * @return true wenn eine gültige RTC-Zeit gelesen wurde
+ */
+bool timeServiceBegin();
+
+/**
+ * @brief Überwacht das SQW-Signal und gleicht periodisch mit der RTC ab.
+ *
+ * Als Scheduler-Task (TIME_SERVICE_TASK_PERIOD) aufrufen. Ein Abgleich
+ * findet nur im Fenster TIME_SYNC_WINDOW_MS nach einer Flanke statt:
+ * Der Aufruf reiht das RTC-Lesen mit hoher Priorität in die TWI-Queue
+ * ein und wertet das Ergebnis in einem späteren Durchlauf aus; lag
+ * dazwischen eine Flanke, wird der Wert verworfen.
+ */
+void timeServiceUpdate();
+
+/**
+ * @brief Liefert die aktuelle Zeit (UTC) aus dem Zwischenspeicher.
+ *
+ * Kein I2C-Zugriff. Nur solange noch nie eine gültige Zeit gelesen
+ * wurde, wird direkt auf die RTC zugegriffen.
+ *
+ * @param data Ausgabe inkl. Millisekundenanteil
+ * @return true wenn die Zeit gültig ist
+ */
+bool timeServiceNow(RTCData* data);
+
+/**
+ * @brief Liefert die aktuelle Unix-Zeit (UTC) aus dem Zwischenspeicher.
+ *
+ * @param millisecond Optional: Ausgabe des Millisekundenanteils (0-999)
+ * @return Unix-Zeit oder 0 wenn noch keine gültige Zeit vorliegt
+ */
+unsigned long timeServiceEpoch(uint16_t* millisecond = NULL);
+
+/**
+ * @brief Liefert eine konsistente Kopie der Zähler.
+ *
+ * @param stats Ausgabe der Zähler
+ */
+void timeServiceGetStats(TimeServiceStats* stats);
+
+/**
+ * @brief Gibt SQW-Status, Abgleiche und Gangabweichung über DEBUG_PRINT aus.
+ */
+void timeServicePrintStats();
+
+#endif // TIME_SERVICE_H
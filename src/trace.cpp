@@ -0,0 +1,223 @@
+/*
+ * Implementierung der tokenisierten Debug-Ausgabe
+ */
+
+#include "trace.h"
+#include "telemetry.h"
+#include <Arduino.h>
+#include <stddef.h>
+
+// ==============================================
+// TOKENISIERT (PUFFER + TELEMETRIE)
+// ==============================================
+
+#if TRACE_ENABLED
+
+static_assert(TRACE_BUFFER_SIZE >= 2 * TRACE_MAX_RECORD && TRACE_BUFFER_SIZE <= 128 &&
+              (TRACE_BUFFER_SIZE & (TRACE_BUFFER_SIZE - 1)) == 0,
+              "TRACE_BUFFER_SIZE muss eine Zweierpotenz zwischen 2 Meldungen und 128 sein");
+static_assert(TRACE_MAX_RECORD <= TELEMETRY_TRACE_MAX_BODY, "Meldung muss in einen Rahmen passen");
+
+static const uint8_t TRACE_MASK = TRACE_BUFFER_SIZE - 1;
+
+// Siehe log_queue.cpp: Pufferzugriffe nicht über die Indexänderung verschieben
+#define TRACE_BARRIER() __asm__ __volatile__("" ::: "memory")
+
+// Erzeuger (auch ISRs) schreiben bei gesperrten Interrupts und setzen
+// traceHead erst danach; nur traceService() ändert traceTail
+static uint8_t traceBuffer[TRACE_BUFFER_SIZE];
+static volatile uint8_t traceHead = 0;
+static volatile uint8_t traceTail = 0;
+static uint16_t tracePendingDrops = 0;
+static TraceStats traceStats = {0, 0, 0, 0};
+
+static uint8_t putBytes(uint8_t position, const void* data, uint8_t length) {
+  const uint8_t* bytes = (const uint8_t*)data;
+  for (uint8_t i = 0; i < length; i++) {
+    traceBuffer[position++ & TRACE_MASK] = bytes[i];
+  }
+  return position;
+}
+
+static uint8_t putRecord(uint8_t position, uint16_t id, const uint32_t* args, uint8_t argc,
+                         unsigned long now) {
+  TraceRecordHeader header = { id, argc, (uint32_t)now };
+  position = putBytes(position, &header, sizeof(header));
+  return putBytes(position, args, argc * sizeof(uint32_t));
+}
+
+void traceWrite(uint16_t id, const uint32_t* args, uint8_t argc) {
+  uint8_t length = sizeof(TraceRecordHeader) + argc * sizeof(uint32_t);
+  const uint8_t dropLength = sizeof(TraceRecordHeader) + sizeof(uint32_t);
+  unsigned long now = millis();
+
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t head = traceHead;
+  uint8_t available = TRACE_BUFFER_SIZE - (uint8_t)(head - traceTail);
+  uint8_t needed = length + (tracePendingDrops ? dropLength : 0);
+
+  if (available < needed) {
+    if (tracePendingDrops < 0xFFFF) tracePendingDrops++;
+    traceStats.dropped++;
+    SREG = sreg;
+    return;
+  }
+
+  // Erst die Anzahl verworfener Meldungen, dann die neue Meldung
+  if (tracePendingDrops) {
+    uint32_t count = tracePendingDrops;
+    head = putRecord(head, TRACE_DROPPED, &count, 1, now);
+    tracePendingDrops = 0;
+  }
+  head = putRecord(head, id, args, argc, now);
+  TRACE_BARRIER();
+  traceHead = head;
+
+  traceStats.records++;
+  uint8_t used = head - traceTail;
+  if (used > traceStats.highWater) traceStats.highWater = used;
+  SREG = sreg;
+}
+
+void traceBegin() {
+  uint32_t hash = TRACE_TABLE_HASH;
+  traceWrite(TRACE_TABLE, &hash, 1);
+}
+
+void traceService() {
+  uint8_t body[TELEMETRY_TRACE_MAX_BODY];
+
+  while (true) {
+    // Ganze Meldungen sammeln, bis der Rahmen voll ist
+    uint8_t tail = traceTail;
+    uint8_t head = traceHead;
+    uint8_t length = 0;
+    while (tail != head) {
+      uint8_t argc = traceBuffer[(uint8_t)(tail + offsetof(TraceRecordHeader, argc)) & TRACE_MASK];
+      uint8_t recordLength = sizeof(TraceRecordHeader) + argc * sizeof(uint32_t);
+      if (length + recordLength > sizeof(body)) break;
+      for (uint8_t i = 0; i < recordLength; i++) {
+        body[length++] = traceBuffer[tail++ & TRACE_MASK];
+      }
+    }
+    if (length == 0) return;
+
+    // Sendepuffer voll: Meldungen bleiben liegen, nächster Versuch im nächsten Durchlauf
+    if (!telemetrySendTrace(body, length)) return;
+    TRACE_BARRIER();
+    traceTail = tail;
+    traceStats.frames++;
+  }
+}
+
+void traceGetStats(TraceStats* stats) {
+  noInterrupts();
+  *stats = traceStats;
+  interrupts();
+}
+
+// ==============================================
+// TEXT (SOFORT, WIE DEBUG_PRINT)
+// ==============================================
+
+#elif DEBUG_ENABLED && !TELEMETRY_ENABLED
+
+#define TRACE_MSG(name, argc, format) static const char TRACE_TEXT_##name[] PROGMEM = format;
+#include "trace_messages.def"
+#undef TRACE_MSG
+
+static const char* const TRACE_TEXTS[] PROGMEM = {
+#define TRACE_MSG(name, argc, format) TRACE_TEXT_##name,
+#include "trace_messages.def"
+#undef TRACE_MSG
+};
+
+static TraceStats traceStats = {0, 0, 0, 0};
+
+// Gibt die Alternative index aus "a|b|c}" aus; liefert die Position nach '}'
+static const char* printChoice(const char* text, uint32_t index) {
+  uint32_t current = 0;
+  char c;
+  while ((c = pgm_read_byte(text)) != '\0') {
+    text++;
+    if (c == '}') break;
+    if (c == '|') {
+      current++;
+    } else if (current == index) {
+      Serial.write(c);
+    }
+  }
+  return text;
+}
+
+void traceWrite(uint16_t id, const uint32_t* args, uint8_t argc) {
+  if (id >= TRACE_MESSAGE_COUNT) return;
+  traceStats.records++;
+
+  const char* text = (const char*)pgm_read_ptr(&TRACE_TEXTS[id]);
+  uint8_t next = 0;
+  char c;
+  while ((c = pgm_read_byte(text++)) != '\0') {
+    if (c != '%') {
+      Serial.write(c);
+      continue;
+    }
+
+    c = pgm_read_byte(text++);
+    if (c == '%') {
+      Serial.write('%');
+      continue;
+    }
+    if (c == '\0' || next >= argc) break;
+    uint32_t word = args[next++];
+
+    switch (c) {
+      case 'd': Serial.print((long)(int32_t)word); break;
+      case 'u': Serial.print((unsigned long)word); break;
+      case 'x': Serial.print((unsigned long)word, HEX); break;
+      case 'c': Serial.write((char)word); break;
+      case '{': text = printChoice(text, word); break;
+      case 'f':
+      case '.': {
+        uint8_t decimals = 2;
+        if (c == '.') {
+          decimals = pgm_read_byte(text) - '0';
+          text += 2;  // Ziffer und 'f'
+        }
+        float value;
+        memcpy(&value, &word, sizeof(value));
+        Serial.print(value, decimals);
+        break;
+      }
+      default: break;
+    }
+  }
+  Serial.println();
+}
+
+void traceBegin() {}
+
+void traceService() {}
+
+void traceGetStats(TraceStats* stats) {
+  *stats = traceStats;
+}
+
+// ==============================================
+// AUSGESCHALTET
+// ==============================================
+
+#else
+
+void traceWrite(uint16_t, const uint32_t*, uint8_t) {}
+
+void traceBegin() {}
+
+void traceService() {}
+
+void traceGetStats(TraceStats* stats) {
+  memset(stats, 0, sizeof(*stats));
+}
+
+#endif
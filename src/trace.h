@@ -0,0 +1,109 @@
+/*
+ * Tokenisierte, verzögerte Debug-Ausgabe für das Umweltkontrollsystem
+ *
+ * TRACE(NAME, args...) legt nur die 16-Bit-ID der Meldung aus
+ * trace_messages.def, die Anzahl der Argumente, millis() und die
+ * Argumente als 32-Bit-Rohwerte in einen Ringpuffer (kein Formatieren,
+ * kein Text im Flash, aus ISRs aufrufbar). Der Trace-Task leert ihn mit
+ * niedrigster Priorität als Telemetrie-Rahmen, solange der Sendepuffer
+ * Platz hat; tools/hstelemetry setzt die Texte wieder ein.
+ * Ist der Puffer voll, wird die Meldung verworfen und gezählt; sobald
+ * wieder Platz ist, folgt die Meldung DROPPED mit der Anzahl.
+ *
+ * Konfiguration:
+ *   TRACE_ENABLED 1   Tokenisiert (benötigt TELEMETRY_ENABLED)
+ *   TRACE_ENABLED 0   Text wie DEBUG_PRINT, sofort und synchron
+ *                     (Formate als PROGMEM-Tabelle), ohne Debug leer
+ * Die Argumentanzahl wird zur Compile-Zeit gegen die Tabelle geprüft.
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include "config.h"
+#include "trace_format.h"
+#include <string.h>
+
+#if TRACE_ENABLED && !TELEMETRY_ENABLED
+#error "TRACE_ENABLED benötigt TELEMETRY_ENABLED (Ausgabe als Telemetrie-Rahmen)"
+#endif
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Zähler der Trace-Ausgabe.
+ */
+struct TraceStats {
+  unsigned long records;    ///< Angenommene Meldungen
+  unsigned long dropped;    ///< Verworfene Meldungen (Puffer voll)
+  unsigned long frames;     ///< Gesendete Rahmen
+  uint8_t highWater;        ///< Höchster Pufferfüllstand in Bytes
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Schreibt eine Meldung (nicht direkt aufrufen, siehe TRACE()).
+ *
+ * @param id Meldungs-ID
+ * @param args Argumente als 32-Bit-Rohwerte
+ * @param argc Anzahl Argumente
+ */
+void traceWrite(uint16_t id, const uint32_t* args, uint8_t argc);
+
+/**
+ * @brief Sendet die Tabellenkennung (Meldung TABLE). Nach telemetryBegin().
+ */
+void traceBegin();
+
+/**
+ * @brief Leert den Puffer in Telemetrie-Rahmen, ohne zu blockieren.
+ *
+ * Als Scheduler-Task mit niedrigster Priorität aufrufen.
+ */
+void traceService();
+
+/**
+ * @brief Liefert die Trace-Zähler.
+ */
+void traceGetStats(TraceStats* stats);
+
+// ==============================================
+// AUFRUF
+// ==============================================
+
+// Argumente als 32-Bit-Wort: Ganzzahlen mit Vorzeichenerweiterung, float bitweise
+template <typename T>
+inline uint32_t traceWord(T value) {
+  return (uint32_t)value;
+}
+
+inline uint32_t traceWord(float value) {
+  uint32_t word;
+  memcpy(&word, &value, sizeof(word));
+  return word;
+}
+
+inline uint32_t traceWord(double value) {
+  return traceWord((float)value);
+}
+
+template <TraceId id, typename... Args>
+inline void traceLog(Args... args) {
+  static_assert(sizeof...(Args) == TRACE_ARG_COUNTS[id],
+                "Argumentanzahl passt nicht zur Meldung in trace_messages.def");
+#if TRACE_ENABLED || (DEBUG_ENABLED && !TELEMETRY_ENABLED)
+  const uint32_t words[sizeof...(Args) + 1] = { traceWord(args)... };
+  traceWrite(id, words, sizeof...(Args));
+#else
+  ((void)args, ...);
+#endif
+}
+
+#define TRACE(name, ...) traceLog<TRACE_##name>(__VA_ARGS__)
+
+#endif // TRACE_H
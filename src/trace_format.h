@@ -0,0 +1,92 @@
+/*
+ * Tokenisierte Debug-Meldungen: gemeinsame Definition für Firmware (trace)
+ * und Host-Werkzeuge (tools/hstelemetry)
+ *
+ * Die IDs entstehen zur Compile-Zeit aus trace_messages.def. Eine
+ * Meldung liegt im Puffer und im Telemetrie-Rahmen (TELEMETRY_FRAME_TRACE)
+ * als TraceRecordHeader gefolgt von argc 32-Bit-Argumenten
+ * (little-endian); ein Rahmen enthält eine oder mehrere ganze Meldungen.
+ * TRACE_TABLE_HASH (FNV-1a über Namen, Argumentanzahl und Formate) wird
+ * beim Start als Meldung TABLE gesendet; der Host erkennt damit
+ * Mitschnitte einer anderen Tabellenversion.
+ * Die Datei ist ohne Arduino-Header übersetzbar.
+ */
+
+#ifndef TRACE_FORMAT_H
+#define TRACE_FORMAT_H
+
+#include <stdint.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+const uint8_t TRACE_MAX_ARGS = 4;   // Höchstzahl Argumente pro Meldung
+
+// Meldungs-IDs in der Reihenfolge von trace_messages.def
+enum TraceId : uint16_t {
+#define TRACE_MSG(name, argc, format) TRACE_##name,
+#include "trace_messages.def"
+#undef TRACE_MSG
+  TRACE_MESSAGE_COUNT
+};
+
+// Argumentanzahl je ID (nur für Prüfungen zur Compile-Zeit)
+static constexpr uint8_t TRACE_ARG_COUNTS[] = {
+#define TRACE_MSG(name, argc, format) argc,
+#include "trace_messages.def"
+#undef TRACE_MSG
+};
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Kopf einer Meldung (7 Bytes), danach argc x uint32_t.
+ */
+struct __attribute__((packed)) TraceRecordHeader {
+  uint16_t id;              ///< TraceId
+  uint8_t argc;             ///< Anzahl folgender Argumente
+  uint32_t uptimeMs;        ///< millis() beim Aufruf
+};
+
+static_assert(sizeof(TraceRecordHeader) == 7, "TraceRecordHeader muss 7 Bytes groß sein");
+
+#define TRACE_MAX_RECORD (sizeof(TraceRecordHeader) + TRACE_MAX_ARGS * sizeof(uint32_t))
+
+// ==============================================
+// TABELLENKENNUNG
+// ==============================================
+
+static constexpr uint32_t traceHashText(uint32_t hash, const char* text) {
+  while (*text) {
+    hash = (hash ^ (uint8_t)*text++) * 16777619UL;
+  }
+  return hash;
+}
+
+static constexpr uint32_t traceTableHash() {
+  uint32_t hash = 2166136261UL;
+#define TRACE_MSG(name, argc, format) \
+  hash = traceHashText(hash, #name); \
+  hash = (hash ^ (argc)) * 16777619UL; \
+  hash = traceHashText(hash, format);
+#include "trace_messages.def"
+#undef TRACE_MSG
+  return hash;
+}
+
+static constexpr uint32_t TRACE_TABLE_HASH = traceTableHash();
+
+static constexpr bool traceArgCountsValid() {
+  for (uint8_t count : TRACE_ARG_COUNTS) {
+    if (count > TRACE_MAX_ARGS) return false;
+  }
+  return true;
+}
+
+static_assert(traceArgCountsValid(), "Meldung mit mehr als TRACE_MAX_ARGS Argumenten in trace_messages.def");
+static_assert(TRACE_TABLE == 0 && TRACE_DROPPED == 1, "Verwaltungsmeldungen müssen am Anfang stehen");
+
+#endif // TRACE_FORMAT_H
@@ -0,0 +1,291 @@
+/*
+ * Implementierung der TWI-Transaktions-Queue
+ */
+
+#include "twi_queue.h"
+#include <Arduino.h>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+// TWBR bei Vorteiler 1: SCL = F_CPU / (16 + 2 * TWBR)
+static const uint8_t TWI_TWBR_100K = ((F_CPU / 100000UL) - 16) / 2;
+static const uint8_t TWI_TWBR_400K = ((F_CPU / 400000UL) - 16) / 2;
+
+// Statuscodes des TWI-Masters (TWSR & 0xF8)
+static const uint8_t TWI_START = 0x08;
+static const uint8_t TWI_REP_START = 0x10;
+static const uint8_t TWI_MT_SLA_ACK = 0x18;
+static const uint8_t TWI_MT_DATA_ACK = 0x28;
+static const uint8_t TWI_MR_SLA_ACK = 0x40;
+static const uint8_t TWI_MR_DATA_ACK = 0x50;
+static const uint8_t TWI_MR_DATA_NACK = 0x58;
+
+// TWCR-Werte
+#define TWI_CONTINUE (_BV(TWEN) | _BV(TWIE) | _BV(TWINT))
+
+// ==============================================
+// GLOBALE VARIABLEN
+// ==============================================
+
+// Ringpuffer der wartenden Anfragen (Zugriff nur bei gesperrten Interrupts)
+struct TwiRing {
+  TwiRequest** slots;
+  uint8_t size;
+  uint8_t head;
+  uint8_t count;
+};
+
+static TwiRequest* highSlots[TWI_HIGH_QUEUE_DEPTH];
+static TwiRequest* normalSlots[TWI_QUEUE_DEPTH];
+static TwiRing highQueue = { highSlots, TWI_HIGH_QUEUE_DEPTH, 0, 0 };
+static TwiRing normalQueue = { normalSlots, TWI_QUEUE_DEPTH, 0, 0 };
+
+// Laufende und (zwischen zwei Teilen) unterbrochene Anfrage
+static TwiRequest* volatile twiActive = NULL;
+static TwiRequest* volatile twiSuspended = NULL;
+static volatile unsigned long twiLastActivity = 0;
+
+// Zustand der laufenden Transaktion
+static uint16_t twiChunkEnd = 0;
+static bool twiPrefixPending = false;
+static bool twiReadPhase = false;
+static uint8_t twiReadIndex = 0;
+
+static TwiStats twiStats = {0, 0, 0, 0, 0, 0};
+
+// ==============================================
+// QUEUE
+// ==============================================
+
+static bool ringPush(TwiRing* ring, TwiRequest* request) {
+  if (ring->count >= ring->size) return false;
+  uint8_t index = ring->head + ring->count;
+  if (index >= ring->size) index -= ring->size;
+  ring->slots[index] = request;
+  ring->count++;
+  return true;
+}
+
+static TwiRequest* ringPop(TwiRing* ring) {
+  if (ring->count == 0) return NULL;
+  TwiRequest* request = ring->slots[ring->head];
+  if (++ring->head >= ring->size) ring->head = 0;
+  ring->count--;
+  return request;
+}
+
+// ==============================================
+// ZUSTANDSMASCHINE (bei gesperrten Interrupts)
+// ==============================================
+
+static void startRequest(TwiRequest* request) {
+  twiActive = request;
+  TWBR = (request->flags & TWI_FLAG_FAST) ? TWI_TWBR_400K : TWI_TWBR_100K;
+
+  // Grenze des aktuellen Teils
+  twiChunkEnd = request->writeLength;
+  if (request->flags & TWI_FLAG_CHUNKED) {
+    uint8_t budget = TWI_CHUNK_SIZE - ((request->flags & TWI_FLAG_PREFIX) ? 1 : 0);
+    if (request->writeLength - request->position > budget) {
+      twiChunkEnd = request->position + budget;
+    }
+  }
+  twiPrefixPending = (request->flags & TWI_FLAG_PREFIX) != 0;
+  twiReadPhase = !twiPrefixPending && request->writeLength == 0 && request->readLength > 0;
+  twiReadIndex = 0;
+  twiLastActivity = millis();
+
+  // Vorheriges STOP muss abgeschlossen sein (wenige Bustakte)
+  while (TWCR & _BV(TWSTO)) {}
+  TWCR = TWI_CONTINUE | _BV(TWSTA);
+}
+
+static void startNext() {
+  if (twiActive) return;
+
+  TwiRequest* request = ringPop(&highQueue);
+  if (request) {
+    if (twiSuspended) twiStats.preemptions++;
+  } else if (twiSuspended) {
+    request = twiSuspended;
+    twiSuspended = NULL;
+  } else {
+    request = ringPop(&normalQueue);
+  }
+  if (request) startRequest(request);
+}
+
+static void sendStop() {
+  TWCR = _BV(TWEN) | _BV(TWINT) | _BV(TWSTO);
+}
+
+static void finishRequest(TwiRequest* request, uint8_t status) {
+  twiActive = NULL;
+  request->status = status;
+  if (status == TWI_STATUS_DONE) {
+    twiStats.completed++;
+  } else {
+    twiStats.errors++;
+  }
+  if (request->callback) request->callback(request);
+  startNext();
+}
+
+// ==============================================
+// TWI-INTERRUPT
+// ==============================================
+
+ISR(TWI_vect) {
+  TwiRequest* request = twiActive;
+  if (!request) {
+    TWCR = _BV(TWEN);
+    return;
+  }
+  twiLastActivity = millis();
+
+  switch (TWSR & 0xF8) {
+    case TWI_START:
+    case TWI_REP_START:
+      TWDR = (request->address << 1) | (twiReadPhase ? 1 : 0);
+      TWCR = TWI_CONTINUE;
+      break;
+
+    case TWI_MT_SLA_ACK:
+    case TWI_MT_DATA_ACK:
+      if (twiPrefixPending) {
+        twiPrefixPending = false;
+        TWDR = request->prefix;
+        twiStats.bytes++;
+        TWCR = TWI_CONTINUE;
+      } else if (request->position < twiChunkEnd) {
+        TWDR = request->writeData[request->position++];
+        twiStats.bytes++;
+        TWCR = TWI_CONTINUE;
+      } else if (request->position < request->writeLength) {
+        // Teil fertig: Bus freigeben, vorrangige Anfragen dürfen dazwischen
+        sendStop();
+        twiActive = NULL;
+        twiSuspended = request;
+        startNext();
+      } else if (request->readLength > 0) {
+        twiReadPhase = true;
+        TWCR = TWI_CONTINUE | _BV(TWSTA);  // Repeated Start
+      } else {
+        sendStop();
+        finishRequest(request, TWI_STATUS_DONE);
+      }
+      break;
+
+    case TWI_MR_SLA_ACK:
+      // Beim letzten Byte NACK senden
+      TWCR = TWI_CONTINUE | (request->readLength > 1 ? _BV(TWEA) : 0);
+      break;
+
+    case TWI_MR_DATA_ACK:
+      request->readData[twiReadIndex++] = TWDR;
+      twiStats.bytes++;
+      TWCR = TWI_CONTINUE | (twiReadIndex + 1 < request->readLength ? _BV(TWEA) : 0);
+      break;
+
+    case TWI_MR_DATA_NACK:
+      request->readData[twiReadIndex++] = TWDR;
+      twiStats.bytes++;
+      sendStop();
+      finishRequest(request, TWI_STATUS_DONE);
+      break;
+
+    default:
+      // NACK auf Adresse/Daten, Arbitrierungsverlust oder Busfehler
+      sendStop();
+      finishRequest(request, TWI_STATUS_ERROR);
+      break;
+  }
+}
+
+// ==============================================
+// SCHNITTSTELLE
+// ==============================================
+
+void twiBegin() {
+  // Interne Pull-ups als Ergänzung zu den Modul-Widerständen
+  digitalWrite(SDA, HIGH);
+  digitalWrite(SCL, HIGH);
+
+  TWSR = 0;  // Vorteiler 1
+  TWBR = TWI_TWBR_100K;
+  TWCR = _BV(TWEN);
+}
+
+bool twiSubmit(TwiRequest* request, bool highPriority) {
+  if (request->status == TWI_STATUS_PENDING) return false;
+
+  noInterrupts();
+  request->position = 0;
+  if (!ringPush(highPriority ? &highQueue : &normalQueue, request)) {
+    twiStats.rejected++;
+    interrupts();
+    return false;
+  }
+  request->status = TWI_STATUS_PENDING;
+  startNext();
+  interrupts();
+  return true;
+}
+
+bool twiWait(TwiRequest* request) {
+  while (request->status == TWI_STATUS_PENDING) {
+    twiPoll();
+  }
+  return request->status == TWI_STATUS_DONE;
+}
+
+bool twiTransfer(TwiRequest* request, bool highPriority) {
+  return twiSubmit(request, highPriority) && twiWait(request);
+}
+
+bool twiIsIdle() {
+  noInterrupts();
+  bool idle = !twiActive && !twiSuspended && highQueue.count == 0 && normalQueue.count == 0;
+  interrupts();
+  return idle;
+}
+
+void twiPoll() {
+  noInterrupts();
+  TwiRequest* request = twiActive;
+  if (request && millis() - twiLastActivity > TWI_TIMEOUT_MS) {
+    // Hardware zurücksetzen (gibt SDA/SCL frei) und neu aktivieren
+    TWCR = 0;
+    TWCR = _BV(TWEN);
+    twiStats.timeouts++;
+    finishRequest(request, TWI_STATUS_ERROR);
+  }
+  interrupts();
+}
+
+void twiGetStats(TwiStats* stats) {
+  noInterrupts();
+  *stats = twiStats;
+  interrupts();
+}
+
+void twiPrintStats() {
+  TwiStats stats;
+  twiGetStats(&stats);
+
+  DEBUG_PRINTLN(F("=== I2C ==="));
+  DEBUG_PRINT(F("Anfragen: "));
+  DEBUG_PRINT(stats.completed);
+  DEBUG_PRINT(F(", Fehler: "));
+  DEBUG_PRINT(stats.errors);
+  DEBUG_PRINT(F(" (Timeouts: "));
+  DEBUG_PRINT(stats.timeouts);
+  DEBUG_PRINT(F("), abgewiesen: "));
+  DEBUG_PRINT(stats.rejected);
+  DEBUG_PRINT(F(", Bytes: "));
+  DEBUG_PRINT(stats.bytes);
+  DEBUG_PRINT(F(", vorgezogen: "));
+  DEBUG_PRINTLN(stats.preemptions);
+}
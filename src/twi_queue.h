@@ -0,0 +1,138 @@
+/*
+ * TWI-Transaktions-Queue für das Umweltkontrollsystem
+ * Interruptgesteuerter I2C-Master für RTC und OLED (ersetzt Wire)
+ *
+ * Aufrufer legen TwiRequest-Objekte (statisch, kein Heap) in eine von
+ * zwei Queues; der TWI-Interrupt arbeitet sie ohne Beteiligung von loop()
+ * ab. Eine Anfrage besteht aus einem Schreibteil (optional mit einem
+ * Präfix-Byte) und einem optionalen Leseteil (Repeated Start).
+ * Große Schreibvorgänge mit TWI_FLAG_CHUNKED werden in Transaktionen zu
+ * TWI_CHUNK_SIZE Bytes zerlegt, das Präfix-Byte wird jedem Teil
+ * vorangestellt (SSD1306-Datenstrom: 0x40). Zwischen zwei Teilen kommen
+ * wartende Anfragen hoher Priorität (z.B. RTC-Lesen) zum Zug - ein
+ * OLED-Refresh verzögert einen Zeitstempel höchstens um einen Teil.
+ * Der Bustakt wird je Anfrage gesetzt: 400 kHz mit TWI_FLAG_FAST, sonst
+ * 100 kHz (DS1307).
+ */
+
+#ifndef TWI_QUEUE_H
+#define TWI_QUEUE_H
+
+#include "config.h"
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+// Anfragestatus
+const uint8_t TWI_STATUS_IDLE = 0;       // Noch nie eingereiht
+const uint8_t TWI_STATUS_PENDING = 1;    // In der Queue oder in Übertragung
+const uint8_t TWI_STATUS_DONE = 2;       // Erfolgreich abgeschlossen
+const uint8_t TWI_STATUS_ERROR = 3;      // NACK, Busfehler oder Zeitüberschreitung
+
+// Anfrage-Flags
+const uint8_t TWI_FLAG_FAST = 0x01;      // 400 kHz statt 100 kHz
+const uint8_t TWI_FLAG_PREFIX = 0x02;    // prefix vor die Schreibdaten setzen
+const uint8_t TWI_FLAG_CHUNKED = 0x04;   // Schreibdaten in Teiltransaktionen zerlegen
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+struct TwiRequest;
+
+/**
+ * @brief Abschluss-Callback; läuft im TWI-Interrupt und muss kurz sein.
+ */
+typedef void (*TwiCallback)(TwiRequest* request);
+
+/**
+ * @brief Eine I2C-Transaktion. Speicher und Puffer gehören dem Aufrufer
+ * und müssen bis zum Abschluss gültig bleiben.
+ */
+struct TwiRequest {
+  uint8_t address;              ///< 7-Bit-Geräteadresse
+  uint8_t flags;                ///< TWI_FLAG_*
+  uint8_t prefix;               ///< Steuerbyte vor den Schreibdaten (mit TWI_FLAG_PREFIX)
+  const uint8_t* writeData;     ///< Zu schreibende Bytes (darf NULL sein)
+  uint16_t writeLength;         ///< Anzahl zu schreibender Bytes
+  uint8_t* readData;            ///< Ziel für gelesene Bytes (darf NULL sein)
+  uint8_t readLength;           ///< Anzahl zu lesender Bytes
+  TwiCallback callback;         ///< Optional, wird nach Abschluss aufgerufen
+  volatile uint8_t status;      ///< TWI_STATUS_*
+  uint16_t position;            ///< Intern: bereits gesendete Schreibbytes
+};
+
+/**
+ * @brief Zähler zur Beurteilung der Buslast.
+ */
+struct TwiStats {
+  unsigned long completed;      ///< Erfolgreich abgeschlossene Anfragen
+  unsigned long errors;         ///< Anfragen mit NACK, Busfehler oder Timeout
+  unsigned long timeouts;       ///< Vom Watchdog abgebrochene Anfragen
+  unsigned long rejected;       ///< Nicht angenommene Anfragen (Queue voll)
+  unsigned long bytes;          ///< Übertragene Datenbytes (inkl. Präfix)
+  unsigned long preemptions;    ///< Vorgezogene Anfragen zwischen zwei Teilen
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Initialisiert die TWI-Hardware (interne Pull-ups an SDA/SCL).
+ */
+void twiBegin();
+
+/**
+ * @brief Reiht eine Anfrage ein und startet den Bus, falls er frei ist.
+ *
+ * @param request Anfrage (status wird auf TWI_STATUS_PENDING gesetzt)
+ * @param highPriority true für kurze, zeitkritische Anfragen (nicht mit TWI_FLAG_CHUNKED)
+ * @return false wenn die Queue voll ist oder die Anfrage noch läuft
+ */
+bool twiSubmit(TwiRequest* request, bool highPriority);
+
+/**
+ * @brief Wartet aktiv auf den Abschluss einer Anfrage.
+ *
+ * Nur für Initialisierung und Diagnose gedacht; im Betrieb den Status
+ * abfragen statt zu warten. Endet spätestens, wenn der Watchdog
+ * (TWI_TIMEOUT_MS je Transaktion) die Anfrage abbricht. Nicht bei
+ * gesperrten Interrupts aufrufen.
+ *
+ * @param request Eingereihte Anfrage
+ * @return true wenn die Anfrage erfolgreich abgeschlossen wurde
+ */
+bool twiWait(TwiRequest* request);
+
+/**
+ * @brief Einreihen und warten in einem Schritt (siehe twiWait).
+ */
+bool twiTransfer(TwiRequest* request, bool highPriority);
+
+/**
+ * @brief Prüft, ob keine Anfrage wartet oder läuft.
+ */
+bool twiIsIdle();
+
+/**
+ * @brief Watchdog: bricht eine hängende Übertragung ab.
+ *
+ * Als Scheduler-Task aufrufen. Läuft eine Transaktion länger als
+ * TWI_TIMEOUT_MS, wird die TWI-Hardware zurückgesetzt, die Anfrage mit
+ * TWI_STATUS_ERROR beendet und die nächste gestartet.
+ */
+void twiPoll();
+
+/**
+ * @brief Liefert eine konsistente Kopie der Zähler.
+ */
+void twiGetStats(TwiStats* stats);
+
+/**
+ * @brief Gibt die Buszähler über DEBUG_PRINT aus.
+ */
+void twiPrintStats();
+
+#endif // TWI_QUEUE_H
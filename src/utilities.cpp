@@ -1,7 +1,11 @@
 
 #include "config.h"
 #include "utilities.h"
+#include "log_writer.h"
 #include "rtc_module.h"
+#include "telemetry.h"
+#include "memory_monitor.h"
+#include "trace.h"
 #include <Arduino.h>
 // ==============================================
 // SYSTEM-INFO
@@ -34,22 +38,17 @@ SystemError lastError = ERROR_NONE;
 void printMemoryUsage() {
   unsigned int freeRAM = getFreeRAM();
   if (freeRAM < RAM_CRITICAL_THRESHOLD) {
-    DEBUG_PRINTLN(F("KRITISCH: RAM-Mangel!"));
-    reportError(ERROR_MEMORY, "Critical RAM");
+    TRACE(RAM_CRITICAL);
+    reportError(ERROR_MEMORY, TRACE_ERROR_RAM_CRITICAL);
   } else if (freeRAM < RAM_WARNING_THRESHOLD) {
-    DEBUG_PRINTLN(F("WARNUNG: Wenig RAM!"));
-    reportError(ERROR_MEMORY, "Low RAM");
+    TRACE(RAM_LOW);
+    reportError(ERROR_MEMORY, TRACE_ERROR_RAM_LOW);
   }
 }
 
-unsigned int getFreeRAM() {
-  extern int __heap_start, *__brkval;
-  int v;
-  return (int) &v - (__brkval == 0 ? (int) &__heap_start : (int) __brkval);
-}
-
 void softReset() {
-  DEBUG_PRINTLN(F("System-Reset..."));
+  TRACE(SYSTEM_RESET);
+  logWriterClose();  // Gepufferte Log-Zeilen nicht verlieren
   delay(1000);
   asm volatile ("  jmp 0");  // Software-Reset für Arduino
 }
@@ -58,10 +57,20 @@ void systemCheck() {
   printMemoryUsage();
   unsigned int freeRAM = getFreeRAM();
   if (freeRAM < RAM_CRITICAL_THRESHOLD) {
-    DEBUG_PRINTLN(F("KRITISCH: Neustart empfohlen!"));
+    TRACE(RAM_RESTART_ADVISED);
     // Optional: Automatischer Reset bei kritischem RAM-Mangel
     // softReset();
   }
+
+  // Tatsächliche Reserve: nie benutzter Bereich seit dem Start
+  memoryMonitorScan();
+  MemoryStats memory;
+  memoryMonitorGetStats(&memory);
+  if (memory.margin < RAM_CRITICAL_THRESHOLD) {
+    reportError(ERROR_MEMORY, TRACE_ERROR_STACK_CRITICAL);
+  } else if (memory.margin < RAM_WARNING_THRESHOLD) {
+    TRACE(STACK_LOW);
+  }
 }
 
 // ==============================================
@@ -189,17 +198,13 @@ unsigned long getElapsedTime(unsigned long startTime) {
 // ERROR-HANDLING
 // ==============================================
 
-void reportError(SystemError error, const char* message) {
+void reportError(SystemError error, TraceId message) {
   lastError = error;
-  
-  DEBUG_PRINT(F("FEHLER ["));
-  DEBUG_PRINT(error);
-  DEBUG_PRINT(F("]: "));
-  if (message) {
-    DEBUG_PRINTLN(message);
-  } else {
-    DEBUG_PRINTLN(F("Unbekannter Fehler"));
-  }
+  telemetrySendEvent(TELEMETRY_EVENT_ERROR, error, 0);
+
+  // Wie TRACE(), die ID steht aber erst zur Laufzeit fest
+  uint32_t code = error;
+  traceWrite(message, &code, 1);
 }
 
 void clearError() {
@@ -8,6 +8,7 @@
 
 #include <Arduino.h>
 #include "config.h"
+#include "trace_format.h"
 
 // ==============================================
 // SYSTEM-FUNKTIONEN
@@ -285,12 +286,13 @@ typedef enum {
  * @brief Meldet und protokolliert einen Systemfehler.
  *
  * Registriert einen Fehler im System und gibt eine entsprechende
- * Meldung über die serielle Schnittstelle aus.
+ * Meldung über TRACE aus (Text oder tokenisiert, siehe trace.h).
  *
  * @param error Fehlercode aus der SystemError-Aufzählung
- * @param message Beschreibende Fehlermeldung als String
+ * @param message Meldung aus trace_messages.def mit genau einem Argument
+ *                (dem Fehlercode), z.B. TRACE_ERROR_RTC_INIT
  */
-void reportError(SystemError error, const char* message);
+void reportError(SystemError error, TraceId message);
 
 /**
  * @brief Löscht den aktuellen Fehlerstatus.
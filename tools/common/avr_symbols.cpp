@@ -0,0 +1,58 @@
+/*
+ * Implementierung der Symboltabelle
+ */
+
+#include "avr_symbols.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// Nur Code-Symbole mit Größe (t/T, schwache w/W)
+static bool readSymbols(FILE* input, std::vector<AvrSymbol>* symbols) {
+  char line[512];
+  while (fgets(line, sizeof(line), input)) {
+    unsigned long address;
+    unsigned long size;
+    char type;
+    int nameOffset = 0;
+    if (sscanf(line, "%lx %lx %c %n", &address, &size, &type, &nameOffset) != 3 || nameOffset == 0) continue;
+    if (!strchr("tTwW", type)) continue;
+    if (size == 0) continue;
+
+    std::string name(line + nameOffset);
+    while (!name.empty() && (name.back() == '\n' || name.back() == '\r')) name.pop_back();
+    symbols->push_back(AvrSymbol{ (uint32_t)address, (uint32_t)size, name });
+  }
+  std::sort(symbols->begin(), symbols->end(),
+            [](const AvrSymbol& a, const AvrSymbol& b) { return a.address < b.address; });
+  return !symbols->empty();
+}
+
+bool loadAvrSymbols(const char* symbolsPath, const char* nmProgram, const char* elfPath,
+                    std::vector<AvrSymbol>* symbols) {
+  FILE* symbolFile;
+  if (symbolsPath) {
+    symbolFile = fopen(symbolsPath, "r");
+  } else {
+    std::string command = std::string(nmProgram) + " -C -n -S --defined-only '" + elfPath + "'";
+    symbolFile = popen(command.c_str(), "r");
+  }
+  if (!symbolFile) {
+    perror(symbolsPath ? symbolsPath : nmProgram);
+    return false;
+  }
+  bool haveSymbols = readSymbols(symbolFile, symbols);
+  if (symbolsPath) {
+    fclose(symbolFile);
+  } else {
+    pclose(symbolFile);
+  }
+  if (!haveSymbols) {
+    fprintf(stderr, "keine Code-Symbole gefunden (ELF-Datei und --nm prüfen)\n");
+  }
+  return haveSymbols;
+}
+
+std::string avrSymbolBaseName(const std::string& name) {
+  return name.substr(0, name.find('('));
+}
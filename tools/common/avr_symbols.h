@@ -0,0 +1,38 @@
+/*
+ * Symboltabelle der Firmware für die Host-Werkzeuge (hsprof, hsavr)
+ *
+ * Liest die Ausgabe von "avr-nm -C -n -S --defined-only" - entweder direkt
+ * aus der ELF-Datei über das nm-Programm oder aus einer gespeicherten
+ * Ausgabe. Es werden nur Code-Symbole mit Größe übernommen.
+ */
+
+#ifndef AVR_SYMBOLS_H
+#define AVR_SYMBOLS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct AvrSymbol {
+  uint32_t address;   // Byte-Adresse im Flash
+  uint32_t size;
+  std::string name;   // Demangelt, bei C++ mit Parameterliste
+};
+
+/**
+ * @brief Lädt die Code-Symbole, nach Adresse sortiert.
+ *
+ * @param symbolsPath Gespeicherte nm-Ausgabe oder NULL
+ * @param nmProgram nm-Programm (nur ohne symbolsPath)
+ * @param elfPath Firmware-ELF (nur ohne symbolsPath)
+ * @return false wenn nichts lesbar war (Meldung auf stderr)
+ */
+bool loadAvrSymbols(const char* symbolsPath, const char* nmProgram, const char* elfPath,
+                    std::vector<AvrSymbol>* symbols);
+
+/**
+ * @brief Name ohne Parameterliste ("logSensorData(SensorSnapshot const*)" -> "logSensorData").
+ */
+std::string avrSymbolBaseName(const std::string& name);
+
+#endif // AVR_SYMBOLS_H
@@ -0,0 +1,53 @@
+/*
+ * Implementierung der gemeinsamen Datensatz-Ausgabe
+ */
+
+#include "record_output.h"
+#include "time_convert.h"
+
+#include <cstdio>
+
+static const char* const GAS_NAMES[9] = { "MQ2", "MQ3", "MQ4", "MQ5", "MQ6", "MQ7", "MQ8", "MQ9", "MQ135" };
+
+void printRecordCsvHeader() {
+  printf("DateTime,SecSinceMidnight-MS,Temperature_DHT_C,Humidity_RH,Light_Level,Light_Percent");
+  for (int i = 0; i < 9; i++) printf(",%s", GAS_NAMES[i]);
+  printf(",Mic1,Mic2,TDS,Radiation_CPS\n");
+}
+
+void printRecordCsv(const HsLogRecord* record) {
+  // Gleiche Umrechnung wie in der Firmware (time_convert)
+  CivilTime local;
+  bool summer = epochToLocal(record->epoch, &local);
+  unsigned long secondsSinceMidnight = local.hour * 3600UL + local.minute * 60UL + local.second;
+  double lightPercent = (1023 - record->light) / 1023.0 * 100.0;
+
+  if (record->flags & HSLOG_FLAG_RTC_VALID) {
+    printf("%04u-%02u-%02u %02u:%02u:%02u %s,%lu.%03u", local.year, local.month, local.day,
+           local.hour, local.minute, local.second, summer ? "MESZ" : "MEZ",
+           secondsSinceMidnight, record->millis);
+  } else {
+    printf("----/--/-- --:--:-- MEZ,");
+  }
+  printf(",%.1f,%.1f,%u,%.1f", record->temperature / 10.0, record->humidity / 10.0,
+         record->light, lightPercent);
+  for (int i = 0; i < 9; i++) printf(",%u", record->gas[i]);
+  printf(",%u,%u,%u,%.2f", record->mic[0], record->mic[1], record->tds, record->radiation / 100.0);
+}
+
+void printRecordJson(const HsLogRecord* record) {
+  CivilTime local;
+  bool summer = epochToLocal(record->epoch, &local);
+  double lightPercent = (1023 - record->light) / 1023.0 * 100.0;
+
+  printf("{\"epoch\":%lu,\"millis\":%u,\"local\":\"%04u-%02u-%02uT%02u:%02u:%02u%s\"",
+         (unsigned long)record->epoch, record->millis, local.year, local.month, local.day,
+         local.hour, local.minute, local.second, summer ? "+02:00" : "+01:00");
+  printf(",\"temperature\":%.1f,\"humidity\":%.1f,\"dhtValid\":%s",
+         record->temperature / 10.0, record->humidity / 10.0,
+         (record->flags & HSLOG_FLAG_DHT_VALID) ? "true" : "false");
+  printf(",\"light\":%u,\"lightPercent\":%.1f,\"gas\":{", record->light, lightPercent);
+  for (int i = 0; i < 9; i++) printf("%s\"%s\":%u", i ? "," : "", GAS_NAMES[i], record->gas[i]);
+  printf("},\"mic\":[%u,%u],\"tds\":%u,\"radiationCps\":%.2f}",
+         record->mic[0], record->mic[1], record->tds, record->radiation / 100.0);
+}
@@ -0,0 +1,31 @@
+/*
+ * Gemeinsame Ausgabe von HsLogRecord-Datensätzen für die Host-Werkzeuge
+ * (hslog2csv, hstelemetry)
+ *
+ * Spaltenaufteilung und Umrechnungen entsprechen der CSV-Ausgabe der
+ * Firmware, damit Binär-Log, Telemetrie und CSV-Log vergleichbar sind.
+ * Alle Funktionen schreiben nach stdout, ohne abschließenden Zeilenumbruch
+ * (außer printRecordCsvHeader).
+ */
+
+#ifndef RECORD_OUTPUT_H
+#define RECORD_OUTPUT_H
+
+#include "log_format.h"
+
+/**
+ * @brief Spaltenüberschrift der CSV-Ausgabe (mit Zeilenumbruch).
+ */
+void printRecordCsvHeader();
+
+/**
+ * @brief Ein Datensatz als CSV-Zeile (Lokalzeit MEZ/MESZ).
+ */
+void printRecordCsv(const HsLogRecord* record);
+
+/**
+ * @brief Ein Datensatz als JSON-Objekt (Zeitstempel mit UTC-Offset).
+ */
+void printRecordJson(const HsLogRecord* record);
+
+#endif // RECORD_OUTPUT_H
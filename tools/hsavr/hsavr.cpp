@@ -0,0 +1,574 @@
+/*
+ * hsavr - Zyklengenauer Benchmark der Firmware unter simavr
+ *
+ * Führt die PlatformIO-ELF-Datei (megaatmega2560) im Befehlssatz-Simulator
+ * simavr aus und misst die Zyklen jedes Aufrufs von loop() und weiterer
+ * Funktionen ("Bereiche"). Damit werden AVR-spezifische Kosten sichtbar,
+ * die der Host-Build (src/native) nicht zeigt: Software-Gleitkomma,
+ * 16-Bit-Zeigerarithmetik, dtostrf, PROGMEM-Zugriffe.
+ *
+ * Peripherie: ADC-Eingänge mit festen Werten und Rauschen wie im
+ * Host-Simulator, DS1307 und SSD1306 am TWI, SD-Karte am SPI (Abbilddatei,
+ * siehe sd_card_model.h), 1-Hz-SQW der RTC an INT5. DHT und Geigerzähler
+ * sind nicht angeschlossen (Fehlerzweig der Treiber).
+ *
+ * Gemessen wird zwischen Einsprung (PC = Symboladresse) und Rücksprung
+ * (Stackzeiger über dem Wert beim Einsprung). Interrupts während eines
+ * Bereichs zählen mit, Schlafzyklen (Idle-Schlaf des Schedulers) nicht.
+ *
+ * EXPERIMENTELL: Die Anbindung an simavr ist bisher nur gegen
+ * nachgebildete simavr-Header übersetzt und noch nicht mit libsimavr und
+ * einer echten Firmware-ELF gelaufen.
+ * Ergebnisse vor der Verwendung als Basis gegen den Controller prüfen.
+ *
+ * Die Simulation ist deterministisch - gleiche ELF-Datei und Optionen
+ * ergeben gleiche Zyklen, daher taugt das Ergebnis als Basis für
+ * Regressionsvergleiche (--save-baseline / --baseline).
+ *
+ * Aufruf: hsavr [--elf DATEI] [--nm PROGRAMM] [--symbols DATEI] [--sd-image DATEI]
+ *               [--seconds S] [--warmup S] [--region NAME]... [--epoch UNIXZEIT]
+ *               [--csv DATEI] [--save-baseline DATEI] [--baseline DATEI]
+ *               [--tolerance PROZENT] [--serial]
+ *   --elf            Firmware (Standard: .pio/build/megaatmega2560/firmware.elf)
+ *   --nm, --symbols  Symboltabelle wie bei hsprof
+ *   --sd-image       FAT-Abbild als SD-Karte (ohne: keine Karte)
+ *   --seconds        Simulierte Laufzeit (Standard: 60)
+ *   --warmup         Erst danach beendete Aufrufe zählen (Standard: 15, Aufwärmphasen)
+ *   --region         Zu messende Funktion (mehrfach; Standard: loop, drainLogQueue,
+ *                    logData, readTDSSensor, updateDisplay)
+ *   --csv            Jeden gemessenen Aufruf als Zeile "bereich,zyklus,zyklen" schreiben
+ *   --save-baseline  Ergebnis als Basisdatei speichern
+ *   --baseline       Mit Basisdatei vergleichen; Rückgabe 2 bei Regression
+ *   --tolerance      Erlaubte Zunahme der mittleren Zyklen in % (Standard: 0.5)
+ *   --serial         Serielle Ausgabe der Firmware (UART0) auf stdout
+ */
+
+#include "avr_symbols.h"
+#include "sd_card_model.h"
+#include "twi_devices.h"
+
+#include <sim_avr.h>
+#include <sim_elf.h>
+#include <sim_io.h>
+#include <sim_irq.h>
+#include <sim_cycle_timers.h>
+#include <sim_time.h>
+#include <avr_adc.h>
+#include <avr_ioport.h>
+#include <avr_spi.h>
+#include <avr_twi.h>
+#include <avr_uart.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <string>
+#include <vector>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+static const uint32_t HSAVR_FREQUENCY = 16000000UL;
+static const uint32_t HSAVR_VCC_MV = 5000;
+static const uint32_t HSAVR_DEFAULT_EPOCH = 1750000000UL;   // wie der Host-Benchmark
+static const uint8_t OLED_ADDRESS = 0x3C;                   // OLED_I2C_ADDRESS
+
+// Anschlüsse laut src/config.h
+static const char SD_CS_PORT = 'B';          // SD_CHIP_SELECT = 10 (PB4)
+static const int SD_CS_BIT = 4;
+static const char RTC_SQW_PORT = 'E';        // RTC_SQW_PIN = 3 (PE5, INT5)
+static const int RTC_SQW_BIT = 5;
+
+// Logging-Pfad seit der Log-Queue: drainLogQueue() -> logData() (logSensorData()
+// hat keine Aufrufer mehr und fällt mit --gc-sections weg)
+static const char* DEFAULT_REGIONS[] = { "loop", "drainLogQueue", "logData", "readTDSSensor", "updateDisplay" };
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+struct AdcInput {
+  uint16_t value;                   // ADC-Wert 0-1023
+  uint16_t noise;                   // Gleichverteiltes Rauschen +/-
+};
+
+// Ruhewerte wie im Host-Simulator: MQ-Sensoren A0-A8, Mikrofone A9/A10,
+// LDR A11, TDS A12
+static const AdcInput ADC_INPUTS[16] = {
+  {300, 3}, {300, 3}, {300, 3}, {300, 3}, {300, 3}, {300, 3}, {300, 3}, {300, 3},
+  {300, 3}, {512, 40}, {512, 60}, {600, 3}, {350, 3}, {0, 0}, {0, 0}, {0, 0}
+};
+
+struct Region {
+  std::string name;
+  bool found;
+  unsigned long calls;
+  uint64_t minCycles;
+  uint64_t maxCycles;
+  uint64_t totalCycles;
+};
+
+struct ActiveRegion {
+  int region;
+  uint16_t entrySp;
+  uint64_t startCycle;
+  uint64_t startSleep;
+};
+
+struct BaselineEntry {
+  unsigned long calls;
+  double meanCycles;
+  uint64_t maxCycles;
+};
+
+enum TwiTarget {
+  TWI_TARGET_NONE,
+  TWI_TARGET_RTC,
+  TWI_TARGET_OLED
+};
+
+struct Harness {
+  avr_t* avr;
+  avr_irq_t* spiInput;
+  avr_irq_t* twiInput;
+  avr_irq_t* sqwPin;
+  SdCardModel card;
+  Ds1307Model rtc;
+  Ssd1306Model oled;
+  uint8_t twiTarget;
+  uint8_t twiAddress;
+  bool sqwLevel;
+  uint32_t noiseState;
+  bool serialOutput;
+};
+
+// ==============================================
+// PERIPHERIE
+// ==============================================
+
+static double simSeconds(const Harness* h) {
+  return (double)h->avr->cycle / h->avr->frequency;
+}
+
+static uint32_t nextNoise(Harness* h) {
+  uint32_t x = h->noiseState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  h->noiseState = x;
+  return x;
+}
+
+// Vor jeder Wandlung den Eingang des gewählten Kanals setzen
+static void adcTrigger(avr_irq_t* irq, uint32_t value, void* param) {
+  (void)irq;
+  Harness* h = (Harness*)param;
+  union {
+    avr_adc_mux_t mux;
+    uint32_t raw;
+  } event = {};
+  event.raw = value;
+  if (event.mux.kind != ADC_MUX_SINGLE || event.mux.src >= 16) return;
+
+  const AdcInput* input = &ADC_INPUTS[event.mux.src];
+  int32_t counts = input->value;
+  if (input->noise) {
+    counts += (int32_t)(nextNoise(h) % (2U * input->noise + 1)) - input->noise;
+  }
+  counts = std::max<int32_t>(0, std::min<int32_t>(1023, counts));
+  avr_raise_irq(avr_io_getirq(h->avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_ADC0 + event.mux.src),
+                (uint32_t)counts * HSAVR_VCC_MV / 1023);
+}
+
+static void spiOutput(avr_irq_t* irq, uint32_t value, void* param) {
+  (void)irq;
+  Harness* h = (Harness*)param;
+  avr_raise_irq(h->spiInput, sdCardTransfer(&h->card, (uint8_t)value));
+}
+
+static void sdChipSelect(avr_irq_t* irq, uint32_t value, void* param) {
+  (void)irq;
+  Harness* h = (Harness*)param;
+  sdCardSelect(&h->card, value == 0);
+}
+
+static void twiFinish(Harness* h) {
+  if (h->twiTarget == TWI_TARGET_RTC) ds1307Stop(&h->rtc, simSeconds(h));
+  h->twiTarget = TWI_TARGET_NONE;
+}
+
+static void twiOutput(avr_irq_t* irq, uint32_t value, void* param) {
+  (void)irq;
+  Harness* h = (Harness*)param;
+  avr_twi_msg_irq_t message;
+  message.u.v = value;
+  uint8_t condition = message.u.twi.msg;
+
+  if (condition & TWI_COND_STOP) twiFinish(h);
+
+  if (condition & TWI_COND_START) {
+    twiFinish(h);   // Wiederholtes START beendet die vorige Übertragung
+    uint8_t address = message.u.twi.addr >> 1;
+    bool read = message.u.twi.addr & 1;
+    if (address == DS1307_ADDRESS) {
+      h->twiTarget = TWI_TARGET_RTC;
+      ds1307Start(&h->rtc, read, simSeconds(h));
+    } else if (address == OLED_ADDRESS) {
+      h->twiTarget = TWI_TARGET_OLED;
+      ssd1306Start(&h->oled);
+    }
+    h->twiAddress = message.u.twi.addr;
+    // Ohne ACK sieht die Firmware ein NACK auf die Adresse
+    if (h->twiTarget != TWI_TARGET_NONE) {
+      avr_raise_irq(h->twiInput, avr_twi_irq_msg(TWI_COND_ACK, h->twiAddress, 1));
+    }
+  }
+  if (h->twiTarget == TWI_TARGET_NONE) return;
+
+  if (condition & TWI_COND_WRITE) {
+    avr_raise_irq(h->twiInput, avr_twi_irq_msg(TWI_COND_ACK, h->twiAddress, 1));
+    if (h->twiTarget == TWI_TARGET_RTC) {
+      ds1307Write(&h->rtc, message.u.twi.data);
+    } else {
+      ssd1306Write(&h->oled, message.u.twi.data);
+    }
+  }
+  if (condition & TWI_COND_READ) {
+    uint8_t data = h->twiTarget == TWI_TARGET_RTC ? ds1307Read(&h->rtc) : 0xFF;
+    avr_raise_irq(h->twiInput, avr_twi_irq_msg(TWI_COND_READ, h->twiAddress, data));
+  }
+}
+
+// 1-Hz-Rechteck: Flanke alle 500 ms, solange SQWE gesetzt ist
+static avr_cycle_count_t sqwTick(avr_t* avr, avr_cycle_count_t when, void* param) {
+  Harness* h = (Harness*)param;
+  h->sqwLevel = ds1307SquareWave(&h->rtc) ? !h->sqwLevel : true;
+  avr_raise_irq(h->sqwPin, h->sqwLevel);
+  return when + avr_usec_to_cycles(avr, 500000);
+}
+
+static void uartOutput(avr_irq_t* irq, uint32_t value, void* param) {
+  (void)irq;
+  Harness* h = (Harness*)param;
+  if (h->serialOutput) putchar((int)value);
+}
+
+static void connectPeripherals(Harness* h) {
+  avr_t* avr = h->avr;
+
+  avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_ADC_GETIRQ, ADC_IRQ_OUT_TRIGGER), adcTrigger, h);
+
+  h->spiInput = avr_io_getirq(avr, AVR_IOCTL_SPI_GETIRQ(0), SPI_IRQ_INPUT);
+  avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_SPI_GETIRQ(0), SPI_IRQ_OUTPUT), spiOutput, h);
+  avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ(SD_CS_PORT), SD_CS_BIT), sdChipSelect, h);
+
+  h->twiInput = avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT);
+  avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT), twiOutput, h);
+
+  h->sqwPin = avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ(RTC_SQW_PORT), RTC_SQW_BIT);
+  h->sqwLevel = true;
+  avr_raise_irq(h->sqwPin, 1);
+  avr_cycle_timer_register_usec(avr, 500000, sqwTick, h);
+
+  // UART0 nicht von simavr ausgeben lassen, nur über uartOutput
+  uint32_t flags = 0;
+  avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+  flags &= ~AVR_UART_FLAG_STDIO;
+  avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+  avr_irq_register_notify(avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT), uartOutput, h);
+}
+
+// ==============================================
+// BEREICHE
+// ==============================================
+
+// Einsprungadresse -> Bereich; überladene Funktionen teilen sich einen Bereich
+static void mapRegions(const std::vector<AvrSymbol>& symbols, std::vector<Region>* regions,
+                       std::map<uint32_t, int>* entries) {
+  for (const AvrSymbol& symbol : symbols) {
+    std::string base = avrSymbolBaseName(symbol.name);
+    for (size_t i = 0; i < regions->size(); i++) {
+      if ((*regions)[i].name == base || (*regions)[i].name == symbol.name) {
+        (*entries)[symbol.address] = (int)i;
+        (*regions)[i].found = true;
+      }
+    }
+  }
+}
+
+static uint16_t stackPointer(const avr_t* avr) {
+  return avr->data[R_SPL] | (avr->data[R_SPH] << 8);
+}
+
+static void finishRegion(const ActiveRegion* active, uint64_t cycles, uint64_t warmupCycles,
+                         std::vector<Region>* regions, FILE* csv) {
+  if (active->startCycle < warmupCycles) return;
+  Region* region = &(*regions)[active->region];
+  if (region->calls == 0 || cycles < region->minCycles) region->minCycles = cycles;
+  if (cycles > region->maxCycles) region->maxCycles = cycles;
+  region->totalCycles += cycles;
+  region->calls++;
+  if (csv) {
+    fprintf(csv, "%s,%llu,%llu\n", region->name.c_str(),
+            (unsigned long long)active->startCycle, (unsigned long long)cycles);
+  }
+}
+
+// ==============================================
+// BASIS
+// ==============================================
+
+static bool saveBaseline(const char* path, const std::vector<Region>& regions) {
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+  fprintf(file, "# hsavr-Basis: bereich,aufrufe,mittel,max (Zyklen)\n");
+  for (const Region& region : regions) {
+    if (region.calls == 0) continue;
+    fprintf(file, "%s,%lu,%.1f,%llu\n", region.name.c_str(), region.calls,
+            (double)region.totalCycles / region.calls, (unsigned long long)region.maxCycles);
+  }
+  fclose(file);
+  return true;
+}
+
+static bool loadBaseline(const char* path, std::map<std::string, BaselineEntry>* baseline) {
+  FILE* file = fopen(path, "r");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    if (line[0] == '#') continue;
+    char name[128];
+    unsigned long long maxCycles;
+    BaselineEntry entry;
+    if (sscanf(line, "%127[^,],%lu,%lf,%llu", name, &entry.calls, &entry.meanCycles, &maxCycles) == 4) {
+      entry.maxCycles = maxCycles;
+      (*baseline)[name] = entry;
+    }
+  }
+  fclose(file);
+  return true;
+}
+
+// Vergleich der mittleren Zyklen; true wenn ein Bereich über der Toleranz liegt
+static bool compareBaseline(const std::map<std::string, BaselineEntry>& baseline,
+                            const std::vector<Region>& regions, double tolerancePercent) {
+  bool regression = false;
+  printf("\n%-20s %12s %12s %9s %12s %12s\n", "Bereich", "Basis", "Mittel", "Δ %", "Basis max", "Max");
+  for (const Region& region : regions) {
+    auto it = baseline.find(region.name);
+    if (it == baseline.end() || region.calls == 0) {
+      printf("%-20s %s\n", region.name.c_str(), it == baseline.end() ? "(nicht in der Basis)" : "(keine Aufrufe)");
+      continue;
+    }
+    double mean = (double)region.totalCycles / region.calls;
+    double delta = it->second.meanCycles > 0 ? (mean / it->second.meanCycles - 1.0) * 100.0 : 0.0;
+    bool worse = delta > tolerancePercent;
+    regression |= worse;
+    printf("%-20s %12.1f %12.1f %+7.2f%% %12llu %12llu%s\n", region.name.c_str(), it->second.meanCycles,
+           mean, delta, (unsigned long long)it->second.maxCycles, (unsigned long long)region.maxCycles,
+           worse ? "  REGRESSION" : "");
+  }
+  return regression;
+}
+
+// ==============================================
+// AUSGABE
+// ==============================================
+
+static void printRegions(const std::vector<Region>& regions) {
+  printf("\n%-20s %10s %12s %12s %12s %14s %11s\n", "Bereich", "Aufrufe", "Min", "Mittel", "Max", "Summe", "Mittel µs");
+  for (const Region& region : regions) {
+    if (!region.found) {
+      printf("%-20s (kein Symbol - Funktion eingebettet oder nicht gelinkt)\n", region.name.c_str());
+      continue;
+    }
+    if (region.calls == 0) {
+      printf("%-20s %10lu\n", region.name.c_str(), 0UL);
+      continue;
+    }
+    double mean = (double)region.totalCycles / region.calls;
+    printf("%-20s %10lu %12llu %12.1f %12llu %14llu %10.1f\n", region.name.c_str(), region.calls,
+           (unsigned long long)region.minCycles, mean, (unsigned long long)region.maxCycles,
+           (unsigned long long)region.totalCycles, mean * 1e6 / HSAVR_FREQUENCY);
+  }
+}
+
+static void printSummary(const Harness* h, uint64_t sleepCycles, double hostSeconds) {
+  uint64_t cycles = h->avr->cycle;
+  printf("\nSimuliert: %.1f s, %llu Zyklen (%.1f %% Schlaf) in %.1f s Rechenzeit\n",
+         simSeconds(h), (unsigned long long)cycles, cycles ? 100.0 * sleepCycles / cycles : 0.0, hostSeconds);
+  printf("SD: %lu Befehle, %lu Blöcke gelesen, %lu geschrieben, %lu Fehler%s\n",
+         h->card.stats.commands, h->card.stats.blocksRead, h->card.stats.blocksWritten,
+         h->card.stats.errors, h->card.image ? "" : " (keine Karte, --sd-image)");
+  printf("I2C: RTC %lu Übertragungen, OLED %lu Übertragungen / %lu Bytes\n",
+         h->rtc.transactions, h->oled.transactions, h->oled.bytes);
+}
+
+// ==============================================
+// HAUPTPROGRAMM
+// ==============================================
+
+static void usage(const char* program) {
+  printf("Aufruf: %s [--elf DATEI] [--nm PROGRAMM] [--symbols DATEI] [--sd-image DATEI]\n"
+         "       [--seconds S] [--warmup S] [--region NAME]... [--epoch UNIXZEIT]\n"
+         "       [--csv DATEI] [--save-baseline DATEI] [--baseline DATEI]\n"
+         "       [--tolerance PROZENT] [--serial]\n", program);
+}
+
+int main(int argc, char** argv) {
+  const char* elfPath = ".pio/build/megaatmega2560/firmware.elf";
+  const char* nmProgram = "avr-nm";
+  const char* symbolsPath = NULL;
+  const char* imagePath = NULL;
+  const char* csvPath = NULL;
+  const char* saveBaselinePath = NULL;
+  const char* baselinePath = NULL;
+  double seconds = 60.0;
+  double warmup = 15.0;
+  double tolerance = 0.5;
+  uint32_t epoch = HSAVR_DEFAULT_EPOCH;
+  bool serialOutput = false;
+  std::vector<Region> regions;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--elf") == 0 && i + 1 < argc) {
+      elfPath = argv[++i];
+    } else if (strcmp(argv[i], "--nm") == 0 && i + 1 < argc) {
+      nmProgram = argv[++i];
+    } else if (strcmp(argv[i], "--symbols") == 0 && i + 1 < argc) {
+      symbolsPath = argv[++i];
+    } else if (strcmp(argv[i], "--sd-image") == 0 && i + 1 < argc) {
+      imagePath = argv[++i];
+    } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+      seconds = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+      warmup = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--region") == 0 && i + 1 < argc) {
+      regions.push_back(Region{ argv[++i], false, 0, 0, 0, 0 });
+    } else if (strcmp(argv[i], "--epoch") == 0 && i + 1 < argc) {
+      epoch = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
+      csvPath = argv[++i];
+    } else if (strcmp(argv[i], "--save-baseline") == 0 && i + 1 < argc) {
+      saveBaselinePath = argv[++i];
+    } else if (strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+      baselinePath = argv[++i];
+    } else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+      tolerance = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--serial") == 0) {
+      serialOutput = true;
+    } else {
+      usage(argv[0]);
+      return strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0 ? 0 : 1;
+    }
+  }
+  if (seconds <= warmup) {
+    fprintf(stderr, "hsavr: --seconds muss größer als --warmup sein\n");
+    return 1;
+  }
+  if (regions.empty()) {
+    for (const char* name : DEFAULT_REGIONS) regions.push_back(Region{ name, false, 0, 0, 0, 0 });
+  }
+
+  std::vector<AvrSymbol> symbols;
+  if (!loadAvrSymbols(symbolsPath, nmProgram, elfPath, &symbols)) return 1;
+  std::map<uint32_t, int> entries;
+  mapRegions(symbols, &regions, &entries);
+
+  std::map<std::string, BaselineEntry> baseline;
+  if (baselinePath && !loadBaseline(baselinePath, &baseline)) return 1;
+
+  elf_firmware_t firmware;
+  memset(&firmware, 0, sizeof(firmware));
+  if (elf_read_firmware(elfPath, &firmware) != 0) {
+    fprintf(stderr, "hsavr: %s nicht lesbar\n", elfPath);
+    return 1;
+  }
+
+  Harness harness;
+  memset(&harness, 0, sizeof(harness));
+  harness.avr = avr_make_mcu_by_name("atmega2560");
+  if (!harness.avr) {
+    fprintf(stderr, "hsavr: simavr kennt atmega2560 nicht\n");
+    return 1;
+  }
+  avr_init(harness.avr);
+  avr_load_firmware(harness.avr, &firmware);
+  harness.avr->frequency = HSAVR_FREQUENCY;
+  harness.avr->vcc = HSAVR_VCC_MV;
+  harness.avr->avcc = HSAVR_VCC_MV;
+  harness.avr->aref = HSAVR_VCC_MV;
+  harness.noiseState = 1;
+  harness.serialOutput = serialOutput;
+  if (!sdCardInit(&harness.card, imagePath)) return 1;
+  ds1307Init(&harness.rtc, epoch);
+  ssd1306Init(&harness.oled, OLED_ADDRESS);
+  connectPeripherals(&harness);
+
+  FILE* csv = NULL;
+  if (csvPath) {
+    csv = fopen(csvPath, "w");
+    if (!csv) {
+      perror(csvPath);
+      return 1;
+    }
+    fprintf(csv, "bereich,zyklus,zyklen\n");
+  }
+
+  // Einzelschritte: nach jedem Befehl PC und Stackzeiger prüfen
+  avr_t* avr = harness.avr;
+  uint64_t endCycle = (uint64_t)(seconds * HSAVR_FREQUENCY);
+  uint64_t warmupCycles = (uint64_t)(warmup * HSAVR_FREQUENCY);
+  uint64_t sleepCycles = 0;
+  std::vector<ActiveRegion> active;
+  clock_t hostStart = clock();
+
+  while (avr->cycle < endCycle) {
+    bool sleeping = avr->state == cpu_Sleeping;
+    uint64_t before = avr->cycle;
+    int state = avr_run(avr);
+    if (sleeping) sleepCycles += avr->cycle - before;
+    if (state == cpu_Done || state == cpu_Crashed) {
+      fprintf(stderr, "hsavr: Firmware angehalten (%s) bei PC 0x%05x\n",
+              state == cpu_Crashed ? "Absturz" : "Ende", (unsigned)avr->pc);
+      break;
+    }
+
+    uint16_t sp = stackPointer(avr);
+    while (!active.empty() && sp > active.back().entrySp) {
+      const ActiveRegion& done = active.back();
+      finishRegion(&done, (avr->cycle - done.startCycle) - (sleepCycles - done.startSleep),
+                   warmupCycles, &regions, csv);
+      active.pop_back();
+    }
+
+    auto entry = entries.find(avr->pc);
+    if (entry != entries.end()) {
+      bool nested = false;
+      for (const ActiveRegion& a : active) nested |= a.region == entry->second;
+      if (!nested) active.push_back(ActiveRegion{ entry->second, sp, avr->cycle, sleepCycles });
+    }
+  }
+  double hostSeconds = (double)(clock() - hostStart) / CLOCKS_PER_SEC;
+
+  if (csv) fclose(csv);
+  sdCardClose(&harness.card);
+  fflush(stdout);
+
+  printRegions(regions);
+  printSummary(&harness, sleepCycles, hostSeconds);
+
+  if (saveBaselinePath && !saveBaseline(saveBaselinePath, regions)) return 1;
+  if (baselinePath && compareBaseline(baseline, regions, tolerance)) return 2;
+  return 0;
+}
@@ -0,0 +1,288 @@
+/*
+ * Implementierung des SD-Kartenmodells
+ */
+
+#include "sd_card_model.h"
+#include <cstring>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+enum SdCardState {
+  SD_STATE_COMMAND,
+  SD_STATE_WRITE_TOKEN,
+  SD_STATE_WRITE_DATA
+};
+
+static const uint8_t R1_READY = 0x00;
+static const uint8_t R1_IDLE = 0x01;
+static const uint8_t R1_ILLEGAL_COMMAND = 0x04;
+static const uint8_t R1_ADDRESS_ERROR = 0x20;
+
+static const uint8_t TOKEN_START_BLOCK = 0xFE;
+static const uint8_t TOKEN_MULTI_WRITE = 0xFC;
+static const uint8_t TOKEN_STOP_TRAN = 0xFD;
+static const uint8_t DATA_ACCEPTED = 0x05;
+static const uint8_t DATA_WRITE_ERROR = 0x0D;
+static const uint8_t CARD_BUSY = 0x00;
+
+// ==============================================
+// ANTWORTPUFFER
+// ==============================================
+
+static void respond(SdCardModel* card, uint8_t value) {
+  if (card->responseFill < SD_RESPONSE_MAX) {
+    card->response[card->responseFill++] = value;
+  }
+}
+
+static void respondRegister(SdCardModel* card, uint8_t r1, const uint8_t* data, uint8_t length) {
+  respond(card, r1);
+  respond(card, 0xFF);
+  respond(card, TOKEN_START_BLOCK);
+  for (uint8_t i = 0; i < length; i++) respond(card, data[i]);
+  respond(card, 0xFF);   // CRC wird nicht geprüft
+  respond(card, 0xFF);
+}
+
+// ==============================================
+// BLOCKZUGRIFF
+// ==============================================
+
+static void readBlock(SdCardModel* card, uint32_t block, uint8_t r1) {
+  uint8_t data[SD_BLOCK_SIZE];
+  memset(data, 0, sizeof(data));
+  fseek(card->image, (long)block * SD_BLOCK_SIZE, SEEK_SET);
+  if (fread(data, 1, sizeof(data), card->image) != sizeof(data)) {
+    card->stats.errors++;
+  }
+  respond(card, r1);
+  respond(card, 0xFF);
+  respond(card, TOKEN_START_BLOCK);
+  for (uint16_t i = 0; i < SD_BLOCK_SIZE; i++) respond(card, data[i]);
+  respond(card, 0xFF);
+  respond(card, 0xFF);
+  card->stats.blocksRead++;
+}
+
+static bool writeBlock(SdCardModel* card) {
+  if (card->writeBlock >= card->blocks) {
+    card->stats.errors++;
+    return false;
+  }
+  fseek(card->image, (long)card->writeBlock * SD_BLOCK_SIZE, SEEK_SET);
+  if (fwrite(card->block, 1, SD_BLOCK_SIZE, card->image) != SD_BLOCK_SIZE) {
+    card->stats.errors++;
+    return false;
+  }
+  card->stats.blocksWritten++;
+  return true;
+}
+
+// ==============================================
+// BEFEHLE
+// ==============================================
+
+static void execute(SdCardModel* card) {
+  uint8_t index = card->command[0] & 0x3F;
+  uint32_t arg = ((uint32_t)card->command[1] << 24) | ((uint32_t)card->command[2] << 16) |
+                 ((uint32_t)card->command[3] << 8) | card->command[4];
+  bool app = card->appCommand;
+  card->appCommand = false;
+  card->stats.commands++;
+
+  card->responseFill = 0;
+  card->responsePosition = 0;
+  respond(card, 0xFF);   // Ncr: ein Byte bis zur Antwort
+  uint8_t r1 = card->idle ? R1_IDLE : R1_READY;
+
+  if (app && index == 41) {               // ACMD41: Initialisierung sofort fertig
+    card->idle = false;
+    respond(card, R1_READY);
+    return;
+  }
+  if (app && index == 23) {               // ACMD23: Vorlöschen, ohne Wirkung
+    respond(card, r1);
+    return;
+  }
+
+  switch (index) {
+    case 0:                               // GO_IDLE_STATE
+      card->idle = true;
+      card->state = SD_STATE_COMMAND;
+      respond(card, R1_IDLE);
+      break;
+
+    case 8:                               // SEND_IF_COND: Spannung und Prüfmuster zurück
+      respond(card, r1);
+      respond(card, 0x00);
+      respond(card, 0x00);
+      respond(card, (arg >> 8) & 0x0F);
+      respond(card, arg & 0xFF);
+      break;
+
+    case 9: {                             // SEND_CSD (Version 2.0)
+      uint32_t size = card->blocks / 1024 ? card->blocks / 1024 - 1 : 0;
+      uint8_t csd[16] = { 0x40, 0x0E, 0x00, 0x32, 0x5B, 0x59, 0x00,
+                          (uint8_t)((size >> 16) & 0x3F), (uint8_t)(size >> 8), (uint8_t)size,
+                          0x7F, 0x80, 0x0A, 0x40, 0x00, 0x01 };
+      respondRegister(card, r1, csd, sizeof(csd));
+      break;
+    }
+
+    case 10: {                            // SEND_CID
+      uint8_t cid[16] = { 0x00, 'H', 'S', 'H', 'S', 'A', 'V', 'R', 0x10,
+                          0x00, 0x00, 0x00, 0x01, 0x01, 0x9A, 0x01 };
+      respondRegister(card, r1, cid, sizeof(cid));
+      break;
+    }
+
+    case 12:                              // STOP_TRANSMISSION
+      card->state = SD_STATE_COMMAND;
+      respond(card, r1);
+      respond(card, CARD_BUSY);
+      break;
+
+    case 13:                              // SEND_STATUS (R2)
+      respond(card, r1);
+      respond(card, 0x00);
+      break;
+
+    case 16:                              // SET_BLOCKLEN (SDHC: immer 512)
+    case 59:                              // CRC_ON_OFF
+      respond(card, r1);
+      break;
+
+    case 17:                              // READ_SINGLE_BLOCK
+      if (arg >= card->blocks) {
+        card->stats.errors++;
+        respond(card, r1 | R1_ADDRESS_ERROR);
+      } else {
+        readBlock(card, arg, r1);
+      }
+      break;
+
+    case 24:                              // WRITE_BLOCK
+    case 25:                              // WRITE_MULTIPLE_BLOCK
+      if (arg >= card->blocks) {
+        card->stats.errors++;
+        respond(card, r1 | R1_ADDRESS_ERROR);
+        break;
+      }
+      respond(card, r1);
+      card->writeBlock = arg;
+      card->multiWrite = index == 25;
+      card->state = SD_STATE_WRITE_TOKEN;
+      break;
+
+    case 55:                              // APP_CMD
+      card->appCommand = true;
+      respond(card, r1);
+      break;
+
+    case 58:                              // READ_OCR: eingeschaltet, SDHC (CCS)
+      respond(card, r1);
+      respond(card, 0xC0);
+      respond(card, 0xFF);
+      respond(card, 0x80);
+      respond(card, 0x00);
+      break;
+
+    default:
+      card->stats.errors++;
+      respond(card, r1 | R1_ILLEGAL_COMMAND);
+      break;
+  }
+}
+
+// ==============================================
+// SCHNITTSTELLE
+// ==============================================
+
+bool sdCardInit(SdCardModel* card, const char* imagePath) {
+  memset(card, 0, sizeof(*card));
+  card->state = SD_STATE_COMMAND;
+  if (!imagePath) return true;
+
+  card->image = fopen(imagePath, "r+b");
+  if (!card->image) {
+    perror(imagePath);
+    return false;
+  }
+  fseek(card->image, 0, SEEK_END);
+  card->blocks = (uint32_t)(ftell(card->image) / SD_BLOCK_SIZE);
+  if (card->blocks == 0) {
+    fprintf(stderr, "%s: Abbild ist leer\n", imagePath);
+    fclose(card->image);
+    card->image = NULL;
+    return false;
+  }
+  return true;
+}
+
+void sdCardClose(SdCardModel* card) {
+  if (card->image) {
+    fclose(card->image);
+    card->image = NULL;
+  }
+}
+
+void sdCardSelect(SdCardModel* card, bool selected) {
+  card->selected = selected;
+  if (!selected) card->commandFill = 0;
+}
+
+uint8_t sdCardTransfer(SdCardModel* card, uint8_t mosi) {
+  if (!card->image || !card->selected) return 0xFF;
+
+  uint8_t miso = 0xFF;
+  if (card->responsePosition < card->responseFill) {
+    miso = card->response[card->responsePosition++];
+  }
+
+  switch (card->state) {
+    case SD_STATE_COMMAND:
+      // Ein Befehl beginnt mit 01xxxxxx, Füllbytes (0xFF) dazwischen ignorieren
+      if (card->commandFill == 0 && (mosi & 0xC0) != 0x40) break;
+      card->command[card->commandFill++] = mosi;
+      if (card->commandFill == sizeof(card->command)) {
+        card->commandFill = 0;
+        execute(card);
+      }
+      break;
+
+    case SD_STATE_WRITE_TOKEN:
+      if (mosi == TOKEN_START_BLOCK || (card->multiWrite && mosi == TOKEN_MULTI_WRITE)) {
+        card->blockFill = 0;
+        card->state = SD_STATE_WRITE_DATA;
+      } else if (card->multiWrite && mosi == TOKEN_STOP_TRAN) {
+        card->multiWrite = false;
+        card->state = SD_STATE_COMMAND;
+        card->responseFill = 0;
+        card->responsePosition = 0;
+        respond(card, 0xFF);
+        respond(card, CARD_BUSY);
+      }
+      break;
+
+    case SD_STATE_WRITE_DATA:
+      card->block[card->blockFill++] = mosi;
+      if (card->blockFill == sizeof(card->block)) {
+        bool ok = writeBlock(card);
+        card->responseFill = 0;
+        card->responsePosition = 0;
+        respond(card, ok ? DATA_ACCEPTED : DATA_WRITE_ERROR);
+        respond(card, CARD_BUSY);
+        if (ok && card->multiWrite) {
+          card->writeBlock++;
+          card->state = SD_STATE_WRITE_TOKEN;
+        } else {
+          card->multiWrite = false;
+          card->state = SD_STATE_COMMAND;
+        }
+      }
+      break;
+  }
+  return miso;
+}
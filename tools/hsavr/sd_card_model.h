@@ -0,0 +1,90 @@
+/*
+ * SD-Karte im SPI-Modus für hsavr
+ *
+ * Verhält sich wie eine SDHC-Karte (Blockadressierung) mit einer
+ * Abbilddatei als Speicher: CMD0/8/9/10/12/13/16/17/24/25/55/58/59 und
+ * ACMD23/41, so viel wie Sd2Card der SD-Bibliothek verwendet. Antworten
+ * kommen ohne Wartezeit (ein Füllbyte vor R1, ein Busy-Byte nach dem
+ * Schreiben) - gemessen wird der Aufwand der Firmware, nicht der Karte.
+ *
+ * Das Abbild muss ein FAT-Dateisystem enthalten, z.B.:
+ *   dd if=/dev/zero of=sd.img bs=1M count=64 && mkfs.vfat sd.img
+ *
+ * Unabhängig von simavr: hsavr.cpp reicht jedes SPI-Byte und den Pegel
+ * der CS-Leitung durch.
+ */
+
+#ifndef SD_CARD_MODEL_H
+#define SD_CARD_MODEL_H
+
+#include <cstdint>
+#include <cstdio>
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+const uint16_t SD_BLOCK_SIZE = 512;
+const uint16_t SD_RESPONSE_MAX = SD_BLOCK_SIZE + 16;
+
+/**
+ * @brief Zähler des Kartenmodells.
+ */
+struct SdCardStats {
+  unsigned long commands;           ///< Ausgeführte Befehle
+  unsigned long blocksRead;         ///< Gelesene Blöcke
+  unsigned long blocksWritten;      ///< Geschriebene Blöcke
+  unsigned long errors;             ///< Unbekannte Befehle, Adressen außerhalb des Abbilds
+};
+
+/**
+ * @brief Zustand der Karte.
+ */
+struct SdCardModel {
+  FILE* image;                      ///< Abbilddatei (NULL = keine Karte)
+  uint32_t blocks;                  ///< Größe des Abbilds in Blöcken
+  bool selected;                    ///< CS aktiv (low)
+  bool idle;                        ///< Nach CMD0 bis ACMD41
+  bool appCommand;                  ///< CMD55 erhalten
+  uint8_t state;                    ///< Befehl, Datenstart-Token oder Datenblock erwartet
+  bool multiWrite;                  ///< CMD25 aktiv
+  uint32_t writeBlock;              ///< Zielblock des laufenden Schreibvorgangs
+  uint8_t command[6];
+  uint8_t commandFill;
+  uint8_t block[SD_BLOCK_SIZE + 2]; ///< Empfangener Datenblock mit CRC
+  uint16_t blockFill;
+  uint8_t response[SD_RESPONSE_MAX];
+  uint16_t responseFill;
+  uint16_t responsePosition;
+  SdCardStats stats;
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Öffnet das Abbild und setzt die Karte zurück.
+ *
+ * @param card Kartenmodell
+ * @param imagePath Abbilddatei oder NULL (Karte fehlt, MISO bleibt 0xFF)
+ * @return false wenn die Datei nicht lesbar/schreibbar ist (Meldung auf stderr)
+ */
+bool sdCardInit(SdCardModel* card, const char* imagePath);
+
+/**
+ * @brief Schreibt ausstehende Blöcke und schließt das Abbild.
+ */
+void sdCardClose(SdCardModel* card);
+
+/**
+ * @brief Pegel der CS-Leitung (low = ausgewählt).
+ */
+void sdCardSelect(SdCardModel* card, bool selected);
+
+/**
+ * @brief Ein SPI-Byte: nimmt MOSI entgegen und liefert MISO.
+ */
+uint8_t sdCardTransfer(SdCardModel* card, uint8_t mosi);
+
+#endif // SD_CARD_MODEL_H
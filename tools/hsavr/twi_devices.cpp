@@ -0,0 +1,102 @@
+/*
+ * Implementierung der I2C-Gerätemodelle
+ */
+
+#include "twi_devices.h"
+#include "time_convert.h"
+#include <cstring>
+
+// ==============================================
+// DS1307
+// ==============================================
+
+static const uint8_t DS1307_TIME_REGISTERS = 7;
+static const uint8_t DS1307_REG_CONTROL = 0x07;
+static const uint8_t DS1307_SQWE = 0x10;
+
+static uint8_t toBcd(uint8_t value) {
+  return ((value / 10) << 4) | (value % 10);
+}
+
+static uint8_t fromBcd(uint8_t value) {
+  return (value >> 4) * 10 + (value & 0x0F);
+}
+
+// Zeitregister aus der simulierten Zeit (24-Stunden-Modus, Uhr läuft)
+static void latchTime(Ds1307Model* rtc, double seconds) {
+  uint32_t epoch = (uint32_t)(rtc->epochOffset + (int64_t)seconds);
+  CivilTime now;
+  epochToCivil(epoch, &now);
+  rtc->registers[0] = toBcd(now.second);
+  rtc->registers[1] = toBcd(now.minute);
+  rtc->registers[2] = toBcd(now.hour);
+  rtc->registers[3] = (uint8_t)((epoch / 86400UL + 4) % 7) + 1;   // 1 = Sonntag
+  rtc->registers[4] = toBcd(now.day);
+  rtc->registers[5] = toBcd(now.month);
+  rtc->registers[6] = toBcd((uint8_t)(now.year - 2000));
+}
+
+void ds1307Init(Ds1307Model* rtc, uint32_t epoch) {
+  memset(rtc, 0, sizeof(*rtc));
+  rtc->epochOffset = epoch;
+}
+
+void ds1307Start(Ds1307Model* rtc, bool read, double seconds) {
+  latchTime(rtc, seconds);
+  rtc->pointerPending = !read;
+  rtc->timeWritten = false;
+  rtc->transactions++;
+}
+
+void ds1307Write(Ds1307Model* rtc, uint8_t value) {
+  if (rtc->pointerPending) {
+    rtc->pointer = value % DS1307_REGISTERS;
+    rtc->pointerPending = false;
+    return;
+  }
+  if (rtc->pointer < DS1307_TIME_REGISTERS) rtc->timeWritten = true;
+  rtc->registers[rtc->pointer] = value;
+  rtc->pointer = (rtc->pointer + 1) % DS1307_REGISTERS;
+}
+
+uint8_t ds1307Read(Ds1307Model* rtc) {
+  uint8_t value = rtc->registers[rtc->pointer];
+  rtc->pointer = (rtc->pointer + 1) % DS1307_REGISTERS;
+  return value;
+}
+
+void ds1307Stop(Ds1307Model* rtc, double seconds) {
+  if (!rtc->timeWritten) return;
+  rtc->timeWritten = false;
+
+  CivilTime time;
+  time.second = fromBcd(rtc->registers[0] & 0x7F);
+  time.minute = fromBcd(rtc->registers[1]);
+  time.hour = fromBcd(rtc->registers[2] & 0x3F);
+  time.day = fromBcd(rtc->registers[4]);
+  time.month = fromBcd(rtc->registers[5]);
+  time.year = 2000 + fromBcd(rtc->registers[6]);
+  rtc->epochOffset = (int64_t)civilToEpoch(&time) - (int64_t)seconds;
+}
+
+bool ds1307SquareWave(const Ds1307Model* rtc) {
+  return (rtc->registers[DS1307_REG_CONTROL] & DS1307_SQWE) != 0;
+}
+
+// ==============================================
+// SSD1306
+// ==============================================
+
+void ssd1306Init(Ssd1306Model* oled, uint8_t address) {
+  memset(oled, 0, sizeof(*oled));
+  oled->address = address;
+}
+
+void ssd1306Start(Ssd1306Model* oled) {
+  oled->transactions++;
+}
+
+void ssd1306Write(Ssd1306Model* oled, uint8_t value) {
+  (void)value;
+  oled->bytes++;
+}
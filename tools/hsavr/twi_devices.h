@@ -0,0 +1,69 @@
+/*
+ * I2C-Geräte für hsavr: DS1307 (Echtzeituhr) und SSD1306 (OLED)
+ *
+ * Die Modelle arbeiten auf Bus-Ereignissen (START mit Richtung, Byte
+ * schreiben, Byte lesen, STOP); hsavr.cpp übersetzt die TWI-Meldungen
+ * von simavr darauf.
+ *
+ * DS1307: 64 Register mit Registerzeiger. Die Zeitregister werden bei
+ * START aus der simulierten Zeit übernommen (wie der Zwischenpuffer des
+ * Bausteins), geschriebene Zeit gilt ab STOP. Register 7 Bit 4 (SQWE)
+ * schaltet den 1-Hz-Ausgang, den hsavr an INT5 weitergibt.
+ *
+ * SSD1306: nimmt Steuerbyte und Daten an und zählt nur mit.
+ */
+
+#ifndef TWI_DEVICES_H
+#define TWI_DEVICES_H
+
+#include <cstdint>
+
+// ==============================================
+// DS1307
+// ==============================================
+
+const uint8_t DS1307_ADDRESS = 0x68;
+const uint8_t DS1307_REGISTERS = 0x40;
+
+struct Ds1307Model {
+  uint8_t registers[DS1307_REGISTERS];
+  uint8_t pointer;                  ///< Registerzeiger
+  bool pointerPending;              ///< Nächstes Schreibbyte setzt den Zeiger
+  bool timeWritten;                 ///< Zeitregister seit START geschrieben
+  int64_t epochOffset;              ///< Unix-Zeit bei Simulationsbeginn
+  unsigned long transactions;
+};
+
+/**
+ * @brief Setzt die Uhr auf die Startzeit (Oszillator läuft, SQW aus).
+ */
+void ds1307Init(Ds1307Model* rtc, uint32_t epoch);
+
+/**
+ * @brief START mit Adresse; seconds = simulierte Zeit seit Beginn.
+ */
+void ds1307Start(Ds1307Model* rtc, bool read, double seconds);
+void ds1307Write(Ds1307Model* rtc, uint8_t value);
+uint8_t ds1307Read(Ds1307Model* rtc);
+void ds1307Stop(Ds1307Model* rtc, double seconds);
+
+/**
+ * @brief true wenn der Rechteckausgang eingeschaltet ist.
+ */
+bool ds1307SquareWave(const Ds1307Model* rtc);
+
+// ==============================================
+// SSD1306
+// ==============================================
+
+struct Ssd1306Model {
+  uint8_t address;
+  unsigned long transactions;
+  unsigned long bytes;
+};
+
+void ssd1306Init(Ssd1306Model* oled, uint8_t address);
+void ssd1306Start(Ssd1306Model* oled);
+void ssd1306Write(Ssd1306Model* oled, uint8_t value);
+
+#endif // TWI_DEVICES_H
@@ -0,0 +1,175 @@
+/*
+ * hslog2csv - Wandelt HSLOG-Binärdateien (.HSL) in CSV oder JSON um
+ *
+ * Liest die Datei als Strom und gibt dieselbe Spaltenaufteilung aus,
+ * die die Firmware im CSV-Modus schreibt. Blöcke mit falscher CRC werden
+ * übersprungen, ein unvollständiger letzter Block wird (mit Warnung)
+ * ausgegeben, sofern nicht --strict angegeben ist.
+ *
+ * Aufruf: hslog2csv [--json] [--strict] [DATEI]   (ohne DATEI: stdin)
+ */
+
+#include "log_format.h"
+#include "time_convert.h"
+#include "record_output.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// ==============================================
+// AUSGABE
+// ==============================================
+
+static void printCsvPreamble(const HsLogFileHeader* header) {
+  CivilTime start;
+  epochToCivil(header->createdEpoch, &start);
+  printf("# Umweltkontrollsystem Log\n");
+  printf("# Start: %04u-%02u-%02u %02u:%02u:%02u\n",
+         start.year, start.month, start.day, start.hour, start.minute, start.second);
+  printRecordCsvHeader();
+}
+
+static void printRecord(const HsLogRecord* record, bool json) {
+  if (json) {
+    printRecordJson(record);
+  } else {
+    printRecordCsv(record);
+  }
+  putchar('\n');
+}
+
+// ==============================================
+// EINLESEN
+// ==============================================
+
+static bool readExact(FILE* in, void* buffer, size_t length) {
+  return fread(buffer, 1, length, in) == length;
+}
+
+static bool readHeader(FILE* in, HsLogFileHeader* header) {
+  if (!readExact(in, header, sizeof(*header))) {
+    fprintf(stderr, "hslog2csv: Datei zu kurz\n");
+    return false;
+  }
+  if (memcmp(header->magic, HSLOG_MAGIC, 4) != 0) {
+    fprintf(stderr, "hslog2csv: keine HSLOG-Datei\n");
+    return false;
+  }
+  if (header->version != HSLOG_VERSION) {
+    fprintf(stderr, "hslog2csv: Version %u wird nicht unterstützt\n", header->version);
+    return false;
+  }
+
+  // Schema muss dem dieser Version entsprechen, sonst ist die Spaltenzuordnung unklar
+  uint16_t crc = hslogCrc16(0xFFFF, header, sizeof(*header));
+  bool schemaOk = header->fieldCount == HSLOG_FIELD_COUNT &&
+                  header->recordSize == sizeof(HsLogRecord) &&
+                  header->blockRecords > 0;
+  for (unsigned i = 0; i < header->fieldCount; i++) {
+    HsLogFieldDescriptor field;
+    if (!readExact(in, &field, sizeof(field))) {
+      fprintf(stderr, "hslog2csv: Schema unvollständig\n");
+      return false;
+    }
+    crc = hslogCrc16(crc, &field, sizeof(field));
+    if (i < HSLOG_FIELD_COUNT && memcmp(&field, &HSLOG_FIELDS[i], sizeof(field)) != 0) {
+      schemaOk = false;
+    }
+  }
+
+  uint16_t storedCrc;
+  if (!readExact(in, &storedCrc, sizeof(storedCrc)) || storedCrc != crc) {
+    fprintf(stderr, "hslog2csv: Kopf-CRC falsch\n");
+    return false;
+  }
+  if (!schemaOk) {
+    fprintf(stderr, "hslog2csv: unbekanntes Schema\n");
+    return false;
+  }
+  return true;
+}
+
+// Sucht den nächsten Blockmarker; liefert false am Dateiende
+static bool syncToBlock(FILE* in, HsLogBlockHeader* block, unsigned long* skipped) {
+  uint8_t window[sizeof(HsLogBlockHeader)];
+  if (!readExact(in, window, sizeof(window))) return false;
+  while (true) {
+    memcpy(block, window, sizeof(window));
+    if (block->marker == HSLOG_BLOCK_MARKER) return true;
+    int next = fgetc(in);
+    if (next == EOF) return false;
+    memmove(window, window + 1, sizeof(window) - 1);
+    window[sizeof(window) - 1] = (uint8_t)next;
+    (*skipped)++;
+  }
+}
+
+int main(int argc, char** argv) {
+  bool json = false;
+  bool strict = false;
+  const char* path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      json = true;
+    } else if (strcmp(argv[i], "--strict") == 0) {
+      strict = true;
+    } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printf("Aufruf: %s [--json] [--strict] [DATEI]\n", argv[0]);
+      return 0;
+    } else {
+      path = argv[i];
+    }
+  }
+
+  FILE* in = path ? fopen(path, "rb") : stdin;
+  if (!in) {
+    perror(path);
+    return 1;
+  }
+
+  HsLogFileHeader header;
+  if (!readHeader(in, &header)) return 1;
+  if (!json) printCsvPreamble(&header);
+
+  HsLogRecord* records = (HsLogRecord*)malloc(sizeof(HsLogRecord) * header.blockRecords);
+  unsigned long blocks = 0, badBlocks = 0, skippedBytes = 0;
+  HsLogBlockHeader block;
+
+  while (syncToBlock(in, &block, &skippedBytes)) {
+    uint16_t crc = hslogCrc16(0xFFFF, &block, sizeof(block));
+    unsigned count = 0;
+    while (count < header.blockRecords && readExact(in, &records[count], sizeof(HsLogRecord))) {
+      crc = hslogCrc16(crc, &records[count], sizeof(HsLogRecord));
+      count++;
+    }
+
+    uint16_t storedCrc;
+    if (count < header.blockRecords || !readExact(in, &storedCrc, sizeof(storedCrc))) {
+      // Unvollständiger letzter Block (Datei noch offen oder Stromausfall)
+      fprintf(stderr, "hslog2csv: letzter Block %u unvollständig (%u Datensätze)%s\n",
+              block.sequence, count, strict ? ", verworfen" : "");
+      if (!strict) {
+        for (unsigned i = 0; i < count; i++) printRecord(&records[i], json);
+      }
+      break;
+    }
+
+    if (storedCrc != crc) {
+      fprintf(stderr, "hslog2csv: Block %u CRC falsch, übersprungen\n", block.sequence);
+      badBlocks++;
+      continue;
+    }
+
+    for (unsigned i = 0; i < count; i++) printRecord(&records[i], json);
+    blocks++;
+  }
+
+  if (skippedBytes) {
+    fprintf(stderr, "hslog2csv: %lu Bytes ohne Blockmarker übersprungen\n", skippedBytes);
+  }
+  free(records);
+  if (in != stdin) fclose(in);
+  return badBlocks ? 2 : 0;
+}
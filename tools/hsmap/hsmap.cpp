@@ -0,0 +1,174 @@
+/*
+ * hsmap - Statische RAM-Belegung je Modul aus der Linker-Map-Datei
+ *
+ * Wertet die Map-Datei des PlatformIO-Builds aus (-Wl,-Map, siehe
+ * platformio.ini) und summiert alle Eingabe-Sektionen im RAM-Adressraum
+ * des AVR (0x800000 bis 0x80FFFF) je Objektdatei: .data und .rodata
+ * (Initialwerte, auch im Flash), .bss und .noinit. Objekte aus Archiven
+ * erscheinen als "libX.a(datei.o)"; mit --libraries werden sie je
+ * Archiv zusammengefasst. Was bis RAM-Ende übrig bleibt, teilen sich
+ * Heap und Stack - zur Laufzeit misst memory_monitor deren Höchststände.
+ *
+ * Voraussetzung ist ein Build ohne LTO (platformio.ini: -flto in
+ * build_unflags), sonst stehen in der Map nur die LTO-Partitionen
+ * (*.ltrans*.o) statt der Quelldateien; hsmap weist dann darauf hin.
+ *
+ * Aufruf: hsmap [--ram BYTES] [--libraries] [MAPDATEI]
+ *   Standard: .pio/build/megaatmega2560/firmware.map, RAM 8192 Bytes
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+struct ModuleUsage {
+  unsigned long data;       ///< .data + .rodata
+  unsigned long bss;        ///< .bss + .noinit
+};
+
+static const unsigned long AVR_RAM_START = 0x800000;
+static const unsigned long AVR_RAM_END = 0x810000;
+
+// ==============================================
+// EINLESEN
+// ==============================================
+
+static bool isDataSection(const char* name) {
+  return strncmp(name, ".data", 5) == 0 || strncmp(name, ".rodata", 7) == 0;
+}
+
+static bool isBssSection(const char* name) {
+  return strncmp(name, ".bss", 4) == 0 || strncmp(name, ".noinit", 7) == 0 ||
+         strcmp(name, "COMMON") == 0;
+}
+
+// "pfad/libX.a(datei.o)" -> "libX.a(datei.o)", "pfad/datei.o" -> "datei.o"
+static std::string moduleName(const std::string& path, bool libraries) {
+  size_t paren = path.find('(');
+  std::string file = path.substr(0, paren);
+  size_t slash = file.find_last_of("/\\");
+  std::string name = slash == std::string::npos ? file : file.substr(slash + 1);
+  if (paren != std::string::npos && !libraries) {
+    name += path.substr(paren);
+  }
+  return name;
+}
+
+// Eingabe-Sektionen stehen eingerückt, der Name allein oder mit Adresse,
+// Größe und Objekt in derselben Zeile:
+//   " .bss.tileBuffers\n                0x00800300      0x100 pfad/display.cpp.o"
+//   " .data          0x00800200       0x1c pfad/main.cpp.o"
+static bool readMap(FILE* input, bool libraries, std::map<std::string, ModuleUsage>* modules) {
+  char line[1024];
+  char pendingSection[256] = "";
+  bool inMemoryMap = false;
+
+  while (fgets(line, sizeof(line), input)) {
+    if (!inMemoryMap) {
+      inMemoryMap = strncmp(line, "Linker script and memory map", 28) == 0;
+      continue;
+    }
+
+    char section[256];
+    unsigned long address;
+    unsigned long size;
+    char object[768];
+    const char* name = NULL;
+
+    if (line[0] == ' ' && line[1] != ' ' && sscanf(line, " %255s 0x%lx 0x%lx %767[^\n]",
+                                                   section, &address, &size, object) == 4) {
+      name = section;
+    } else if (line[0] == ' ' && line[1] != ' ' && sscanf(line, " %255s", section) == 1 &&
+               (isDataSection(section) || isBssSection(section))) {
+      // Name zu lang für eine Zeile: Werte folgen in der nächsten
+      strcpy(pendingSection, section);
+      continue;
+    } else if (pendingSection[0] && sscanf(line, " 0x%lx 0x%lx %767[^\n]", &address, &size, object) == 3) {
+      name = pendingSection;
+    }
+
+    if (name && address >= AVR_RAM_START && address < AVR_RAM_END && size > 0) {
+      ModuleUsage& usage = (*modules)[moduleName(object, libraries)];
+      if (isDataSection(name)) {
+        usage.data += size;
+      } else if (isBssSection(name)) {
+        usage.bss += size;
+      }
+    }
+    pendingSection[0] = '\0';
+  }
+  return inMemoryMap;
+}
+
+// ==============================================
+// HAUPTPROGRAMM
+// ==============================================
+
+int main(int argc, char** argv) {
+  const char* path = ".pio/build/megaatmega2560/firmware.map";
+  unsigned long ramSize = 8192;
+  bool libraries = false;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--ram") == 0 && i + 1 < argc) {
+      ramSize = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "--libraries") == 0) {
+      libraries = true;
+    } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printf("Aufruf: %s [--ram BYTES] [--libraries] [MAPDATEI]\n", argv[0]);
+      return 0;
+    } else {
+      path = argv[i];
+    }
+  }
+
+  FILE* input = fopen(path, "r");
+  if (!input) {
+    perror(path);
+    return 1;
+  }
+  std::map<std::string, ModuleUsage> modules;
+  bool valid = readMap(input, libraries, &modules);
+  fclose(input);
+  if (!valid) {
+    fprintf(stderr, "hsmap: %s ist keine Linker-Map-Datei\n", path);
+    return 1;
+  }
+
+  std::vector<std::pair<std::string, ModuleUsage>> rows(modules.begin(), modules.end());
+  std::sort(rows.begin(), rows.end(),
+            [](const std::pair<std::string, ModuleUsage>& a, const std::pair<std::string, ModuleUsage>& b) {
+              return a.second.data + a.second.bss > b.second.data + b.second.bss;
+            });
+
+  unsigned long totalData = 0;
+  unsigned long totalBss = 0;
+  printf("%7s %7s %7s  %s\n", "data", "bss", "gesamt", "Modul");
+  for (const auto& row : rows) {
+    printf("%7lu %7lu %7lu  %s\n", row.second.data, row.second.bss,
+           row.second.data + row.second.bss, row.first.c_str());
+    totalData += row.second.data;
+    totalBss += row.second.bss;
+  }
+
+  unsigned long total = totalData + totalBss;
+  for (const auto& row : rows) {
+    if (row.first.find(".ltrans") != std::string::npos) {
+      fprintf(stderr, "hsmap: Map aus einem LTO-Build - Zuordnung nur je LTO-Partition, "
+                      "-flto in platformio.ini unter build_unflags eintragen\n");
+      break;
+    }
+  }
+  printf("%7lu %7lu %7lu  SUMME\n\n", totalData, totalBss, total);
+  printf("Statisch belegt: %lu von %lu Bytes (%.1f%%), für Heap und Stack: %ld Bytes\n",
+         total, ramSize, ramSize ? 100.0 * total / ramSize : 0.0, (long)ramSize - (long)total);
+  return 0;
+}
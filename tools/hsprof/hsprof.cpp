@@ -0,0 +1,179 @@
+/*
+ * hsprof - Flaches Profil aus dem Programmzähler-Histogramm der Firmware
+ *
+ * Liest die Ausgabe des seriellen Befehls "prof" (siehe src/profiler.h)
+ * aus einer Datei oder von stdin; andere Zeilen eines Mitschnitts werden
+ * übersprungen. Die Klassen werden über die Symboltabelle der ELF-Datei
+ * (avr-nm -C -n -S) Funktionen zugeordnet. Überdeckt eine Klasse mehrere
+ * Funktionen, werden ihre Abtastungen nach Anteil der überdeckten Bytes
+ * aufgeteilt - die Auflösung ist also durch PROFILER_BIN_SHIFT begrenzt.
+ *
+ * Aufruf: hsprof [--elf DATEI] [--nm PROGRAMM] [--symbols DATEI] [--top N] [MITSCHNITT]
+ *   --elf      Firmware (Standard: .pio/build/megaatmega2560/firmware.elf)
+ *   --nm       nm-Programm (Standard: avr-nm)
+ *   --symbols  Fertige Ausgabe von "avr-nm -C -n -S" statt --elf/--nm
+ *   --top      Nur die N häufigsten Funktionen (Standard: 30, 0 = alle)
+ */
+
+#include "avr_symbols.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+struct ProfileDump {
+  unsigned long hz;
+  unsigned shift;
+  unsigned long samples;
+  unsigned long outside;
+  unsigned halvings;
+  std::map<uint32_t, unsigned long> bins;   // Startadresse -> Anzahl
+  bool haveHeader;
+  bool complete;
+};
+
+// ==============================================
+// EINLESEN
+// ==============================================
+
+// Liest "#prof,..."- und "prof,..."-Zeilen; ein neuer Kopf verwirft ältere Klassen
+static bool readDump(FILE* input, ProfileDump* dump) {
+  char line[256];
+  while (fgets(line, sizeof(line), input)) {
+    if (strncmp(line, "#prof,end", 9) == 0) {
+      dump->complete = true;
+    } else if (strncmp(line, "#prof,", 6) == 0) {
+      unsigned bins;
+      if (sscanf(line, "#prof,hz=%lu,shift=%u,bins=%u,samples=%lu,outside=%lu,halvings=%u",
+                 &dump->hz, &dump->shift, &bins, &dump->samples, &dump->outside, &dump->halvings) == 6) {
+        dump->bins.clear();
+        dump->haveHeader = true;
+        dump->complete = false;
+      }
+    } else if (strncmp(line, "prof,", 5) == 0 && dump->haveHeader) {
+      unsigned long address;
+      unsigned long count;
+      if (sscanf(line, "prof,%lx,%lu", &address, &count) == 2) {
+        dump->bins[(uint32_t)address] = count;
+      }
+    }
+  }
+  return dump->haveHeader;
+}
+
+// ==============================================
+// AUSWERTUNG
+// ==============================================
+
+static const char* UNKNOWN_SYMBOL = "<ohne Symbol>";
+
+static void attribute(const ProfileDump* dump, const std::vector<AvrSymbol>& symbols,
+                      std::map<std::string, double>* profile) {
+  uint32_t binSize = 1UL << dump->shift;
+
+  for (const auto& bin : dump->bins) {
+    uint32_t binStart = bin.first;
+    uint32_t binEnd = binStart + binSize;
+    double perByte = (double)bin.second / binSize;
+    uint32_t covered = 0;
+
+    // Ab dem letzten Symbol vor dem Klassenende rückwärts; eine Funktion ist
+    // kürzer als 64 KB, weiter vorn beginnende Symbole reichen nicht herein
+    auto it = std::upper_bound(symbols.begin(), symbols.end(), binEnd,
+                               [](uint32_t value, const AvrSymbol& s) { return value <= s.address; });
+    while (it != symbols.begin()) {
+      --it;
+      if (it->address + 0x10000 < binStart) break;
+      uint32_t start = std::max(binStart, it->address);
+      uint32_t end = std::min(binEnd, it->address + it->size);
+      if (end > start) {
+        (*profile)[it->name] += perByte * (end - start);
+        covered += end - start;
+      }
+    }
+    if (covered < binSize) {
+      (*profile)[UNKNOWN_SYMBOL] += perByte * (binSize - covered);
+    }
+  }
+}
+
+static void printProfile(const ProfileDump* dump, const std::map<std::string, double>& profile, size_t top) {
+  std::vector<std::pair<std::string, double>> rows(profile.begin(), profile.end());
+  std::sort(rows.begin(), rows.end(),
+            [](const std::pair<std::string, double>& a, const std::pair<std::string, double>& b) {
+              return a.second > b.second;
+            });
+
+  double total = 0;
+  for (const auto& row : rows) total += row.second;
+
+  printf("Abtastungen: %lu mit %lu Hz (%.1f s), außerhalb des Histogramms: %lu",
+         dump->samples, dump->hz, dump->hz ? (double)dump->samples / dump->hz : 0.0, dump->outside);
+  if (dump->halvings) printf(", Histogramm %ux halbiert", dump->halvings);
+  printf("\nKlassengröße: %lu Byte%s\n\n", 1UL << dump->shift,
+         dump->complete ? "" : " (WARNUNG: Ausgabe unvollständig, \"#prof,end\" fehlt)");
+
+  printf("%7s %11s  %s\n", "Anteil", "Abtastungen", "Funktion");
+  size_t shown = 0;
+  for (const auto& row : rows) {
+    if (top && shown++ >= top) break;
+    printf("%6.2f%% %11.1f  %s\n", total > 0 ? 100.0 * row.second / total : 0.0, row.second, row.first.c_str());
+  }
+}
+
+// ==============================================
+// HAUPTPROGRAMM
+// ==============================================
+
+int main(int argc, char** argv) {
+  const char* elfPath = ".pio/build/megaatmega2560/firmware.elf";
+  const char* nmProgram = "avr-nm";
+  const char* symbolsPath = NULL;
+  const char* dumpPath = NULL;
+  size_t top = 30;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--elf") == 0 && i + 1 < argc) {
+      elfPath = argv[++i];
+    } else if (strcmp(argv[i], "--nm") == 0 && i + 1 < argc) {
+      nmProgram = argv[++i];
+    } else if (strcmp(argv[i], "--symbols") == 0 && i + 1 < argc) {
+      symbolsPath = argv[++i];
+    } else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+      top = strtoul(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printf("Aufruf: %s [--elf DATEI] [--nm PROGRAMM] [--symbols DATEI] [--top N] [MITSCHNITT]\n", argv[0]);
+      return 0;
+    } else {
+      dumpPath = argv[i];
+    }
+  }
+
+  FILE* dumpFile = dumpPath ? fopen(dumpPath, "r") : stdin;
+  if (!dumpFile) {
+    perror(dumpPath);
+    return 1;
+  }
+  ProfileDump dump = {};
+  bool haveDump = readDump(dumpFile, &dump);
+  if (dumpFile != stdin) fclose(dumpFile);
+  if (!haveDump) {
+    fprintf(stderr, "hsprof: keine \"#prof\"-Ausgabe gefunden\n");
+    return 1;
+  }
+
+  std::vector<AvrSymbol> symbols;
+  if (!loadAvrSymbols(symbolsPath, nmProgram, elfPath, &symbols)) return 1;
+
+  std::map<std::string, double> profile;
+  attribute(&dump, symbols, &profile);
+  printProfile(&dump, profile, top);
+  return 0;
+}
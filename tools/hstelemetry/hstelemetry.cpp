@@ -0,0 +1,252 @@
+/*
+ * hstelemetry - Dekodiert den binären Telemetrie-Strom der Firmware
+ *
+ * Liest von einer seriellen Schnittstelle (wird auf 8N1 roh mit der
+ * angegebenen Baudrate eingestellt), einer Datei oder stdin und gibt
+ * die Rahmen als CSV oder JSON (eine Zeile pro Rahmen) aus.
+ * CSV: Snapshot-Rahmen als Zeilen mit derselben Spaltenaufteilung wie
+ * hslog2csv, Ereignis-, Zustands- und Trace-Rahmen als Kommentarzeilen
+ * ("# "). Trace-Meldungen werden mit der Meldungstabelle aus
+ * src/trace_messages.def in Text umgesetzt (siehe trace_expand.h).
+ * Am Ende (EOF oder Strg+C) gehen die Dekoderzähler nach stderr.
+ *
+ * Aufruf: hstelemetry [--json] [--baud N] [GERÄT|DATEI]   (ohne Pfad: stdin)
+ */
+
+#include "telemetry_decoder.h"
+#include "record_output.h"
+#include "trace_expand.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+// ==============================================
+// AUSGABE
+// ==============================================
+
+static const char* eventName(uint8_t kind) {
+  switch (kind) {
+    case TELEMETRY_EVENT_BOOT: return "boot";
+    case TELEMETRY_EVENT_ERROR: return "error";
+    case TELEMETRY_EVENT_SENSORS_READY: return "sensorsReady";
+    case TELEMETRY_EVENT_LOG_DROPPED: return "logDropped";
+    default: return "unknown";
+  }
+}
+
+// Gibt text als JSON-String aus (Anführungszeichen, Backslash, Steuerzeichen maskiert)
+static void printJsonString(const char* text) {
+  putchar('"');
+  for (const char* p = text; *p; p++) {
+    if (*p == '"' || *p == '\\') {
+      printf("\\%c", *p);
+    } else if ((unsigned char)*p < 0x20) {
+      printf("\\u%04x", *p);
+    } else {
+      putchar(*p);
+    }
+  }
+  putchar('"');
+}
+
+static void printTrace(const TelemetryFrame* frame, bool json) {
+  const uint8_t* data = frame->trace;
+  size_t remaining = frame->traceLength;
+  static bool hashWarned = false;
+
+  while (remaining > 0) {
+    TraceRecordHeader header;
+    char text[256];
+    size_t used = traceFormatRecord(data, remaining, &header, text, sizeof(text));
+    if (used == 0) {
+      fprintf(stderr, "hstelemetry: abgeschnittene Trace-Meldung in Rahmen %u\n", frame->sequence);
+      return;
+    }
+
+    // Die Firmware meldet beim Start den Hash ihrer Tabelle
+    if (header.id == TRACE_TABLE && header.argc == 1 && !hashWarned) {
+      uint32_t hash;
+      memcpy(&hash, data + sizeof(header), sizeof(hash));
+      if (hash != TRACE_TABLE_HASH) {
+        fprintf(stderr, "hstelemetry: WARNUNG: Meldungstabelle der Firmware (%08lX) weicht ab (%08lX), "
+                        "Trace-Texte können falsch sein\n",
+                (unsigned long)hash, (unsigned long)TRACE_TABLE_HASH);
+        hashWarned = true;
+      }
+    }
+
+    const TraceMessage* message = traceLookup(header.id);
+    if (json) {
+      printf("{\"type\":\"trace\",\"seq\":%u,\"uptimeMs\":%lu,\"id\":%u,\"name\":\"%s\",\"text\":",
+             frame->sequence, (unsigned long)header.uptimeMs, header.id, message ? message->name : "");
+      printJsonString(text);
+      printf("}\n");
+    } else {
+      printf("# trace seq=%u uptimeMs=%lu %s\n", frame->sequence, (unsigned long)header.uptimeMs, text);
+    }
+    data += used;
+    remaining -= used;
+  }
+}
+
+static void printFrame(const TelemetryFrame* frame, bool json) {
+  if (frame->snapshot) {
+    if (json) {
+      printf("{\"type\":\"snapshot\",\"seq\":%u,\"record\":", frame->sequence);
+      printRecordJson(frame->snapshot);
+      printf("}\n");
+    } else {
+      printRecordCsv(frame->snapshot);
+      putchar('\n');
+    }
+  } else if (frame->event) {
+    const TelemetryEvent* event = frame->event;
+    printf(json ? "{\"type\":\"event\",\"seq\":%u,\"uptimeMs\":%lu,\"epoch\":%lu,\"event\":\"%s\",\"code\":%u,\"value\":%u}\n"
+                : "# event seq=%u uptimeMs=%lu epoch=%lu event=%s code=%u value=%u\n",
+           frame->sequence, (unsigned long)event->uptimeMs, (unsigned long)event->epoch,
+           eventName(event->kind), event->code, event->value);
+  } else if (frame->health) {
+    const TelemetryHealth* health = frame->health;
+    printf(json ? "{\"type\":\"health\",\"seq\":%u,\"uptimeMs\":%lu,\"freeRam\":%u,\"schedulerOverruns\":%u,"
+                  "\"logDropped\":%u,\"logErrors\":%u,\"logHighWater\":%u,\"i2cErrors\":%u,"
+                  "\"framesDropped\":%u,\"lastError\":%u,\"sdOk\":%s,\"rtcOk\":%s,"
+                  "\"stackPeak\":%u,\"heapPeak\":%u,\"ramMargin\":%u}\n"
+                : "# health seq=%u uptimeMs=%lu freeRam=%u schedulerOverruns=%u "
+                  "logDropped=%u logErrors=%u logHighWater=%u i2cErrors=%u "
+                  "framesDropped=%u lastError=%u sdOk=%s rtcOk=%s "
+                  "stackPeak=%u heapPeak=%u ramMargin=%u\n",
+           frame->sequence, (unsigned long)health->uptimeMs, health->freeRam, health->schedulerOverruns,
+           health->logDropped, health->logErrors, health->logHighWater, health->i2cErrors,
+           health->framesDropped, health->lastError,
+           (health->flags & TELEMETRY_HEALTH_SD_OK) ? "true" : "false",
+           (health->flags & TELEMETRY_HEALTH_RTC_OK) ? "true" : "false",
+           health->stackPeak, health->heapPeak, health->ramMargin);
+  } else if (frame->trace) {
+    printTrace(frame, json);
+  }
+  fflush(stdout);
+}
+
+static void printStats(const TelemetryDecoderStats* stats) {
+  fprintf(stderr, "hstelemetry: %lu Rahmen, %lu Bytes, CRC-Fehler %lu, Rahmenfehler %lu, "
+                  "unbekannt %lu, verloren %lu\n",
+          stats->frames, stats->bytes, stats->crcErrors, stats->framingErrors,
+          stats->unknownFrames, stats->lostFrames);
+}
+
+// ==============================================
+// EINGABE
+// ==============================================
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static void onSignal(int) {
+  stopRequested = 1;
+}
+
+static speed_t baudConstant(long baud) {
+  switch (baud) {
+    case 9600: return B9600;
+    case 19200: return B19200;
+    case 38400: return B38400;
+    case 57600: return B57600;
+    case 115200: return B115200;
+    case 230400: return B230400;
+    case 500000: return B500000;
+    case 1000000: return B1000000;
+    default: return 0;
+  }
+}
+
+// Serielle Schnittstelle roh einstellen; Dateien und Pipes bleiben unverändert
+static bool configureTty(int fd, long baud) {
+  if (!isatty(fd)) return true;
+
+  speed_t speed = baudConstant(baud);
+  if (speed == 0) {
+    fprintf(stderr, "hstelemetry: Baudrate %ld wird nicht unterstützt\n", baud);
+    return false;
+  }
+  struct termios tty;
+  if (tcgetattr(fd, &tty) != 0) {
+    perror("tcgetattr");
+    return false;
+  }
+  cfmakeraw(&tty);
+  cfsetispeed(&tty, speed);
+  cfsetospeed(&tty, speed);
+  tty.c_cflag |= CLOCAL | CREAD;
+  tty.c_cc[VMIN] = 1;
+  tty.c_cc[VTIME] = 0;
+  if (tcsetattr(fd, TCSANOW, &tty) != 0) {
+    perror("tcsetattr");
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  bool json = false;
+  long baud = 115200;
+  const char* path = NULL;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--json") == 0) {
+      json = true;
+    } else if (strcmp(argv[i], "--baud") == 0 && i + 1 < argc) {
+      baud = strtol(argv[++i], NULL, 10);
+    } else if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
+      printf("Aufruf: %s [--json] [--baud N] [GERÄT|DATEI]\n", argv[0]);
+      return 0;
+    } else {
+      path = argv[i];
+    }
+  }
+
+  int fd = path ? open(path, O_RDONLY | O_NOCTTY) : STDIN_FILENO;
+  if (fd < 0) {
+    perror(path);
+    return 1;
+  }
+  if (!configureTty(fd, baud)) return 1;
+
+  // Strg+C beendet das Lesen, die Zähler werden trotzdem ausgegeben
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = onSignal;
+  sigaction(SIGINT, &action, NULL);
+  sigaction(SIGTERM, &action, NULL);
+
+  static TelemetryDecoder decoder;
+  telemetryDecoderInit(&decoder);
+  if (!json) printRecordCsvHeader();
+
+  uint8_t buffer[256];
+  TelemetryFrame frame;
+  while (!stopRequested) {
+    ssize_t count = read(fd, buffer, sizeof(buffer));
+    if (count < 0) {
+      if (errno == EINTR) continue;
+      perror("read");
+      break;
+    }
+    if (count == 0) break;
+    for (ssize_t i = 0; i < count; i++) {
+      if (telemetryDecoderPush(&decoder, buffer[i], &frame)) {
+        printFrame(&frame, json);
+      }
+    }
+  }
+
+  printStats(&decoder.stats);
+  if (fd != STDIN_FILENO) close(fd);
+  const TelemetryDecoderStats* stats = &decoder.stats;
+  return (stats->crcErrors || stats->framingErrors || stats->unknownFrames) ? 2 : 0;
+}
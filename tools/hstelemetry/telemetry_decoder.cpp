@@ -0,0 +1,102 @@
+/*
+ * Implementierung des Telemetrie-Dekoders
+ */
+
+#include "telemetry_decoder.h"
+
+#include <cstring>
+
+// ==============================================
+// HILFSFUNKTIONEN
+// ==============================================
+
+static bool validBodyLength(uint8_t type, size_t length) {
+  switch (type) {
+    case TELEMETRY_FRAME_SNAPSHOT: return length == sizeof(HsLogRecord);
+    case TELEMETRY_FRAME_EVENT: return length == sizeof(TelemetryEvent);
+    case TELEMETRY_FRAME_HEALTH: return length == sizeof(TelemetryHealth);
+    // Variable Länge; einzelne Meldungen prüft trace_expand
+    case TELEMETRY_FRAME_TRACE: return length > 0 && length <= TELEMETRY_TRACE_MAX_BODY;
+    default: return false;
+  }
+}
+
+// Prüft einen vollständigen kodierten Rahmen; false bei jedem Fehler
+static bool decodeFrame(TelemetryDecoder* decoder, TelemetryFrame* frame) {
+  int length = telemetryCobsDecode(decoder->encoded, (uint16_t)decoder->fill, decoder->decoded);
+  if (length < (int)(sizeof(TelemetryHeader) + sizeof(uint16_t))) {
+    decoder->stats.framingErrors++;
+    return false;
+  }
+
+  size_t dataLength = length - sizeof(uint16_t);
+  uint16_t storedCrc;
+  memcpy(&storedCrc, decoder->decoded + dataLength, sizeof(storedCrc));
+  if (hslogCrc16(0xFFFF, decoder->decoded, (uint16_t)dataLength) != storedCrc) {
+    decoder->stats.crcErrors++;
+    return false;
+  }
+
+  TelemetryHeader header;
+  memcpy(&header, decoder->decoded, sizeof(header));
+  const uint8_t* body = decoder->decoded + sizeof(header);
+  size_t bodyLength = dataLength - sizeof(header);
+  if (!validBodyLength(header.type, bodyLength)) {
+    decoder->stats.unknownFrames++;
+    return false;
+  }
+
+  if (decoder->haveSequence) {
+    decoder->stats.lostFrames += (uint8_t)(header.sequence - decoder->lastSequence - 1);
+  }
+  decoder->haveSequence = true;
+  decoder->lastSequence = header.sequence;
+
+  memset(frame, 0, sizeof(*frame));
+  frame->type = header.type;
+  frame->sequence = header.sequence;
+  // decoded ist byteweise gepackt wie die Strukturen (packed)
+  switch (header.type) {
+    case TELEMETRY_FRAME_SNAPSHOT: frame->snapshot = (const HsLogRecord*)body; break;
+    case TELEMETRY_FRAME_EVENT: frame->event = (const TelemetryEvent*)body; break;
+    case TELEMETRY_FRAME_HEALTH: frame->health = (const TelemetryHealth*)body; break;
+    case TELEMETRY_FRAME_TRACE:
+      frame->trace = body;
+      frame->traceLength = bodyLength;
+      break;
+  }
+  decoder->stats.frames++;
+  return true;
+}
+
+// ==============================================
+// SCHNITTSTELLE
+// ==============================================
+
+void telemetryDecoderInit(TelemetryDecoder* decoder) {
+  memset(decoder, 0, sizeof(*decoder));
+}
+
+bool telemetryDecoderPush(TelemetryDecoder* decoder, uint8_t byte, TelemetryFrame* frame) {
+  decoder->stats.bytes++;
+
+  if (byte != 0x00) {
+    if (decoder->fill < sizeof(decoder->encoded)) {
+      decoder->encoded[decoder->fill++] = byte;
+    } else {
+      decoder->overflow = true;
+    }
+    return false;
+  }
+
+  // Trennbyte: gesammelten Rahmen auswerten
+  bool valid = false;
+  if (decoder->overflow) {
+    decoder->stats.framingErrors++;
+  } else if (decoder->fill > 0) {
+    valid = decodeFrame(decoder, frame);
+  }
+  decoder->fill = 0;
+  decoder->overflow = false;
+  return valid;
+}
@@ -0,0 +1,83 @@
+/*
+ * Dekoder für den Telemetrie-Strom der Firmware (siehe src/telemetry_format.h)
+ *
+ * Nimmt Bytes in beliebigen Stücken entgegen (Datei, Pipe, serielle
+ * Schnittstelle), trennt die Rahmen am 0x00-Byte, dekodiert COBS und
+ * prüft CRC sowie die Nutzdatenlänge je Rahmentyp. Fehlerhafte Rahmen
+ * werden gezählt und verworfen; Lücken in der Sequenznummer zählen als
+ * verlorene Rahmen. Der Einstieg mitten in einen laufenden Strom
+ * kostet höchstens den ersten (unvollständigen) Rahmen.
+ */
+
+#ifndef TELEMETRY_DECODER_H
+#define TELEMETRY_DECODER_H
+
+#include "telemetry_format.h"
+
+#include <cstddef>
+
+// ==============================================
+// DATENSTRUKTUREN
+// ==============================================
+
+/**
+ * @brief Ein gültiger, dekodierter Rahmen.
+ *
+ * Je nach type zeigt genau einer der Zeiger auf die Nutzdaten; sie
+ * bleiben bis zum nächsten Aufruf von telemetryDecoderPush() gültig.
+ */
+struct TelemetryFrame {
+  uint8_t type;                     ///< TELEMETRY_FRAME_*
+  uint8_t sequence;                 ///< Rahmennummer
+  const HsLogRecord* snapshot;      ///< TELEMETRY_FRAME_SNAPSHOT
+  const TelemetryEvent* event;      ///< TELEMETRY_FRAME_EVENT
+  const TelemetryHealth* health;    ///< TELEMETRY_FRAME_HEALTH
+  const uint8_t* trace;             ///< TELEMETRY_FRAME_TRACE (Meldungen, siehe trace_expand.h)
+  size_t traceLength;               ///< Länge der Trace-Meldungen
+};
+
+/**
+ * @brief Zähler des Dekoders.
+ */
+struct TelemetryDecoderStats {
+  unsigned long frames;             ///< Gültige Rahmen
+  unsigned long bytes;              ///< Empfangene Bytes
+  unsigned long crcErrors;          ///< Rahmen mit falscher CRC
+  unsigned long framingErrors;      ///< Ungültige COBS-Kodierung oder Überlänge
+  unsigned long unknownFrames;      ///< Unbekannter Typ oder falsche Nutzdatenlänge
+  unsigned long lostFrames;         ///< Aus Sequenzlücken geschätzte verlorene Rahmen
+};
+
+/**
+ * @brief Zustand des Dekoders (keine dynamischen Allokationen).
+ */
+struct TelemetryDecoder {
+  uint8_t encoded[TELEMETRY_MAX_FRAME];
+  uint8_t decoded[TELEMETRY_MAX_FRAME];
+  size_t fill;
+  bool overflow;
+  bool haveSequence;
+  uint8_t lastSequence;
+  TelemetryDecoderStats stats;
+};
+
+// ==============================================
+// FUNKTIONS-DEKLARATIONEN
+// ==============================================
+
+/**
+ * @brief Setzt den Dekoder zurück (auch die Zähler).
+ */
+void telemetryDecoderInit(TelemetryDecoder* decoder);
+
+/**
+ * @brief Verarbeitet ein empfangenes Byte.
+ *
+ * @param decoder Dekoder
+ * @param byte Empfangenes Byte
+ * @param frame Ausgabe, falls mit diesem Byte ein gültiger Rahmen endet
+ * @return true wenn frame gefüllt wurde
+ */
+bool telemetryDecoderPush(TelemetryDecoder* decoder, uint8_t byte, TelemetryFrame* frame);
+
+#endif // TELEMETRY_DECODER_H
@@ -0,0 +1,134 @@
+/*
+ * Implementierung der Trace-Expansion
+ */
+
+#include "trace_expand.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+// ==============================================
+// MELDUNGSTABELLE
+// ==============================================
+
+static const TraceMessage TRACE_TABLE_ENTRIES[] = {
+#define TRACE_MSG(name, argc, format) { #name, argc, format },
+#include "trace_messages.def"
+#undef TRACE_MSG
+};
+
+static_assert(sizeof(TRACE_TABLE_ENTRIES) / sizeof(TRACE_TABLE_ENTRIES[0]) == TRACE_MESSAGE_COUNT,
+              "Tabelle und IDs müssen übereinstimmen");
+
+const TraceMessage* traceLookup(uint16_t id) {
+  return id < TRACE_MESSAGE_COUNT ? &TRACE_TABLE_ENTRIES[id] : NULL;
+}
+
+// ==============================================
+// FORMATIERUNG
+// ==============================================
+
+// Hängt an text an und rückt die Position vor (abgeschnitten am Pufferende)
+static void append(char* text, size_t textSize, size_t* used, const char* format, ...)
+    __attribute__((format(printf, 4, 5)));
+
+static void append(char* text, size_t textSize, size_t* used, const char* format, ...) {
+  if (*used >= textSize) return;
+  va_list args;
+  va_start(args, format);
+  int written = vsnprintf(text + *used, textSize - *used, format, args);
+  va_end(args);
+  if (written > 0) *used += (size_t)written;
+  if (*used >= textSize) *used = textSize - 1;
+}
+
+// Alternative index aus "a|b|c}"; liefert die Position nach '}'
+static const char* appendChoice(const char* format, uint32_t index, char* text, size_t textSize, size_t* used) {
+  uint32_t current = 0;
+  const char* start = format;
+  while (*format && *format != '}') {
+    if (*format == '|') {
+      if (current == index) break;
+      current++;
+      start = format + 1;
+    }
+    format++;
+  }
+  if (current == index) {
+    const char* end = start;
+    while (*end && *end != '|' && *end != '}') end++;
+    append(text, textSize, used, "%.*s", (int)(end - start), start);
+  } else {
+    append(text, textSize, used, "?%u", index);
+  }
+  while (*format && *format != '}') format++;
+  return *format ? format + 1 : format;
+}
+
+static void expand(const TraceMessage* message, const uint32_t* args, uint8_t argc,
+                   char* text, size_t textSize) {
+  size_t used = 0;
+  uint8_t next = 0;
+  text[0] = '\0';
+
+  for (const char* p = message->format; *p; p++) {
+    if (*p != '%') {
+      append(text, textSize, &used, "%c", *p);
+      continue;
+    }
+    p++;
+    if (*p == '%') {
+      append(text, textSize, &used, "%%");
+      continue;
+    }
+    if (*p == '\0' || next >= argc) break;
+    uint32_t word = args[next++];
+
+    switch (*p) {
+      case 'd': append(text, textSize, &used, "%ld", (long)(int32_t)word); break;
+      case 'u': append(text, textSize, &used, "%lu", (unsigned long)word); break;
+      case 'x': append(text, textSize, &used, "%lX", (unsigned long)word); break;
+      case 'c': append(text, textSize, &used, "%c", (char)word); break;
+      case '{': p = appendChoice(p + 1, word, text, textSize, &used) - 1; break;
+      case 'f':
+      case '.': {
+        int decimals = 2;
+        if (*p == '.') {
+          decimals = p[1] - '0';
+          p += 2;  // Ziffer und 'f'
+        }
+        float value;
+        memcpy(&value, &word, sizeof(value));
+        append(text, textSize, &used, "%.*f", decimals, value);
+        break;
+      }
+      default: break;
+    }
+  }
+}
+
+size_t traceFormatRecord(const uint8_t* data, size_t length, TraceRecordHeader* header,
+                         char* text, size_t textSize) {
+  if (length < sizeof(TraceRecordHeader)) return 0;
+  memcpy(header, data, sizeof(*header));
+  if (header->argc > TRACE_MAX_ARGS) return 0;
+  size_t recordLength = sizeof(*header) + header->argc * sizeof(uint32_t);
+  if (length < recordLength) return 0;
+
+  uint32_t args[TRACE_MAX_ARGS];
+  memcpy(args, data + sizeof(*header), header->argc * sizeof(uint32_t));
+
+  const TraceMessage* message = traceLookup(header->id);
+  if (!message || message->argc != header->argc) {
+    // Andere Tabellenversion: Rohwerte ausgeben statt falsch zu interpretieren
+    size_t used = 0;
+    append(text, textSize, &used, "<unbekannte Meldung %u>", header->id);
+    for (uint8_t i = 0; i < header->argc; i++) {
+      append(text, textSize, &used, " %08lX", (unsigned long)args[i]);
+    }
+  } else {
+    expand(message, args, header->argc, text, textSize);
+  }
+  return recordLength;
+}
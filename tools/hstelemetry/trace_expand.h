@@ -0,0 +1,42 @@
+/*
+ * Setzt tokenisierte Debug-Meldungen (TELEMETRY_FRAME_TRACE) wieder in Text um
+ *
+ * Die Meldungstabelle wird beim Bau aus src/trace_messages.def erzeugt
+ * (dieselbe X-Makro-Liste wie in der Firmware); Platzhalter siehe dort.
+ */
+
+#ifndef TRACE_EXPAND_H
+#define TRACE_EXPAND_H
+
+#include "trace_format.h"
+
+#include <cstddef>
+
+/**
+ * @brief Eintrag der Meldungstabelle.
+ */
+struct TraceMessage {
+  const char* name;         ///< Name aus trace_messages.def
+  uint8_t argc;             ///< Erwartete Argumentanzahl
+  const char* format;       ///< Formattext
+};
+
+/**
+ * @brief Sucht eine Meldung; NULL bei unbekannter ID.
+ */
+const TraceMessage* traceLookup(uint16_t id);
+
+/**
+ * @brief Liest und formatiert die erste Meldung aus einem Trace-Rahmen.
+ *
+ * @param data Meldungen (Nutzdaten des Rahmens ab der aktuellen Position)
+ * @param length Verbleibende Bytes
+ * @param header Ausgabe des Meldungskopfs
+ * @param text Ausgabe des Texts (bei unbekannter ID: Name und Rohwerte)
+ * @param textSize Größe von text
+ * @return Verbrauchte Bytes, 0 wenn die Meldung abgeschnitten ist
+ */
+size_t traceFormatRecord(const uint8_t* data, size_t length, TraceRecordHeader* header,
+                         char* text, size_t textSize);
+
+#endif // TRACE_EXPAND_H
@@ -0,0 +1,175 @@
+/*
+ * Host-Test für die Log-Wiedergabe (src/native/sim_replay.{h,cpp})
+ *
+ * Spielt eine Datei im Format der Ausgangsversion (19 Namen in der
+ * Kopfzeile, aber nur 16 Werte je Zeile, Geiger-Impulse pro Zyklus) und
+ * eine Datei im aktuellen Format wieder und prüft, dass jeder Wert beim
+ * richtigen Eingang des Simulators ankommt. Dazu je eine Zeile ohne
+ * Uhrzeit (übersprungen) und eine mit unbekannter Spaltenzahl (verworfen).
+ *
+ * Aufruf: make -C tools test (Rückgabe 0 = bestanden)
+ */
+
+#include "sim_replay.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "config.h"
+#include "adc_scanner.h"
+#include "data_logger.h"
+#include "tds_converter.h"
+
+// ==============================================
+// TESTDATEN
+// ==============================================
+
+static const char* const LEGACY_LOG =
+  "# Umweltkontrollsystem Log\n"
+  "# Start: 2025-06-15 15:06:44\n"
+  "DateTime,SecSinceMidnight-MS,Temperature_DHT_C,Humidity_RH,Light_Level,Light_Percent,"
+  "MQ2,MQ3,MQ4,MQ5,MQ6,MQ7,MQ8,MQ9,MQ135,Mic1,Mic2,TDS,Radiation_CPS\n"
+  "2025-06-15 17:06:45 MESZ,23.4,45.0,100,110,120,130,140,150,160,170,180,300,400,250,10\n"
+  "----/--/-- --:--:-- MEZ,0.0,0.0,1,1,1,1,1,1,1,1,1,1,1,1,1\n"
+  "2025-06-15 17:06:46 MESZ,23.5,45.1,100,110\n"
+  "2025-06-15 17:06:47 MESZ,0.0,0.0,101,111,121,131,141,151,161,171,181,302,402,0,3\n";
+
+static const char* const CURRENT_LOG =
+  "DateTime,SecSinceMidnight-MS,Temperature_DHT_C,Humidity_RH,Light_Level,Light_Percent,"
+  "MQ2,MQ3,MQ4,MQ5,MQ6,MQ7,MQ8,MQ9,MQ135,Mic1,Mic2,TDS,Radiation_CPS\n"
+  "2025-06-15 17:07:00 MESZ,61620.250,21.0,40.0,600,58.7,1,2,3,4,5,6,7,8,9,10,20,100,1.50\n";
+
+static const uint8_t GAS_PINS[MAX_GAS_SENSORS] = {
+  MQ2_PIN, MQ3_PIN, MQ4_PIN, MQ5_PIN, MQ6_PIN, MQ7_PIN, MQ8_PIN, MQ9_PIN, MQ135_PIN
+};
+
+static const uint16_t UNTOUCHED = 777;   // Vorbelegung: Kanal darf sich nicht ändern
+
+// Einzige Abhängigkeit aus data_logger.cpp: Kopfzeile für Dateien ohne Kopf
+void formatCSVHeader(char* buffer, int bufferSize) {
+  snprintf(buffer, bufferSize, "%s",
+           "DateTime,SecSinceMidnight-MS,Temperature_DHT_C,Humidity_RH,Light_Level,Light_Percent,"
+           "MQ2,MQ3,MQ4,MQ5,MQ6,MQ7,MQ8,MQ9,MQ135,Mic1,Mic2,TDS,Radiation_CPS");
+}
+
+// ==============================================
+// PRÜFUNG
+// ==============================================
+
+static unsigned long checks = 0;
+static unsigned long failures = 0;
+
+static void check(bool ok, const char* what, double value, double expected) {
+  checks++;
+  if (ok) return;
+  failures++;
+  printf("FEHLER %s: %.3f, erwartet %.3f\n", what, value, expected);
+}
+
+static void checkNear(const char* what, double value, double expected) {
+  check(fabs(value - expected) < 0.01, what, value, expected);
+}
+
+static void checkChannel(const SimInputs* inputs, uint8_t pin, uint16_t adc, uint16_t noise, const char* what) {
+  uint8_t channel = adcScanChannel(pin);
+  check(inputs->adc[channel] == adc, what, inputs->adc[channel], adc);
+  check(inputs->noise[channel] == noise, what, inputs->noise[channel], noise);
+}
+
+// TDS: kleinster ADC-Wert, der mindestens den aufgezeichneten ppm-Wert ergibt
+static void checkTds(const SimInputs* inputs, float ppm, int16_t tempDeci) {
+  uint16_t code = inputs->adc[adcScanChannel(TDS_SENSOR_PIN)];
+  double value = tdsCodeToPpmQ4(code, tempDeci) / (double)(1 << TDS_PPM_FRAC_BITS);
+  double below = code ? tdsCodeToPpmQ4(code - 1, tempDeci) / (double)(1 << TDS_PPM_FRAC_BITS) : -1.0;
+  check(value >= ppm && below < ppm, "TDS", value, ppm);
+}
+
+static bool writeFile(const char* path, const char* text) {
+  FILE* file = fopen(path, "w");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+  fputs(text, file);
+  fclose(file);
+  return true;
+}
+
+// ==============================================
+// HAUPTPROGRAMM
+// ==============================================
+
+int main() {
+  char directory[] = "/tmp/hsreplayXXXXXX";
+  if (!mkdtemp(directory)) {
+    perror("mkdtemp");
+    return 1;
+  }
+  char legacyPath[64];
+  char currentPath[64];
+  snprintf(legacyPath, sizeof(legacyPath), "%s/06151706.CSV", directory);
+  snprintf(currentPath, sizeof(currentPath), "%s/06151707.CSV", directory);
+  if (!writeFile(legacyPath, LEGACY_LOG) || !writeFile(currentPath, CURRENT_LOG)) return 1;
+
+  // Reihenfolge der Anmeldung egal: sortiert wird nach der ersten Zeile
+  bool ok = simReplayAddFile(currentPath) && simReplayAddFile(legacyPath) && simReplayPrepare();
+  check(ok, "Dateien anmelden", ok, 1);
+  if (!ok) return 1;
+  check(simReplayStartEpoch() == 1750000005UL, "Startzeit", simReplayStartEpoch(), 1750000005UL);
+  checkNear("Dauer h", simReplayHours() * 3600.0, 15.25);
+
+  SimInputs inputs;
+  memset(&inputs, 0, sizeof(inputs));
+  for (uint8_t i = 0; i < SIM_ADC_CHANNELS; i++) inputs.adc[i] = UNTOUCHED;
+
+  // Erste Zeile der Ausgangsversion: Werte nach Position
+  simReplayInputs(0, &inputs);
+  check(inputs.dhtPresent, "DHT vorhanden", inputs.dhtPresent, 1);
+  checkNear("Temperatur", inputs.temperature, 23.4);
+  checkNear("Feuchte", inputs.humidity, 45.0);
+  for (uint8_t i = 0; i < MAX_GAS_SENSORS; i++) {
+    checkChannel(&inputs, GAS_PINS[i], 100 + i * 10, 0, "Gas-Sensor");
+  }
+  checkChannel(&inputs, MIC_KLEIN_PIN, 512, 150, "Mic1");
+  checkChannel(&inputs, MIC_GROSS_PIN, 512, 200, "Mic2");
+  checkTds(&inputs, 250.0f, 234);
+  checkNear("CPS (10 Impulse / 2 s)", inputs.radiationCps, 5.0);
+  check(inputs.adc[adcScanChannel(LDR_PIN)] == UNTOUCHED, "Licht unverändert",
+        inputs.adc[adcScanChannel(LDR_PIN)], UNTOUCHED);
+
+  // Zweite gültige Zeile: DHT ohne Wert, TDS 0 ppm
+  simReplayInputs(2000, &inputs);
+  check(!inputs.dhtPresent, "DHT fehlt", inputs.dhtPresent, 0);
+  checkChannel(&inputs, MQ135_PIN, 181, 0, "MQ135");
+  checkNear("CPS (3 Impulse / 2 s)", inputs.radiationCps, 1.5);
+  check(inputs.adc[adcScanChannel(TDS_SENSOR_PIN)] == 0, "TDS 0 ppm",
+        inputs.adc[adcScanChannel(TDS_SENSOR_PIN)], 0);
+
+  // Aktuelles Format: Zuordnung über die Kopfzeile, CPS unverändert
+  simReplayInputs(15250, &inputs);
+  check(inputs.dhtPresent, "DHT vorhanden", inputs.dhtPresent, 1);
+  checkNear("Temperatur", inputs.temperature, 21.0);
+  checkChannel(&inputs, LDR_PIN, 600, 0, "Licht");
+  checkChannel(&inputs, MQ2_PIN, 1, 0, "MQ2");
+  checkChannel(&inputs, MQ135_PIN, 9, 0, "MQ135");
+  checkChannel(&inputs, MIC_KLEIN_PIN, 512, 5, "Mic1");
+  checkTds(&inputs, 100.0f, 210);
+  checkNear("CPS", inputs.radiationCps, 1.5);
+
+  SimReplayStats stats;
+  simReplayGetStats(&stats);
+  check(stats.files == 2, "Dateien", stats.files, 2);
+  check(stats.rows == 3, "Zeilen", stats.rows, 3);
+  check(stats.legacyRows == 2, "alte Zeilen", stats.legacyRows, 2);
+  check(stats.skippedRows == 1, "übersprungen", stats.skippedRows, 1);
+  check(stats.layoutErrors == 1, "unbekannte Spaltenzahl", stats.layoutErrors, 1);
+  check(stats.dhtMissingRows == 1, "ohne DHT-Wert", stats.dhtMissingRows, 1);
+
+  unlink(legacyPath);
+  unlink(currentPath);
+  rmdir(directory);
+
+  printf("%lu Prüfungen, %lu Fehler\n", checks, failures);
+  return failures ? 1 : 0;
+}
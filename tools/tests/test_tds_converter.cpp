@@ -0,0 +1,112 @@
+/*
+ * Host-Test für tds_converter (src/tds_converter.{h,cpp})
+ *
+ * Vergleicht tdsCodeToPpmQ4() für alle 1024 ADC-Codes und jede
+ * Temperatur von -10.0 bis 50.0 °C (0.1-°C-Schritte) mit der bisherigen
+ * Gleitkomma-Formel des Gravity-TDS-Sensors (double). Unter
+ * TDS_CHECK_RANGE_PPM gilt eine absolute Fehlergrenze, darüber eine
+ * relative (dort ist der Sensor ohnehin außerhalb seines Messbereichs).
+ * Die Temperaturen werden in zufälliger Reihenfolge wiederholt, damit
+ * auch der zwischengespeicherte Kompensationsfaktor geprüft wird;
+ * zuletzt die Begrenzung außerhalb von -10..50 °C.
+ *
+ * Aufruf: make -C tools test (Rückgabe 0 = bestanden)
+ */
+
+#include "tds_converter.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+// ==============================================
+// KONSTANTEN
+// ==============================================
+
+static const double TDS_CHECK_RANGE_PPM = 2000.0;   // Messbereich des Sensors
+static const double TDS_MAX_ERROR_PPM = 1.0;        // Grenze darunter (gemessen 0.87 ppm)
+static const double TDS_MAX_ERROR_REL = 0.001;      // Grenze darüber (0.1 %)
+
+// ==============================================
+// REFERENZ
+// ==============================================
+
+// Bisherige Umrechnung aus readTDSSensor() in double
+static double referencePpm(uint16_t adcCode, int16_t tempDeci) {
+  double voltage = adcCode * 5.0 / 1024.0;
+  double compensated = voltage / (1.0 + 0.02 * (tempDeci / 10.0 - 25.0));
+  return (133.42 * compensated * compensated * compensated
+          - 255.86 * compensated * compensated
+          + 857.39 * compensated) * 0.5;
+}
+
+// ==============================================
+// VERGLEICH
+// ==============================================
+
+static unsigned long checks = 0;
+static unsigned long failures = 0;
+static double maxErrorInRange = 0.0;
+static double maxRelativeAbove = 0.0;
+
+static void checkCode(uint16_t adcCode, int16_t tempDeci) {
+  double expected = referencePpm(adcCode, tempDeci);
+  uint32_t q4 = tdsCodeToPpmQ4(adcCode, tempDeci);
+  double actual = q4 / (double)(1 << TDS_PPM_FRAC_BITS);
+  double error = fabs(actual - expected);
+  bool failed;
+  checks++;
+
+  if (expected < TDS_CHECK_RANGE_PPM) {
+    if (error > maxErrorInRange) maxErrorInRange = error;
+    failed = error > TDS_MAX_ERROR_PPM;
+  } else {
+    double relative = error / expected;
+    if (relative > maxRelativeAbove) maxRelativeAbove = relative;
+    failed = relative > TDS_MAX_ERROR_REL;
+  }
+
+  // Ganzzahlige Variante: Q4-Wert korrekt gerundet
+  uint32_t rounded = tdsCodeToPpm(adcCode, tempDeci);
+  if (rounded != (q4 + (1 << (TDS_PPM_FRAC_BITS - 1))) >> TDS_PPM_FRAC_BITS) failed = true;
+
+  if (failed && ++failures <= 20) {
+    printf("FEHLER Code %u bei %.1f °C: %.3f ppm (gerundet %lu), erwartet %.3f ppm\n",
+           adcCode, tempDeci / 10.0, actual, (unsigned long)rounded, expected);
+  }
+}
+
+static void checkTemperature(int16_t tempDeci) {
+  for (uint16_t adcCode = 0; adcCode < 1024; adcCode++) {
+    checkCode(adcCode, tempDeci);
+  }
+}
+
+// ==============================================
+// HAUPTPROGRAMM
+// ==============================================
+
+int main() {
+  for (int16_t tempDeci = TDS_TEMP_MIN_DECI; tempDeci <= TDS_TEMP_MAX_DECI; tempDeci++) {
+    checkTemperature(tempDeci);
+  }
+
+  // Zufällige Temperaturwechsel gegen den zwischengespeicherten Faktor
+  srand(1);
+  for (int i = 0; i < 2000; i++) {
+    int16_t tempDeci = TDS_TEMP_MIN_DECI + rand() % (TDS_TEMP_MAX_DECI - TDS_TEMP_MIN_DECI + 1);
+    checkCode((uint16_t)(rand() % 1024), tempDeci);
+  }
+
+  // Außerhalb von -10..50 °C wird auf den Bereich begrenzt
+  for (uint16_t adcCode = 0; adcCode < 1024; adcCode += 31) {
+    if (tdsCodeToPpmQ4(adcCode, -400) != tdsCodeToPpmQ4(adcCode, TDS_TEMP_MIN_DECI) ||
+        tdsCodeToPpmQ4(adcCode, 900) != tdsCodeToPpmQ4(adcCode, TDS_TEMP_MAX_DECI)) {
+      printf("FEHLER Code %u: Temperatur nicht begrenzt\n", adcCode);
+      failures++;
+    }
+  }
+
+  printf("%lu Prüfungen, max. Fehler %.3f ppm unter %.0f ppm, %.4f %% darüber, %lu Fehler\n",
+         checks, maxErrorInRange, TDS_CHECK_RANGE_PPM, maxRelativeAbove * 100.0, failures);
+  return failures == 0 ? 0 : 1;
+}
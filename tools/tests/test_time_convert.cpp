@@ -0,0 +1,131 @@
+/*
+ * Host-Test für time_convert (src/time_convert.{h,cpp})
+ *
+ * Vergleicht epochToLocal(), localOffsetSeconds() und epochToCivil() für
+ * jede volle Stunde von 2020 bis 2099 mit localtime_r()/gmtime_r() der
+ * glibc unter TZ=Europe/Berlin. An jeder Umstellung, die die glibc
+ * meldet, wird zusätzlich die Sekunde davor, die Umstellungssekunde
+ * selbst und die Sekunde danach geprüft. Ein zweiter Durchlauf rückwärts
+ * prüft, dass der zwischengespeicherte Offset auch in Gegenrichtung
+ * richtig verworfen wird.
+ *
+ * Aufruf: make -C tools test (Rückgabe 0 = bestanden)
+ */
+
+#include "time_convert.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+// ==============================================
+// VERGLEICH
+// ==============================================
+
+static unsigned long checks = 0;
+static unsigned long failures = 0;
+
+static bool sameCivil(const CivilTime* civil, const struct tm* reference) {
+  return civil->year == reference->tm_year + 1900 &&
+         civil->month == reference->tm_mon + 1 &&
+         civil->day == reference->tm_mday &&
+         civil->hour == reference->tm_hour &&
+         civil->minute == reference->tm_min &&
+         civil->second == reference->tm_sec;
+}
+
+static void report(uint32_t epoch, const char* what, const CivilTime* civil, const struct tm* reference) {
+  if (++failures > 20) return;   // Nur die ersten Abweichungen ausgeben
+  printf("FEHLER %s bei %lu: %04u-%02u-%02u %02u:%02u:%02u, erwartet %04d-%02d-%02d %02d:%02d:%02d (%s)\n",
+         what, (unsigned long)epoch,
+         civil->year, civil->month, civil->day, civil->hour, civil->minute, civil->second,
+         reference->tm_year + 1900, reference->tm_mon + 1, reference->tm_mday,
+         reference->tm_hour, reference->tm_min, reference->tm_sec, reference->tm_zone);
+}
+
+static void checkEpoch(uint32_t epoch) {
+  time_t t = (time_t)epoch;
+  struct tm reference;
+  CivilTime civil;
+  checks++;
+
+  gmtime_r(&t, &reference);
+  epochToCivil(epoch, &civil);
+  if (!sameCivil(&civil, &reference)) report(epoch, "epochToCivil", &civil, &reference);
+  if (civilToEpoch(&civil) != epoch) report(epoch, "civilToEpoch", &civil, &reference);
+
+  localtime_r(&t, &reference);
+  bool summerTime = epochToLocal(epoch, &civil);
+  if (!sameCivil(&civil, &reference) || summerTime != (reference.tm_isdst > 0)) {
+    report(epoch, "epochToLocal", &civil, &reference);
+  }
+
+  bool offsetSummerTime = false;
+  int32_t offset = localOffsetSeconds(epoch, &offsetSummerTime);
+  if (offset != reference.tm_gmtoff || offsetSummerTime != (reference.tm_isdst > 0)) {
+    report(epoch, "localOffsetSeconds", &civil, &reference);
+  }
+}
+
+static long referenceOffset(uint32_t epoch) {
+  time_t t = (time_t)epoch;
+  struct tm reference;
+  localtime_r(&t, &reference);
+  return reference.tm_gmtoff;
+}
+
+// Erste Sekunde mit neuem Offset in (before, after]
+static uint32_t findTransition(uint32_t before, uint32_t after) {
+  long offsetBefore = referenceOffset(before);
+  while (after - before > 1) {
+    uint32_t middle = before + (after - before) / 2;
+    if (referenceOffset(middle) == offsetBefore) {
+      before = middle;
+    } else {
+      after = middle;
+    }
+  }
+  return after;
+}
+
+// ==============================================
+// HAUPTPROGRAMM
+// ==============================================
+
+int main() {
+  setenv("TZ", "Europe/Berlin", 1);
+  tzset();
+
+  // Ohne Zeitzonendaten liefert die glibc UTC: Test wäre wertlos
+  if (referenceOffset(1593561600UL) != TZ_OFFSET_MESZ) {   // 2020-07-01 00:00 UTC
+    printf("FEHLER: keine Zeitzonendaten für Europe/Berlin (tzdata installiert?)\n");
+    return 2;
+  }
+
+  CivilTime first = { TZ_TABLE_FIRST_YEAR, 1, 1, 0, 0, 0 };
+  CivilTime last = { TZ_TABLE_LAST_YEAR, 12, 31, 23, 0, 0 };
+  uint32_t firstEpoch = civilToEpoch(&first);
+  uint32_t lastEpoch = civilToEpoch(&last);
+
+  unsigned long transitions = 0;
+  for (uint32_t epoch = firstEpoch; epoch <= lastEpoch; epoch += 3600UL) {
+    checkEpoch(epoch);
+    if (epoch > firstEpoch && referenceOffset(epoch) != referenceOffset(epoch - 3600UL)) {
+      uint32_t transition = findTransition(epoch - 3600UL, epoch);
+      checkEpoch(transition - 1);
+      checkEpoch(transition);
+      checkEpoch(transition + 1);
+      transitions++;
+    }
+  }
+  for (uint32_t epoch = lastEpoch; epoch >= firstEpoch; epoch -= 3600UL) {
+    checkEpoch(epoch);
+  }
+
+  printf("%lu Prüfungen, %lu Umstellungen, %lu Fehler\n", checks, transitions, failures);
+  if (transitions != 2UL * (TZ_TABLE_LAST_YEAR - TZ_TABLE_FIRST_YEAR + 1)) {
+    printf("FEHLER: %lu Umstellungen erwartet\n", 2UL * (TZ_TABLE_LAST_YEAR - TZ_TABLE_FIRST_YEAR + 1));
+    return 1;
+  }
+  return failures == 0 ? 0 : 1;
+}